@@ -0,0 +1,29 @@
+#include "Allocations.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+using namespace std;
+
+static atomic<size_t> s_allocations{0};
+
+// array and nothrow forms of new call this one, aligned allocations are not counted
+void* operator new(size_t size) {
+    s_allocations.fetch_add(1, memory_order_relaxed);
+    if (void* p = malloc(size ? size : 1))
+        return p;
+    throw bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    free(p);
+}
+
+size_t allocations() {
+    return s_allocations.load(memory_order_relaxed);
+}
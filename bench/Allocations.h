@@ -0,0 +1,14 @@
+#ifndef MEETING_SDK_LINUX_SAMPLE_ALLOCATIONS_H
+#define MEETING_SDK_LINUX_SAMPLE_ALLOCATIONS_H
+
+#include <cstddef>
+
+/**
+ * Heap allocations made by the process so far, counted by the global operator
+ * new that Allocations.cpp replaces. Only zoomsdk_bench_consent links it, the
+ * other benchmarks keep the standard allocator.
+ */
+size_t allocations();
+
+
+#endif //MEETING_SDK_LINUX_SAMPLE_ALLOCATIONS_H
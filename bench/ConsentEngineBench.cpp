@@ -0,0 +1,200 @@
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "Allocations.h"
+#include "Silenced.h"
+#include "consent/ConsentEngine.h"
+
+using namespace std;
+
+/**
+ * The meeting as the engine sees it. Recording never starts, as while the
+ * host has not granted the privilege, so the engine keeps following consent
+ * however many participants gave it.
+ */
+class MockMeeting : public ConsentEngine::Participants, public ConsentEngine::Recording {
+    vector<unsigned int> m_ids;
+    unordered_map<unsigned int, string> m_names;
+
+public:
+    bool list(vector<unsigned int>& ids) override {
+        ids.clear();
+        for (auto id : m_ids)
+            ids.push_back(id);
+
+        return true;
+    }
+
+    const char* name(unsigned int userId) override {
+        auto it = m_names.find(userId);
+        return it == m_names.end() ? nullptr : it->second.c_str();
+    }
+
+    unsigned int self() override { return 0; }
+
+    bool startRecording() override { return false; }
+    void stopRecording() override {}
+    void joined(unsigned int) override {}
+    void left(unsigned int) override {}
+
+    void set(const vector<unsigned int>& ids) {
+        m_ids = ids;
+        for (auto id : ids)
+            m_names.emplace(id, "Participant " + to_string(id));
+    }
+
+    /**
+     * Exchange who is listed with ids, without copying either list
+     */
+    void swap(vector<unsigned int>& ids) {
+        m_ids.swap(ids);
+    }
+};
+
+/**
+ * The engine with the default settings, everyone has to consent and reminders
+ * go to the meeting chat. It is not started, so nothing polls the consent API
+ * and no journal is written, the benchmarks hand it responses themselves.
+ */
+struct Engine {
+    Config config;
+    Executor executor;
+    TimerWheel timers;
+    ChatOutbox chat{executor, timers};
+    SegmentLedger ledger;
+    SegmentPurger purger{ledger};
+    MockMeeting meeting;
+    ConsentEngine consent{config, timers, chat, purger, meeting, meeting};
+
+    Engine() {
+        chat.setSender([](unsigned int, const string&) { return true; });
+    }
+};
+
+static vector<unsigned int> makeIds(size_t count, unsigned int first) {
+    vector<unsigned int> ids;
+    ids.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+        ids.push_back(first + i);
+
+    return ids;
+}
+
+static string makeResponse(size_t users, unsigned int first) {
+    stringstream ss;
+    ss << "{\"consenting_users\": [";
+    for (size_t i = 0; i < users; ++i)
+        ss << (i ? ", " : "") << "\"Participant " << first + i << "\"";
+    ss << "]}";
+
+    return ss.str();
+}
+
+static void reportAllocations(benchmark::State& state, size_t before, const char* name) {
+    auto count = allocations() - before;
+    state.counters[name] = benchmark::Counter(count, benchmark::Counter::kAvgIterations);
+}
+
+/**
+ * Reconciliation against an unchanged participants list
+ */
+static void BM_Reconcile_Steady(benchmark::State& state) {
+    Engine engine;
+    engine.meeting.set(makeIds(state.range(0), 1000));
+    engine.consent.fetchParticipants();
+
+    auto before = allocations();
+    for (auto _ : state)
+        engine.consent.fetchParticipants();
+
+    reportAllocations(state, before, "allocs/reconcile");
+}
+BENCHMARK(BM_Reconcile_Steady)->Arg(2)->Arg(10)->Arg(100)->Arg(1000)->Arg(10000);
+
+/**
+ * Reconciliation where a percentage of the participants left and others joined,
+ * with the log line each pass that drops participants writes
+ */
+static void BM_Reconcile_Churn(benchmark::State& state) {
+    auto size = static_cast<size_t>(state.range(0));
+    auto churn = size * state.range(1) / 100;
+
+    // two lists differing in churn participants, swapped every iteration
+    auto other = makeIds(size, 1000);
+    for (size_t i = 0; i < churn; ++i)
+        other[i] += 1000000;
+
+    Engine engine;
+    engine.meeting.set(other);
+    engine.meeting.set(makeIds(size, 1000));
+    engine.consent.fetchParticipants();
+
+    Silenced silenced;
+    auto before = allocations();
+    for (auto _ : state) {
+        engine.meeting.swap(other);
+        engine.consent.fetchParticipants();
+    }
+
+    reportAllocations(state, before, "allocs/reconcile");
+}
+BENCHMARK(BM_Reconcile_Churn)->ArgsProduct({{100, 1000, 10000}, {1, 10, 50}});
+
+/**
+ * One poll: the response, the gate updates it causes and the reminder it
+ * evaluates, with the chat posts run on the executor
+ */
+static void BM_Poll(benchmark::State& state) {
+    auto size = static_cast<size_t>(state.range(0));
+    auto consenting = static_cast<size_t>(state.range(1));
+
+    Engine engine;
+    engine.meeting.set(makeIds(size, 1000));
+    engine.consent.fetchParticipants();
+
+    // consent of one participant flips between the two responses
+    auto response = makeResponse(consenting, 1000);
+    auto changed = makeResponse(consenting ? consenting - 1 : 0, 1000);
+
+    Silenced silenced;
+    bool flip = false;
+    auto before = allocations();
+    for (auto _ : state) {
+        engine.consent.onConsentResponse(flip ? changed : response);
+        engine.executor.drain();
+        flip = !flip;
+    }
+
+    reportAllocations(state, before, "allocs/poll");
+}
+BENCHMARK(BM_Poll)->Args({2, 1})->Args({100, 50})->Args({1000, 500})->Args({1000, 1000})->Args({10000, 5000})->Args({10000, 10000});
+
+/**
+ * Poll with an unchanged response, the common case between consent changes
+ */
+static void BM_Poll_Unchanged(benchmark::State& state) {
+    auto size = static_cast<size_t>(state.range(0));
+
+    Engine engine;
+    engine.meeting.set(makeIds(size, 1000));
+    engine.consent.fetchParticipants();
+
+    auto response = makeResponse(size / 2, 1000);
+
+    Silenced silenced;
+    engine.consent.onConsentResponse(response);
+    engine.executor.drain();
+
+    auto before = allocations();
+    for (auto _ : state) {
+        engine.consent.onConsentResponse(response);
+        engine.executor.drain();
+    }
+
+    reportAllocations(state, before, "allocs/poll");
+}
+BENCHMARK(BM_Poll_Unchanged)->Arg(2)->Arg(100)->Arg(1000)->Arg(10000);
@@ -0,0 +1,49 @@
+#include <sstream>
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include "consent/ConsentParser.h"
+
+using namespace std;
+
+static string makeResponse(size_t users) {
+    stringstream ss;
+    ss << "{\"consenting_users\": [";
+    for (size_t i = 0; i < users; ++i)
+        ss << (i ? ", " : "") << "\"Participant " << i << "\"";
+    ss << "]}";
+
+    return ss.str();
+}
+
+/**
+ * Previous path: jsoncpp DOM copied into a vector of strings
+ */
+static void BM_ConsentParse_Jsoncpp(benchmark::State& state) {
+    auto body = makeResponse(state.range(0));
+    ConsentTracker tracker;
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(ConsentParser::parseDom(body, tracker));
+
+    state.SetBytesProcessed(state.iterations() * body.size());
+}
+BENCHMARK(BM_ConsentParse_Jsoncpp)->Arg(10)->Arg(1000)->Arg(10000);
+
+/**
+ * simdjson On-Demand, reading names as string views into the tracker
+ */
+static void BM_ConsentParse_Simdjson(benchmark::State& state) {
+    auto body = makeResponse(state.range(0));
+    body.reserve(body.size() + ConsentParser::padding);
+
+    ConsentParser parser;
+    ConsentTracker tracker;
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(parser.parse(body, tracker));
+
+    state.SetBytesProcessed(state.iterations() * body.size());
+}
+BENCHMARK(BM_ConsentParse_Simdjson)->Arg(10)->Arg(1000)->Arg(10000);
@@ -0,0 +1,100 @@
+#include <algorithm>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "consent/ConsentTracker.h"
+
+using namespace std;
+
+static vector<string> makeNames(size_t count, const string& prefix = "Participant ") {
+    vector<string> names;
+    names.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+        names.push_back(prefix + to_string(i));
+
+    return names;
+}
+
+/**
+ * The previous onConsentUpdate: std::find over the response for every participant
+ */
+static void BM_ConsentScan_Baseline(benchmark::State& state) {
+    auto participants = makeNames(state.range(0));
+    auto consenting = makeNames(state.range(1));
+    unordered_map<string, bool> consentStatus;
+
+    for (auto _ : state) {
+        for (const auto& user : participants)
+            consentStatus[user] = find(consenting.begin(), consenting.end(), user) != consenting.end();
+
+        bool allConsented = all_of(participants.begin(), participants.end(), [&](const string& user) {
+            return consentStatus[user];
+        });
+        benchmark::DoNotOptimize(allConsented);
+    }
+}
+BENCHMARK(BM_ConsentScan_Baseline)->Args({1000, 1000});
+
+/**
+ * Poll where the API response did not change
+ */
+static void BM_ConsentTracker_Unchanged(benchmark::State& state) {
+    auto participants = makeNames(state.range(0));
+    auto consenting = makeNames(state.range(1));
+
+    ConsentTracker tracker;
+    for (const auto& user : participants)
+        tracker.join(user);
+    tracker.update(consenting);
+
+    for (auto _ : state) {
+        tracker.update(consenting);
+        benchmark::DoNotOptimize(tracker.allConsented());
+    }
+}
+BENCHMARK(BM_ConsentTracker_Unchanged)->Args({1000, 1000});
+
+/**
+ * Poll where a single participant granted or revoked consent
+ */
+static void BM_ConsentTracker_OneChange(benchmark::State& state) {
+    auto participants = makeNames(state.range(0));
+    auto consenting = makeNames(state.range(1));
+    auto withoutLast = consenting;
+    withoutLast.pop_back();
+
+    ConsentTracker tracker;
+    for (const auto& user : participants)
+        tracker.join(user);
+
+    bool flip = false;
+    for (auto _ : state) {
+        tracker.update(flip ? withoutLast : consenting);
+        benchmark::DoNotOptimize(tracker.allConsented());
+        flip = !flip;
+    }
+}
+BENCHMARK(BM_ConsentTracker_OneChange)->Args({1000, 1000});
+
+/**
+ * Roster churn: one participant leaves and rejoins
+ */
+static void BM_ConsentTracker_JoinLeave(benchmark::State& state) {
+    auto participants = makeNames(state.range(0));
+
+    ConsentTracker tracker;
+    for (const auto& user : participants)
+        tracker.join(user);
+    tracker.update(makeNames(state.range(1)));
+
+    const auto& user = participants.back();
+    for (auto _ : state) {
+        tracker.leave(user);
+        tracker.join(user);
+        benchmark::DoNotOptimize(tracker.allConsented());
+    }
+}
+BENCHMARK(BM_ConsentTracker_JoinLeave)->Args({1000, 1000});
@@ -0,0 +1,85 @@
+#include <chrono>
+
+#include <benchmark/benchmark.h>
+
+#include "metrics/CycleClock.h"
+#include "metrics/Histogram.h"
+
+using namespace std;
+
+/**
+ * One unscaled reading, what a timed callback pays at least twice
+ */
+static void BM_CycleClock_Ticks(benchmark::State& state) {
+    for (auto _ : state)
+        benchmark::DoNotOptimize(CycleClock::ticks());
+
+    state.SetLabel(CycleClock::usesTsc() ? "rdtsc" : "CLOCK_MONOTONIC_RAW");
+}
+BENCHMARK(BM_CycleClock_Ticks);
+
+/**
+ * One reading scaled to nanoseconds, as the tracer takes them
+ */
+static void BM_CycleClock_Now(benchmark::State& state) {
+    for (auto _ : state)
+        benchmark::DoNotOptimize(CycleClock::now());
+}
+BENCHMARK(BM_CycleClock_Now);
+
+/**
+ * The clock the metrics used before, for comparison
+ */
+static void BM_SteadyClock_Now(benchmark::State& state) {
+    for (auto _ : state)
+        benchmark::DoNotOptimize(chrono::steady_clock::now());
+}
+BENCHMARK(BM_SteadyClock_Now);
+
+/**
+ * Recording a value into the calling thread's shard, without reading a clock
+ */
+static void BM_Histogram_Observe(benchmark::State& state) {
+    Histogram histogram;
+    chrono::nanoseconds value(41200);
+
+    for (auto _ : state) {
+        histogram.observe(value);
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK(BM_Histogram_Observe);
+
+/**
+ * A timer around nothing: what the instrumentation adds to a callback whose
+ * frame is gated or dropped
+ */
+static void BM_Histogram_Timer(benchmark::State& state) {
+    Histogram histogram;
+
+    for (auto _ : state) {
+        Histogram::Timer timer(&histogram);
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK(BM_Histogram_Timer);
+
+/**
+ * What the instrumentation adds to a callback that writes its frame: the
+ * callback timer, a reading before the write and one shared end reading for
+ * the callback, write and capture-to-disk histograms
+ */
+static void BM_Histogram_TimedWrite(benchmark::State& state) {
+    Histogram callback, write, captureToDisk;
+
+    for (auto _ : state) {
+        Histogram::Timer timer(&callback);
+        auto writeStart = CycleClock::ticks();
+        benchmark::ClobberMemory();
+
+        auto end = timer.stop();
+        write.observe(CycleClock::between(writeStart, end));
+        captureToDisk.observe(CycleClock::between(timer.started(), end));
+    }
+}
+BENCHMARK(BM_Histogram_TimedWrite);
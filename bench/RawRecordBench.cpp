@@ -0,0 +1,378 @@
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <benchmark/benchmark.h>
+
+#include "FakeRawData.h"
+#include "Silenced.h"
+#include "raw_record/ZoomSDKAudioRawDataDelegate.h"
+#include "raw_record/ZoomSDKRendererDelegate.h"
+#include "util/Log.h"
+
+using namespace std;
+
+static const uint32_t nodeId = 16778240;
+
+// files are emptied this often so a long run does not fill the disk
+static const int64_t audioTruncateEvery = 1 << 16;
+static const int64_t videoTruncateEvery = 1 << 8;
+
+/**
+ * Scratch directory of the benchmarks, removed at exit
+ */
+static const string& scratch() {
+    static string dir = []() {
+        char pattern[] = "/tmp/zoomsdk_bench-XXXXXX";
+        string path = mkdtemp(pattern) ? pattern : "/tmp";
+
+        static string removed = path;
+        atexit([]() { system(("rm -rf " + removed).c_str()); });
+
+        return path;
+    }();
+
+    return dir;
+}
+
+static void truncateEvery(benchmark::State& state, int64_t& written, int64_t every, const string& path) {
+    if (++written % every) return;
+
+    state.PauseTiming();
+    truncate(path.c_str(), 0);
+    state.ResumeTiming();
+}
+
+static FakeAudioRawData makeAudio() {
+    FakeAudioRawData data(32000, 1);
+    for (unsigned int i = 0; i < data.GetBufferLen(); ++i)
+        data.GetBuffer()[i] = static_cast<char>(i);
+
+    return data;
+}
+
+static FakeVideoRawData makeVideo(benchmark::State& state) {
+    FakeVideoRawData data(static_cast<unsigned int>(state.range(0)), static_cast<unsigned int>(state.range(1)));
+    memset(data.GetBuffer(), 128, data.GetBufferLen());
+    data.setSourceId(nodeId);
+
+    return data;
+}
+
+/**
+ * Current path: one-way audio through the delegate, which opens, appends
+ * to and closes the participant's file and logs a line for every frame
+ */
+static void BM_AudioDelegate_OneWay(benchmark::State& state) {
+    auto data = makeAudio();
+    ZoomSDKAudioRawDataDelegate delegate(false);
+    delegate.setDir(scratch());
+
+    auto path = scratch() + "/node-" + to_string(nodeId) + ".pcm";
+    int64_t written = 0;
+
+    Silenced silenced;
+    for (auto _ : state) {
+        delegate.onOneWayAudioRawDataReceived(&data, nodeId);
+        truncateEvery(state, written, audioTruncateEvery, path);
+    }
+
+    state.SetBytesProcessed(state.iterations() * data.GetBufferLen());
+}
+BENCHMARK(BM_AudioDelegate_OneWay);
+
+/**
+ * Current path with the gate, ledger and latency histograms of the bot attached
+ */
+static void BM_AudioDelegate_OneWayInstrumented(benchmark::State& state) {
+    auto data = makeAudio();
+    ConsentGate gate;
+    SegmentLedger ledger;
+    Metrics metrics;
+
+    gate.set(nodeId, true);
+
+    ZoomSDKAudioRawDataDelegate delegate(false);
+    delegate.setDir(scratch());
+    delegate.setGate(&gate);
+    delegate.setLedger(&ledger);
+    delegate.setMetrics(&metrics);
+
+    auto path = scratch() + "/node-" + to_string(nodeId) + ".pcm";
+    int64_t written = 0;
+
+    Silenced silenced;
+    for (auto _ : state) {
+        delegate.onOneWayAudioRawDataReceived(&data, nodeId);
+        truncateEvery(state, written, audioTruncateEvery, path);
+    }
+
+    state.SetBytesProcessed(state.iterations() * data.GetBufferLen());
+}
+BENCHMARK(BM_AudioDelegate_OneWayInstrumented);
+
+/**
+ * Current path: an I420 frame through the renderer delegate, which opens,
+ * writes each plane to and closes the file and logs a line for every frame
+ */
+static void BM_RendererDelegate_Frame(benchmark::State& state) {
+    auto data = makeVideo(state);
+    ZoomSDKRendererDelegate delegate;
+    delegate.setDir(scratch());
+    delegate.setFilename("video.yuv");
+
+    auto path = scratch() + "/video.yuv";
+    int64_t written = 0;
+
+    Silenced silenced;
+    for (auto _ : state) {
+        delegate.onRawDataFrameReceived(&data);
+        truncateEvery(state, written, videoTruncateEvery, path);
+    }
+
+    state.SetBytesProcessed(state.iterations() * data.GetBufferLen());
+}
+BENCHMARK(BM_RendererDelegate_Frame)->Args({320, 180})->Args({640, 360})->Args({1280, 720});
+
+/**
+ * The delegate's file handling alone: open, append and close per frame, no log line
+ */
+static void BM_AudioWrite_OpenWriteClose(benchmark::State& state) {
+    auto data = makeAudio();
+    auto path = scratch() + "/open-write-close.pcm";
+    int64_t written = 0;
+
+    for (auto _ : state) {
+        ofstream file(path, ios::out | ios::binary | ios::app);
+        file.write(data.GetBuffer(), data.GetBufferLen());
+        file.close();
+
+        truncateEvery(state, written, audioTruncateEvery, path);
+    }
+
+    state.SetBytesProcessed(state.iterations() * data.GetBufferLen());
+}
+BENCHMARK(BM_AudioWrite_OpenWriteClose);
+
+/**
+ * Stream kept open, frames collect in its buffer and reach the file when it is full
+ */
+static void BM_AudioWrite_KeptOpen(benchmark::State& state) {
+    auto data = makeAudio();
+    auto path = scratch() + "/kept-open.pcm";
+    ofstream file(path, ios::out | ios::binary | ios::trunc);
+    int64_t written = 0;
+
+    for (auto _ : state) {
+        file.write(data.GetBuffer(), data.GetBufferLen());
+
+        if (++written % audioTruncateEvery == 0) {
+            state.PauseTiming();
+            file.close();
+            file.open(path, ios::out | ios::binary | ios::trunc);
+            state.ResumeTiming();
+        }
+    }
+
+    state.SetBytesProcessed(state.iterations() * data.GetBufferLen());
+}
+BENCHMARK(BM_AudioWrite_KeptOpen);
+
+/**
+ * File descriptor kept open, one write(2) per frame so nothing is held back in the process
+ */
+static void BM_AudioWrite_KeptOpenSyscall(benchmark::State& state) {
+    auto data = makeAudio();
+    auto path = scratch() + "/kept-open-fd.pcm";
+    auto fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_APPEND, 0644);
+    int64_t written = 0;
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(write(fd, data.GetBuffer(), data.GetBufferLen()));
+
+        if (++written % audioTruncateEvery == 0) {
+            state.PauseTiming();
+            ftruncate(fd, 0);
+            state.ResumeTiming();
+        }
+    }
+
+    close(fd);
+    state.SetBytesProcessed(state.iterations() * data.GetBufferLen());
+}
+BENCHMARK(BM_AudioWrite_KeptOpenSyscall);
+
+/**
+ * The renderer's file handling alone: open, three plane writes and close per frame
+ */
+static void BM_VideoWrite_OpenWriteClose(benchmark::State& state) {
+    auto data = makeVideo(state);
+    auto path = scratch() + "/open-write-close.yuv";
+    size_t ySize = data.GetStreamWidth() * data.GetStreamHeight();
+    int64_t written = 0;
+
+    for (auto _ : state) {
+        ofstream file(path, ios::out | ios::binary | ios::app);
+        file.write(data.GetYBuffer(), ySize);
+        file.write(data.GetUBuffer(), ySize / 4);
+        file.write(data.GetVBuffer(), ySize / 4);
+        file.close();
+
+        truncateEvery(state, written, videoTruncateEvery, path);
+    }
+
+    state.SetBytesProcessed(state.iterations() * data.GetBufferLen());
+}
+BENCHMARK(BM_VideoWrite_OpenWriteClose)->Args({320, 180})->Args({640, 360})->Args({1280, 720});
+
+/**
+ * File descriptor kept open, the three planes in one writev(2)
+ */
+static void BM_VideoWrite_KeptOpenWritev(benchmark::State& state) {
+    auto data = makeVideo(state);
+    auto path = scratch() + "/kept-open-writev.yuv";
+    auto fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_APPEND, 0644);
+    size_t ySize = data.GetStreamWidth() * data.GetStreamHeight();
+    int64_t written = 0;
+
+    iovec planes[] = {
+            {data.GetYBuffer(), ySize},
+            {data.GetUBuffer(), ySize / 4},
+            {data.GetVBuffer(), ySize / 4},
+    };
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(writev(fd, planes, 3));
+
+        if (++written % videoTruncateEvery == 0) {
+            state.PauseTiming();
+            ftruncate(fd, 0);
+            state.ResumeTiming();
+        }
+    }
+
+    close(fd);
+    state.SetBytesProcessed(state.iterations() * data.GetBufferLen());
+}
+BENCHMARK(BM_VideoWrite_KeptOpenWritev)->Args({320, 180})->Args({640, 360})->Args({1280, 720});
+
+/**
+ * Formatting the delegate's per-frame log line, without writing it
+ */
+static void BM_Log_Format(benchmark::State& state) {
+    auto data = makeAudio();
+    auto path = scratch() + "/node-" + to_string(nodeId) + ".pcm";
+
+    for (auto _ : state) {
+        stringstream ss;
+        ss << "Writing " << data.GetBufferLen() << "b to " << path << " at " << data.GetSampleRate() << "Hz";
+        benchmark::DoNotOptimize(ss.str());
+    }
+}
+BENCHMARK(BM_Log_Format);
+
+/**
+ * Formatting and writing the per-frame log line with Log::info, flushed by endl
+ */
+static void BM_Log_Info(benchmark::State& state) {
+    auto data = makeAudio();
+    auto path = scratch() + "/node-" + to_string(nodeId) + ".pcm";
+
+    Silenced silenced;
+    for (auto _ : state) {
+        stringstream ss;
+        ss << "Writing " << data.GetBufferLen() << "b to " << path << " at " << data.GetSampleRate() << "Hz";
+        Log::info(ss.str());
+    }
+}
+BENCHMARK(BM_Log_Info);
+
+/**
+ * The same line ended by a newline instead of endl, left to the stream to flush
+ */
+static void BM_Log_Unflushed(benchmark::State& state) {
+    auto data = makeAudio();
+    auto path = scratch() + "/node-" + to_string(nodeId) + ".pcm";
+
+    Silenced silenced;
+    for (auto _ : state) {
+        stringstream ss;
+        ss << "Writing " << data.GetBufferLen() << "b to " << path << " at " << data.GetSampleRate() << "Hz";
+        cout << Emoji::hourglass << " " << ss.str() << "\n";
+    }
+}
+BENCHMARK(BM_Log_Unflushed);
+
+/**
+ * Copying the planes of a frame into a buffer of its own, one memcpy per plane
+ */
+static void BM_PlaneCopy_Memcpy(benchmark::State& state) {
+    auto data = makeVideo(state);
+    vector<char> frame(data.GetBufferLen());
+    size_t ySize = data.GetStreamWidth() * data.GetStreamHeight();
+
+    for (auto _ : state) {
+        memcpy(frame.data(), data.GetYBuffer(), ySize);
+        memcpy(frame.data() + ySize, data.GetUBuffer(), ySize / 4);
+        memcpy(frame.data() + ySize + ySize / 4, data.GetVBuffer(), ySize / 4);
+        benchmark::ClobberMemory();
+    }
+
+    state.SetBytesProcessed(state.iterations() * data.GetBufferLen());
+}
+BENCHMARK(BM_PlaneCopy_Memcpy)->Args({320, 180})->Args({640, 360})->Args({1280, 720});
+
+/**
+ * Copying row by row, as needed once planes are padded to a stride
+ */
+static void BM_PlaneCopy_Rows(benchmark::State& state) {
+    auto data = makeVideo(state);
+    vector<char> frame(data.GetBufferLen());
+    size_t width = data.GetStreamWidth();
+    size_t height = data.GetStreamHeight();
+
+    for (auto _ : state) {
+        auto* out = frame.data();
+
+        for (size_t y = 0; y < height; ++y, out += width)
+            memcpy(out, data.GetYBuffer() + y * width, width);
+
+        for (auto* plane : {data.GetUBuffer(), data.GetVBuffer()}) {
+            for (size_t y = 0; y < height / 2; ++y, out += width / 2)
+                memcpy(out, plane + y * (width / 2), width / 2);
+        }
+
+        benchmark::ClobberMemory();
+    }
+
+    state.SetBytesProcessed(state.iterations() * data.GetBufferLen());
+}
+BENCHMARK(BM_PlaneCopy_Rows)->Args({320, 180})->Args({640, 360})->Args({1280, 720});
+
+/**
+ * Copying byte by byte, what a hand written loop over the planes costs
+ * when the compiler does not vectorize it
+ */
+static void BM_PlaneCopy_Bytes(benchmark::State& state) {
+    auto data = makeVideo(state);
+    vector<char> frame(data.GetBufferLen());
+    auto* in = reinterpret_cast<volatile const char*>(data.GetBuffer());
+
+    for (auto _ : state) {
+        for (size_t i = 0; i < frame.size(); ++i)
+            frame[i] = in[i];
+
+        benchmark::ClobberMemory();
+    }
+
+    state.SetBytesProcessed(state.iterations() * data.GetBufferLen());
+}
+BENCHMARK(BM_PlaneCopy_Bytes)->Args({320, 180})->Args({640, 360})->Args({1280, 720});
@@ -0,0 +1,39 @@
+#ifndef MEETING_SDK_LINUX_SAMPLE_SILENCED_H
+#define MEETING_SDK_LINUX_SAMPLE_SILENCED_H
+
+#include <iostream>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+using namespace std;
+
+/**
+ * Sends stdout to /dev/null while a benchmark logs on every iteration, so the
+ * cost of writing the log lines is measured without flooding the console
+ */
+class Silenced {
+    int m_stdout;
+
+public:
+    Silenced() {
+        cout.flush();
+        m_stdout = dup(STDOUT_FILENO);
+
+        auto null = open("/dev/null", O_WRONLY);
+        dup2(null, STDOUT_FILENO);
+        close(null);
+    }
+
+    ~Silenced() {
+        cout.flush();
+        dup2(m_stdout, STDOUT_FILENO);
+        close(m_stdout);
+    }
+
+    Silenced(const Silenced&) = delete;
+    Silenced& operator=(const Silenced&) = delete;
+};
+
+
+#endif //MEETING_SDK_LINUX_SAMPLE_SILENCED_H
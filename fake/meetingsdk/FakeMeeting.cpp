@@ -0,0 +1,520 @@
+#include "FakeMeeting.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+
+#include <glib.h>
+
+// ids the SDK hands out are spaced like this
+static const unsigned int firstUserId = 16778240;
+static const unsigned int userIdStep = 1024;
+
+namespace {
+    class ReminderContent : public IMeetingReminderContent {
+        string m_text;
+
+    public:
+        explicit ReminderContent(const string& text) : m_text(text) {}
+
+        MeetingReminderType GetType() override { return TYPE_RECORD_DISCLAIMER; }
+        const zchar_t* GetTitle() override { return m_text.c_str(); }
+        const zchar_t* GetContent() override { return m_text.c_str(); }
+        bool IsBlocking() override { return false; }
+    };
+
+    class ReminderHandler : public IMeetingReminderHandler {
+    public:
+        SDKError Accept() override {
+            cout << "[fake sdk] reminder accepted" << endl;
+            return SDKERR_SUCCESS;
+        }
+
+        SDKError Decline() override {
+            cout << "[fake sdk] reminder declined" << endl;
+            return SDKERR_SUCCESS;
+        }
+
+        SDKError Ignore() override {
+            return SDKERR_SUCCESS;
+        }
+    };
+}
+
+static gboolean run(gpointer data) {
+    (*static_cast<function<void()>*>(data))();
+    return G_SOURCE_REMOVE;
+}
+
+static void destroy(gpointer data) {
+    delete static_cast<function<void()>*>(data);
+}
+
+FakeMeeting::FakeMeeting() : m_nextId(firstUserId) {}
+
+FakeMeeting::~FakeMeeting() {
+    clean();
+}
+
+FakeMeeting& FakeMeeting::instance() {
+    static FakeMeeting meeting;
+    return meeting;
+}
+
+SDKError FakeMeeting::init() {
+    if (m_initialized) return SDKERR_WRONG_USAGE;
+
+    string error;
+    Scenario scenario;
+
+    auto* path = getenv("FAKE_MEETINGSDK_SCENARIO");
+    if ((path && !scenario.load(path, error)) || !scenario.applyEnvironment(error)) {
+        cerr << "[fake sdk] " << error << endl;
+        return SDKERR_INVALID_PARAMETER;
+    }
+
+    auto audioFrame = make_unique<FakeAudioRawData>(scenario.sampleRate, scenario.channels);
+    auto videoFrame = make_unique<FakeVideoRawData>(scenario.width, scenario.height);
+
+    if (scenario.audioFile.empty() || scenario.audioFile == "-")
+        m_audioFixture.tone(scenario.sampleRate, scenario.channels);
+    else if (!m_audioFixture.load(scenario.audioFile, audioFrame->GetBufferLen())) {
+        cerr << "[fake sdk] unable to read audio fixture " << scenario.audioFile << endl;
+        return SDKERR_INVALID_PARAMETER;
+    }
+
+    if (scenario.videoFile.empty() || scenario.videoFile == "-")
+        m_videoFixture.bars(scenario.width, scenario.height);
+    else if (!m_videoFixture.load(scenario.videoFile, videoFrame->GetBufferLen())) {
+        cerr << "[fake sdk] unable to read video fixture " << scenario.videoFile << endl;
+        return SDKERR_INVALID_PARAMETER;
+    }
+
+    m_scenario = scenario;
+    m_audioFrame = std::move(audioFrame);
+    m_videoFrame = std::move(videoFrame);
+    m_stopping = false;
+    m_initialized = true;
+
+    cout << "[fake sdk] " << (path ? path : "default scenario") << ": " << scenario.participants
+         << " participants, " << scenario.sampleRate << " Hz audio, " << scenario.width << "x" << scenario.height
+         << " video at " << scenario.fps << " fps, speed " << scenario.speed << endl;
+
+    auto audioPeriod = chrono::duration<double>(0.01 / scenario.speed);
+    auto videoPeriod = chrono::duration<double>(1.0 / scenario.fps / scenario.speed);
+
+    m_audioPump = thread([this, audioPeriod]() {
+        pump(chrono::duration_cast<chrono::nanoseconds>(audioPeriod), [this](const vector<unsigned int>& users) {
+            deliverAudio(users);
+        });
+    });
+
+    m_videoPump = thread([this, videoPeriod]() {
+        pump(chrono::duration_cast<chrono::nanoseconds>(videoPeriod), [this](const vector<unsigned int>& users) {
+            deliverVideo(users);
+        });
+    });
+
+    return SDKERR_SUCCESS;
+}
+
+void FakeMeeting::clean() {
+    if (!m_initialized) return;
+
+    {
+        lock_guard<mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wake.notify_all();
+
+    m_audioPump.join();
+    m_videoPump.join();
+
+    cout << "[fake sdk] delivered " << m_audioFrames.load() << " audio and " << m_videoFrames.load()
+         << " video frames, the pumps fell behind " << m_late.load() << " times" << endl;
+
+    {
+        lock_guard<mutex> lock(m_mutex);
+        m_status = MEETING_STATUS_IDLE;
+        m_users.clear();
+        m_departed.clear();
+        m_order.clear();
+        m_self = 0;
+        m_nextId = firstUserId;
+        m_privilege = false;
+        m_recording = false;
+    }
+
+    m_audio = nullptr;
+    m_video.clear();
+    m_audioFrames = m_videoFrames = m_late = 0;
+
+    m_authEvent = nullptr;
+    m_meetingEvent = nullptr;
+    m_participantsEvent = nullptr;
+    m_recordingEvent = nullptr;
+    m_reminderEvent = nullptr;
+
+    m_authenticated = false;
+    m_initialized = false;
+    ++m_generation;
+}
+
+void FakeMeeting::post(double delay, function<void()> fn) {
+    auto generation = m_generation;
+    auto* task = new function<void()>([this, generation, fn = std::move(fn)]() {
+        if (generation == m_generation) fn();
+    });
+
+    auto ms = static_cast<guint>(delay * 1000 / m_scenario.speed);
+    g_timeout_add_full(G_PRIORITY_DEFAULT, ms, run, task, destroy);
+}
+
+SDKError FakeMeeting::auth(const zchar_t* jwt) {
+    if (!m_initialized) return SDKERR_UNINITIALIZE;
+
+    auto result = jwt && *jwt ? AUTHRET_SUCCESS : AUTHRET_KEYORSECRETEMPTY;
+    post(m_scenario.authDelay, [this, result]() {
+        m_authenticated = result == AUTHRET_SUCCESS;
+        if (m_authEvent) m_authEvent->onAuthenticationReturn(result);
+    });
+
+    return SDKERR_SUCCESS;
+}
+
+SDKError FakeMeeting::join(const zchar_t* displayName) {
+    if (!m_authenticated) return SDKERR_UNAUTHENTICATION;
+    if (status() != MEETING_STATUS_IDLE) return SDKERR_WRONG_USAGE;
+
+    m_displayName = displayName ? displayName : "";
+    setStatus(MEETING_STATUS_CONNECTING);
+
+    post(m_scenario.joinDelay, [this]() { enter(); });
+    return SDKERR_SUCCESS;
+}
+
+void FakeMeeting::enter() {
+    {
+        lock_guard<mutex> lock(m_mutex);
+        if (m_status != MEETING_STATUS_CONNECTING) return;
+
+        m_self = addUser(m_nextId, m_displayName, true)->GetUserID();
+        for (unsigned int i = 1; i <= m_scenario.participants; ++i)
+            addUser(m_nextId, m_scenario.prefix + " " + to_string(i), false);
+
+        m_privilege = m_scenario.privilege == Scenario::Granted;
+    }
+
+    setStatus(MEETING_STATUS_INMEETING);
+
+    for (const auto& event : m_scenario.timeline)
+        post(event.at, [this, event]() { play(event); });
+}
+
+SDKError FakeMeeting::leave() {
+    auto current = status();
+    if (current == MEETING_STATUS_IDLE || current == MEETING_STATUS_ENDED) return SDKERR_WRONG_USAGE;
+
+    setStatus(MEETING_STATUS_DISCONNECTING);
+    post(0.1, [this]() { setStatus(MEETING_STATUS_ENDED); });
+
+    return SDKERR_SUCCESS;
+}
+
+MeetingStatus FakeMeeting::status() const {
+    lock_guard<mutex> lock(m_mutex);
+    return m_status;
+}
+
+void FakeMeeting::setStatus(MeetingStatus status) {
+    {
+        lock_guard<mutex> lock(m_mutex);
+        m_status = status;
+
+        // frames stop with the meeting
+        if (status != MEETING_STATUS_INMEETING)
+            m_recording = false;
+    }
+
+    post(0, [this, status]() {
+        if (m_meetingEvent) m_meetingEvent->onMeetingStatusChanged(status, 0);
+    });
+}
+
+void FakeMeeting::play(const Scenario::Event& event) {
+    if (status() != MEETING_STATUS_INMEETING) return;
+
+    IdList ids({event.userId});
+
+    switch (event.type) {
+        case Scenario::Event::Join: {
+            {
+                lock_guard<mutex> lock(m_mutex);
+                addUser(event.userId, event.text, false);
+            }
+            if (m_participantsEvent) m_participantsEvent->onUserJoin(&ids);
+            break;
+        }
+        case Scenario::Event::Left: {
+            bool removed;
+            {
+                lock_guard<mutex> lock(m_mutex);
+                removed = removeUser(event.userId);
+            }
+            if (removed && m_participantsEvent) m_participantsEvent->onUserLeft(&ids);
+            break;
+        }
+        case Scenario::Event::Rename: {
+            User* renamed = nullptr;
+            {
+                lock_guard<mutex> lock(m_mutex);
+                auto it = m_users.find(event.userId);
+                if (it != m_users.end()) {
+                    renamed = it->second.get();
+                    renamed->rename(event.text);
+                }
+            }
+            if (renamed && m_participantsEvent) m_participantsEvent->onUserNamesChanged(&ids);
+            break;
+        }
+        case Scenario::Event::SetPrivilege:
+            setPrivilege(event.granted);
+            break;
+        case Scenario::Event::Reminder: {
+            ReminderContent content(event.text);
+            ReminderHandler handler;
+            if (m_reminderEvent) m_reminderEvent->onReminderNotify(&content, &handler);
+            break;
+        }
+        case Scenario::Event::End:
+            cout << "[fake sdk] the host ended the meeting" << endl;
+            setStatus(MEETING_STATUS_ENDED);
+            break;
+    }
+}
+
+void FakeMeeting::setPrivilege(bool granted) {
+    {
+        lock_guard<mutex> lock(m_mutex);
+        m_privilege = granted;
+        if (!granted) m_recording = false;
+    }
+
+    if (m_recordingEvent) m_recordingEvent->onRecordPrivilegeChanged(granted);
+}
+
+FakeMeeting::User* FakeMeeting::addUser(unsigned int id, const string& name, bool self) {
+    auto& user = m_users[id];
+    if (!user) m_order.push_back(id);
+
+    user = make_unique<User>(id, name, self);
+    if (id >= m_nextId) m_nextId = id + userIdStep;
+
+    return user.get();
+}
+
+bool FakeMeeting::removeUser(unsigned int id) {
+    auto it = m_users.find(id);
+    if (it == m_users.end()) return false;
+
+    // the bot may still hold the user from a lookup
+    m_departed.push_back(std::move(it->second));
+    m_users.erase(it);
+    m_order.erase(find(m_order.begin(), m_order.end(), id));
+
+    return true;
+}
+
+vector<unsigned int> FakeMeeting::users() const {
+    lock_guard<mutex> lock(m_mutex);
+    return m_order;
+}
+
+FakeMeeting::User* FakeMeeting::user(unsigned int id) {
+    lock_guard<mutex> lock(m_mutex);
+
+    auto it = m_users.find(id);
+    if (it != m_users.end()) return it->second.get();
+
+    for (const auto& departed : m_departed) {
+        if (departed->GetUserID() == id) return departed.get();
+    }
+
+    return nullptr;
+}
+
+FakeMeeting::User* FakeMeeting::self() {
+    return m_self ? user(m_self) : nullptr;
+}
+
+SDKError FakeMeeting::canStartRawRecording() const {
+    lock_guard<mutex> lock(m_mutex);
+    if (m_status != MEETING_STATUS_INMEETING) return SDKERR_WRONG_USAGE;
+
+    return m_privilege ? SDKERR_SUCCESS : SDKERR_NO_PERMISSION;
+}
+
+SDKError FakeMeeting::startRawRecording() {
+    auto err = canStartRawRecording();
+    if (err != SDKERR_SUCCESS) return err;
+
+    {
+        lock_guard<mutex> lock(m_mutex);
+        m_recording = true;
+    }
+
+    post(0, [this]() {
+        if (m_recordingEvent) m_recordingEvent->onRecordingStatus(Recording_Start);
+    });
+
+    return SDKERR_SUCCESS;
+}
+
+SDKError FakeMeeting::stopRawRecording() {
+    {
+        lock_guard<mutex> lock(m_mutex);
+        if (!m_recording) return SDKERR_WRONG_USAGE;
+
+        m_recording = false;
+    }
+
+    post(0, [this]() {
+        if (m_recordingEvent) m_recordingEvent->onRecordingStatus(Recording_Stop);
+    });
+
+    return SDKERR_SUCCESS;
+}
+
+SDKError FakeMeeting::requestPrivilege() {
+    if (status() != MEETING_STATUS_INMEETING) return SDKERR_WRONG_USAGE;
+
+    // the host answers after a moment, with what the scenario grants
+    auto granted = m_scenario.privilege != Scenario::Denied;
+    post(1, [this, granted]() {
+        if (m_recordingEvent)
+            m_recordingEvent->onLocalRecordingPrivilegeRequestStatus(granted ? RequestLocalRecording_Granted : RequestLocalRecording_Denied);
+
+        if (granted) setPrivilege(true);
+    });
+
+    return SDKERR_SUCCESS;
+}
+
+SDKError FakeMeeting::chat(unsigned int receiver, SDKChatMessageType type, const string& content) {
+    if (status() != MEETING_STATUS_INMEETING) return SDKERR_WRONG_USAGE;
+
+    if (type == SDKChatMessageType_To_All) {
+        cout << "[fake sdk] chat to everyone: " << content << endl;
+        return SDKERR_SUCCESS;
+    }
+
+    auto* to = user(receiver);
+    if (!to) return SDKERR_INVALID_PARAMETER;
+
+    cout << "[fake sdk] chat to " << to->GetUserName() << ": " << content << endl;
+    return SDKERR_SUCCESS;
+}
+
+SDKError FakeMeeting::subscribeAudio(IZoomSDKAudioRawDataDelegate* delegate) {
+    if (!delegate) return SDKERR_INVALID_PARAMETER;
+
+    lock_guard<mutex> lock(m_audioMutex);
+    m_audio = delegate;
+
+    return SDKERR_SUCCESS;
+}
+
+SDKError FakeMeeting::unsubscribeAudio() {
+    lock_guard<mutex> lock(m_audioMutex);
+    m_audio = nullptr;
+
+    return SDKERR_SUCCESS;
+}
+
+SDKError FakeMeeting::subscribeVideo(IZoomSDKRendererDelegate* delegate, unsigned int userId) {
+    {
+        lock_guard<mutex> lock(m_mutex);
+        if (!m_users.count(userId)) return SDKERR_INVALID_PARAMETER;
+    }
+
+    lock_guard<mutex> lock(m_videoMutex);
+
+    auto it = find_if(m_video.begin(), m_video.end(), [delegate](const pair<IZoomSDKRendererDelegate*, unsigned int>& entry) {
+        return entry.first == delegate;
+    });
+
+    if (it != m_video.end()) it->second = userId;
+    else m_video.emplace_back(delegate, userId);
+
+    return SDKERR_SUCCESS;
+}
+
+SDKError FakeMeeting::unsubscribeVideo(IZoomSDKRendererDelegate* delegate) {
+    lock_guard<mutex> lock(m_videoMutex);
+
+    auto size = m_video.size();
+    m_video.erase(remove_if(m_video.begin(), m_video.end(), [delegate](const pair<IZoomSDKRendererDelegate*, unsigned int>& entry) {
+        return entry.first == delegate;
+    }), m_video.end());
+
+    return m_video.size() < size ? SDKERR_SUCCESS : SDKERR_WRONG_USAGE;
+}
+
+void FakeMeeting::pump(chrono::nanoseconds period, const function<void(const vector<unsigned int>&)>& deliver) {
+    auto next = chrono::steady_clock::now();
+    vector<unsigned int> users;
+
+    unique_lock<mutex> lock(m_mutex);
+    while (!m_wake.wait_until(lock, next, [this]() { return m_stopping; })) {
+        if (m_recording) {
+            users = m_order;
+
+            lock.unlock();
+            deliver(users);
+            lock.lock();
+        }
+
+        // a slow delegate delays the frames after it rather than bursting them
+        next += period;
+        auto now = chrono::steady_clock::now();
+        if (now > next + period) {
+            m_late.fetch_add(1, memory_order_relaxed);
+            next = now;
+        }
+    }
+}
+
+void FakeMeeting::deliverAudio(const vector<unsigned int>& users) {
+    lock_guard<mutex> lock(m_audioMutex);
+    if (!m_audio) return;
+
+    auto& frame = *m_audioFrame;
+
+    m_audioFixture.next(frame.GetBuffer(), frame.GetBufferLen());
+    m_audio->onMixedAudioRawDataReceived(&frame);
+
+    for (auto id : users) {
+        if (id == m_self) continue;
+
+        m_audioFixture.next(frame.GetBuffer(), frame.GetBufferLen());
+        m_audio->onOneWayAudioRawDataReceived(&frame, id);
+    }
+
+    m_audioFrames.fetch_add(users.size(), memory_order_relaxed);
+}
+
+void FakeMeeting::deliverVideo(const vector<unsigned int>& users) {
+    lock_guard<mutex> lock(m_videoMutex);
+    if (m_video.empty()) return;
+
+    auto& frame = *m_videoFrame;
+    m_videoFixture.next(frame.GetBuffer(), frame.GetBufferLen());
+
+    for (const auto& entry : m_video) {
+        if (find(users.begin(), users.end(), entry.second) == users.end()) continue;
+
+        frame.setSourceId(entry.second);
+        entry.first->onRawDataFrameReceived(&frame);
+        m_videoFrames.fetch_add(1, memory_order_relaxed);
+    }
+}
@@ -0,0 +1,191 @@
+#ifndef FAKE_MEETINGSDK_FAKEMEETING_H
+#define FAKE_MEETINGSDK_FAKEMEETING_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "auth_service_interface.h"
+#include "meeting_service_interface.h"
+#include "rawdata/rawdata_audio_helper_interface.h"
+#include "rawdata/rawdata_renderer_interface.h"
+
+#include "FakeRawData.h"
+#include "Scenario.h"
+
+using namespace std;
+using namespace ZOOMSDK;
+
+/**
+ * Meeting simulated by the fake SDK, driven by a Scenario.
+ *
+ * Like the SDK's, events are delivered on the glib main loop, so they only
+ * fire while the bot runs it. Raw audio and video are delivered on two pump
+ * threads of their own at the scenario's rates, as long as raw recording is
+ * started and someone subscribed. Once an unsubscribe returns no callback of
+ * that subscription is running or will be made.
+ */
+class FakeMeeting {
+public:
+    class User : public IUserInfo {
+        unsigned int m_id;
+        string m_name;
+        bool m_self;
+
+    public:
+        User(unsigned int id, const string& name, bool self) : m_id(id), m_name(name), m_self(self) {}
+
+        void rename(const string& name) { m_name = name; }
+
+        const zchar_t* GetUserName() override { return m_name.c_str(); }
+        unsigned int GetUserID() override { return m_id; }
+        bool IsMySelf() override { return m_self; }
+    };
+
+    class IdList : public IList<unsigned int> {
+        vector<unsigned int> m_ids;
+
+    public:
+        explicit IdList(vector<unsigned int> ids = {}) : m_ids(std::move(ids)) {}
+
+        int GetCount() override { return static_cast<int>(m_ids.size()); }
+        unsigned int GetItem(int index) override { return m_ids.at(index); }
+    };
+
+private:
+    Scenario m_scenario;
+    bool m_initialized = false;
+
+    // bumped by clean() so events still queued on the main loop are ignored
+    uint64_t m_generation = 0;
+
+    IAuthServiceEvent* m_authEvent = nullptr;
+    IMeetingServiceEvent* m_meetingEvent = nullptr;
+    IMeetingParticipantsCtrlEvent* m_participantsEvent = nullptr;
+    IMeetingRecordingCtrlEvent* m_recordingEvent = nullptr;
+    IMeetingReminderEvent* m_reminderEvent = nullptr;
+
+    bool m_authenticated = false;
+    string m_displayName;
+
+    // users, status and recording state, read by the pumps
+    mutable mutex m_mutex;
+    condition_variable m_wake;
+    MeetingStatus m_status = MEETING_STATUS_IDLE;
+    unordered_map<unsigned int, unique_ptr<User>> m_users;
+    vector<unique_ptr<User>> m_departed;
+    vector<unsigned int> m_order;
+    unsigned int m_self = 0;
+    unsigned int m_nextId;
+    bool m_privilege = false;
+    bool m_recording = false;
+    bool m_stopping = false;
+
+    // held while frames are delivered, and by whoever changes the subscriptions
+    mutex m_audioMutex;
+    IZoomSDKAudioRawDataDelegate* m_audio = nullptr;
+    Fixture m_audioFixture;
+    unique_ptr<FakeAudioRawData> m_audioFrame;
+
+    mutex m_videoMutex;
+    vector<pair<IZoomSDKRendererDelegate*, unsigned int>> m_video;
+    Fixture m_videoFixture;
+    unique_ptr<FakeVideoRawData> m_videoFrame;
+
+    thread m_audioPump;
+    thread m_videoPump;
+    atomic<uint64_t> m_audioFrames{0};
+    atomic<uint64_t> m_videoFrames{0};
+    atomic<uint64_t> m_late{0};
+
+    FakeMeeting();
+
+    /**
+     * Run a function on the main loop
+     * @param delay seconds of scenario time, scaled by its speed
+     */
+    void post(double delay, function<void()> fn);
+
+    void setStatus(MeetingStatus status);
+    void enter();
+    void play(const Scenario::Event& event);
+    void setPrivilege(bool granted);
+
+    User* addUser(unsigned int id, const string& name, bool self);
+    bool removeUser(unsigned int id);
+
+    /**
+     * Deliver frames every period until clean()
+     * @param deliver called with the users present, only while recording
+     */
+    void pump(chrono::nanoseconds period, const function<void(const vector<unsigned int>&)>& deliver);
+    void deliverAudio(const vector<unsigned int>& users);
+    void deliverVideo(const vector<unsigned int>& users);
+
+public:
+    static FakeMeeting& instance();
+
+    FakeMeeting(const FakeMeeting&) = delete;
+    FakeMeeting& operator=(const FakeMeeting&) = delete;
+
+    ~FakeMeeting();
+
+    /**
+     * Load the scenario and start the pumps
+     */
+    SDKError init();
+
+    /**
+     * Stop the pumps and forget the meeting, init() may be called again
+     */
+    void clean();
+
+    void setAuthEvent(IAuthServiceEvent* event) { m_authEvent = event; }
+    void setMeetingEvent(IMeetingServiceEvent* event) { m_meetingEvent = event; }
+    void setParticipantsEvent(IMeetingParticipantsCtrlEvent* event) { m_participantsEvent = event; }
+    void setRecordingEvent(IMeetingRecordingCtrlEvent* event) { m_recordingEvent = event; }
+    void setReminderEvent(IMeetingReminderEvent* event) { m_reminderEvent = event; }
+
+    SDKError auth(const zchar_t* jwt);
+    SDKError join(const zchar_t* displayName);
+    SDKError leave();
+    MeetingStatus status() const;
+
+    /**
+     * @return ids of the users in the meeting in the order they joined, the bot first
+     */
+    vector<unsigned int> users() const;
+
+    /**
+     * @return nullptr if the user never was in the meeting, users who left stay valid
+     */
+    User* user(unsigned int id);
+    User* self();
+
+    SDKError canStartRawRecording() const;
+    SDKError startRawRecording();
+    SDKError stopRawRecording();
+    SDKError requestPrivilege();
+
+    SDKError chat(unsigned int receiver, SDKChatMessageType type, const string& content);
+
+    SDKError subscribeAudio(IZoomSDKAudioRawDataDelegate* delegate);
+    SDKError unsubscribeAudio();
+
+    /**
+     * @param delegate renderer to receive the user's frames, at most one user each
+     */
+    SDKError subscribeVideo(IZoomSDKRendererDelegate* delegate, unsigned int userId);
+    SDKError unsubscribeVideo(IZoomSDKRendererDelegate* delegate);
+};
+
+
+#endif //FAKE_MEETINGSDK_FAKEMEETING_H
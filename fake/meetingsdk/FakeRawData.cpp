@@ -0,0 +1,72 @@
+#include "FakeRawData.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+FakeAudioRawData::FakeAudioRawData(unsigned int sampleRate, unsigned int channels, unsigned int duration) :
+        m_buffer(static_cast<size_t>(sampleRate) * channels * sizeof(int16_t) * duration / 1000),
+        m_sampleRate(sampleRate),
+        m_channels(channels) {}
+
+FakeVideoRawData::FakeVideoRawData(unsigned int width, unsigned int height) :
+        m_buffer(static_cast<size_t>(width) * height * 3 / 2),
+        m_width(width),
+        m_height(height) {}
+
+bool Fixture::load(const string& path, size_t frameSize) {
+    ifstream file(path, ios::binary);
+    if (!file.is_open()) return false;
+
+    vector<char> data((istreambuf_iterator<char>(file)), istreambuf_iterator<char>());
+    data.resize(data.size() - data.size() % frameSize);
+    if (data.empty()) return false;
+
+    m_data = std::move(data);
+    m_offset = 0;
+    return true;
+}
+
+void Fixture::tone(unsigned int sampleRate, unsigned int channels) {
+    m_data.resize(static_cast<size_t>(sampleRate) * channels * sizeof(int16_t));
+    m_offset = 0;
+
+    auto* samples = reinterpret_cast<int16_t*>(m_data.data());
+    for (unsigned int i = 0; i < sampleRate; ++i) {
+        auto sample = static_cast<int16_t>(8000 * sin(2 * M_PI * 440 * i / sampleRate));
+        for (unsigned int c = 0; c < channels; ++c)
+            samples[i * channels + c] = sample;
+    }
+}
+
+void Fixture::bars(unsigned int width, unsigned int height) {
+    size_t luma = static_cast<size_t>(width) * height;
+    m_data.assign(luma * 3 / 2, static_cast<char>(128));
+    m_offset = 0;
+
+    // eight vertical bars from black to white, chroma stays neutral
+    for (unsigned int y = 0; y < height; ++y) {
+        for (unsigned int x = 0; x < width; ++x)
+            m_data[static_cast<size_t>(y) * width + x] = static_cast<char>(16 + 219 * (x * 8 / width) / 7);
+    }
+}
+
+void Fixture::next(char* frame, size_t size) {
+    if (m_data.empty()) {
+        memset(frame, 0, size);
+        return;
+    }
+
+    // a fixture recorded at another frame size wraps mid frame rather than failing
+    size_t copied = 0;
+    while (copied < size) {
+        auto chunk = min(size - copied, m_data.size() - m_offset);
+        memcpy(frame + copied, m_data.data() + m_offset, chunk);
+
+        copied += chunk;
+        m_offset = (m_offset + chunk) % m_data.size();
+    }
+}
@@ -0,0 +1,109 @@
+#ifndef FAKE_MEETINGSDK_FAKERAWDATA_H
+#define FAKE_MEETINGSDK_FAKERAWDATA_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "zoom_sdk_raw_data_def.h"
+
+using namespace std;
+
+/**
+ * Audio frame as handed to IZoomSDKAudioRawDataDelegate, interleaved 16 bit
+ * PCM. Frames are owned by whoever delivers them and reused for the next one,
+ * like the SDK's they are only valid during the callback.
+ */
+class FakeAudioRawData : public AudioRawData {
+    vector<char> m_buffer;
+    unsigned int m_sampleRate;
+    unsigned int m_channels;
+
+public:
+    /**
+     * @param duration milliseconds of audio per frame, the SDK delivers 10
+     */
+    FakeAudioRawData(unsigned int sampleRate, unsigned int channels, unsigned int duration = 10);
+
+    bool CanAddRef() override { return false; }
+    bool AddRef() override { return false; }
+    int Release() override { return 0; }
+
+    char* GetBuffer() override { return m_buffer.data(); }
+    unsigned int GetBufferLen() override { return static_cast<unsigned int>(m_buffer.size()); }
+    unsigned int GetSampleRate() override { return m_sampleRate; }
+    unsigned int GetChannelNum() override { return m_channels; }
+};
+
+/**
+ * I420 video frame as handed to IZoomSDKRendererDelegate, the three planes
+ * are contiguous in one buffer
+ */
+class FakeVideoRawData : public YUVRawDataI420 {
+    vector<char> m_buffer;
+    unsigned int m_width;
+    unsigned int m_height;
+    unsigned int m_sourceId = 0;
+
+public:
+    FakeVideoRawData(unsigned int width, unsigned int height);
+
+    /**
+     * @param sourceId user the frame is delivered for
+     */
+    void setSourceId(unsigned int sourceId) { m_sourceId = sourceId; }
+
+    bool CanAddRef() override { return false; }
+    bool AddRef() override { return false; }
+    int Release() override { return 0; }
+
+    char* GetYBuffer() override { return m_buffer.data(); }
+    char* GetUBuffer() override { return m_buffer.data() + m_width * m_height; }
+    char* GetVBuffer() override { return GetUBuffer() + m_width * m_height / 4; }
+    char* GetBuffer() override { return m_buffer.data(); }
+    unsigned int GetBufferLen() override { return static_cast<unsigned int>(m_buffer.size()); }
+    bool IsLimitedI420() override { return true; }
+    unsigned int GetStreamWidth() override { return m_width; }
+    unsigned int GetStreamHeight() override { return m_height; }
+    unsigned int GetRotation() override { return 0; }
+    unsigned int GetSourceID() override { return m_sourceId; }
+    void* GetResource() override { return nullptr; }
+};
+
+/**
+ * Media replayed into frames, a recording loaded from disk or a synthetic
+ * signal, looped when its end is reached
+ */
+class Fixture {
+    vector<char> m_data;
+    size_t m_offset = 0;
+
+public:
+    /**
+     * Load a raw recording as written by the bot, .pcm or .yuv
+     * @param frameSize bytes of one frame, trailing bytes of a partial frame are dropped
+     * @return false if the file could not be read or holds less than a frame
+     */
+    bool load(const string& path, size_t frameSize);
+
+    /**
+     * One second of a 440 Hz tone
+     */
+    void tone(unsigned int sampleRate, unsigned int channels);
+
+    /**
+     * A single frame of grey bars
+     */
+    void bars(unsigned int width, unsigned int height);
+
+    /**
+     * Copy the next frame of the fixture, the same fixture can feed frames
+     * of several participants
+     */
+    void next(char* frame, size_t size);
+
+    bool empty() const { return m_data.empty(); }
+};
+
+
+#endif //FAKE_MEETINGSDK_FAKERAWDATA_H
@@ -0,0 +1,261 @@
+#include "zoom_sdk.h"
+#include "setting_service_interface.h"
+#include "rawdata/zoom_rawdata_api.h"
+
+#include "FakeMeeting.h"
+
+/*
+ * The services the bot creates, each forwards to the simulated meeting
+ */
+namespace {
+    class AuthService : public IAuthService {
+    public:
+        SDKError SetEvent(IAuthServiceEvent* pEvent) override {
+            FakeMeeting::instance().setAuthEvent(pEvent);
+            return SDKERR_SUCCESS;
+        }
+
+        SDKError SDKAuth(AuthContext& authContext) override {
+            return FakeMeeting::instance().auth(authContext.jwt_token);
+        }
+    };
+
+    class AudioSettings : public IAudioSettingContext {
+    public:
+        SDKError EnableAutoJoinAudio(bool bEnable) override {
+            return SDKERR_SUCCESS;
+        }
+    };
+
+    class SettingService : public ISettingService {
+        AudioSettings m_audio;
+
+    public:
+        IAudioSettingContext* GetAudioSettings() override {
+            return &m_audio;
+        }
+    };
+
+    class RecordingController : public IMeetingRecordingController {
+    public:
+        SDKError SetEvent(IMeetingRecordingCtrlEvent* pEvent) override {
+            FakeMeeting::instance().setRecordingEvent(pEvent);
+            return SDKERR_SUCCESS;
+        }
+
+        SDKError CanStartRawRecording() override { return FakeMeeting::instance().canStartRawRecording(); }
+        SDKError StartRawRecording() override { return FakeMeeting::instance().startRawRecording(); }
+        SDKError StopRawRecording() override { return FakeMeeting::instance().stopRawRecording(); }
+        SDKError RequestLocalRecordingPrivilege() override { return FakeMeeting::instance().requestPrivilege(); }
+    };
+
+    class ParticipantsController : public IMeetingParticipantsController {
+        FakeMeeting::IdList m_list;
+
+    public:
+        SDKError SetEvent(IMeetingParticipantsCtrlEvent* pEvent) override {
+            FakeMeeting::instance().setParticipantsEvent(pEvent);
+            return SDKERR_SUCCESS;
+        }
+
+        // valid until the next call, like the SDK's
+        IList<unsigned int>* GetParticipantsList() override {
+            m_list = FakeMeeting::IdList(FakeMeeting::instance().users());
+            return &m_list;
+        }
+
+        IUserInfo* GetUserByUserID(unsigned int userid) override { return FakeMeeting::instance().user(userid); }
+        IUserInfo* GetMySelfUser() override { return FakeMeeting::instance().self(); }
+    };
+
+    class ChatMessage : public IChatMsgInfo {
+    public:
+        string content;
+        unsigned int receiver = 0;
+        SDKChatMessageType type = SDKChatMessageType_To_All;
+    };
+
+    class ChatController : public IMeetingChatController, public IChatMsgInfoBuilder {
+        ChatMessage m_message;
+
+    public:
+        IChatMsgInfoBuilder* GetChatMessageBuilder() override {
+            m_message = ChatMessage();
+            return this;
+        }
+
+        IChatMsgInfoBuilder* SetContent(const zchar_t* content) override {
+            m_message.content = content ? content : "";
+            return this;
+        }
+
+        IChatMsgInfoBuilder* SetReceiver(unsigned int receiver) override {
+            m_message.receiver = receiver;
+            return this;
+        }
+
+        IChatMsgInfoBuilder* SetMessageType(SDKChatMessageType type) override {
+            m_message.type = type;
+            return this;
+        }
+
+        IChatMsgInfo* Build() override {
+            return &m_message;
+        }
+
+        SDKError SendChatMsgTo(IChatMsgInfo* msg) override {
+            auto* message = static_cast<ChatMessage*>(msg);
+            if (!message) return SDKERR_INVALID_PARAMETER;
+
+            return FakeMeeting::instance().chat(message->receiver, message->type, message->content);
+        }
+    };
+
+    class ReminderController : public IMeetingReminderController {
+    public:
+        SDKError SetEvent(IMeetingReminderEvent* pEvent) override {
+            FakeMeeting::instance().setReminderEvent(pEvent);
+            return SDKERR_SUCCESS;
+        }
+    };
+
+    class MeetingService : public IMeetingService {
+        RecordingController m_recording;
+        ParticipantsController m_participants;
+        ChatController m_chat;
+        ReminderController m_reminder;
+
+    public:
+        SDKError SetEvent(IMeetingServiceEvent* pEvent) override {
+            FakeMeeting::instance().setMeetingEvent(pEvent);
+            return SDKERR_SUCCESS;
+        }
+
+        SDKError Join(JoinParam& joinParam) override {
+            if (joinParam.userType != SDK_UT_WITHOUT_LOGIN) return SDKERR_NO_IMPL;
+            return FakeMeeting::instance().join(joinParam.param.withoutloginuserJoin.userName);
+        }
+
+        // only joining without a login is simulated
+        SDKError Start(StartParam& startParam) override { return SDKERR_NO_IMPL; }
+
+        SDKError Leave(LeaveMeetingCmd leaveCmd) override { return FakeMeeting::instance().leave(); }
+        MeetingStatus GetMeetingStatus() override { return FakeMeeting::instance().status(); }
+
+        IMeetingRecordingController* GetMeetingRecordingController() override { return &m_recording; }
+        IMeetingParticipantsController* GetMeetingParticipantsController() override { return &m_participants; }
+        IMeetingChatController* GetMeetingChatController() override { return &m_chat; }
+        IMeetingReminderController* GetMeetingReminderController() override { return &m_reminder; }
+    };
+
+    class AudioRawDataHelper : public IZoomSDKAudioRawDataHelper {
+    public:
+        SDKError subscribe(IZoomSDKAudioRawDataDelegate* pDelegate, bool bWithInterpreters) override {
+            return FakeMeeting::instance().subscribeAudio(pDelegate);
+        }
+
+        SDKError unSubscribe() override {
+            return FakeMeeting::instance().unsubscribeAudio();
+        }
+    };
+
+    class Renderer : public IZoomSDKRenderer {
+        IZoomSDKRendererDelegate* m_delegate;
+
+    public:
+        explicit Renderer(IZoomSDKRendererDelegate* delegate) : m_delegate(delegate) {}
+
+        IZoomSDKRendererDelegate* delegate() const { return m_delegate; }
+
+        // frames have the scenario's size whatever is asked for
+        SDKError setRawDataResolution(ZoomSDKResolution resolution) override { return SDKERR_SUCCESS; }
+
+        SDKError subscribe(uint32_t subscribeId, ZoomSDKRawDataType type) override {
+            if (type != RAW_DATA_TYPE_VIDEO) return SDKERR_NO_IMPL;
+
+            auto err = FakeMeeting::instance().subscribeVideo(m_delegate, subscribeId);
+            if (err == SDKERR_SUCCESS) m_delegate->onRawDataStatusChanged(IZoomSDKRendererDelegate::RawData_On);
+
+            return err;
+        }
+
+        SDKError unSubscribe() override {
+            auto err = FakeMeeting::instance().unsubscribeVideo(m_delegate);
+            if (err == SDKERR_SUCCESS) m_delegate->onRawDataStatusChanged(IZoomSDKRendererDelegate::RawData_Off);
+
+            return err;
+        }
+    };
+}
+
+BEGIN_ZOOM_SDK_NAMESPACE
+
+SDKError InitSDK(InitParam& initParam) {
+    return FakeMeeting::instance().init();
+}
+
+SDKError CleanUPSDK() {
+    FakeMeeting::instance().clean();
+    return SDKERR_SUCCESS;
+}
+
+SDKError CreateMeetingService(IMeetingService** ppMeetingService) {
+    if (!ppMeetingService) return SDKERR_INVALID_PARAMETER;
+
+    *ppMeetingService = new MeetingService();
+    return SDKERR_SUCCESS;
+}
+
+SDKError DestroyMeetingService(IMeetingService* pMeetingService) {
+    delete pMeetingService;
+    return SDKERR_SUCCESS;
+}
+
+SDKError CreateSettingService(ISettingService** ppSettingService) {
+    if (!ppSettingService) return SDKERR_INVALID_PARAMETER;
+
+    *ppSettingService = new SettingService();
+    return SDKERR_SUCCESS;
+}
+
+SDKError DestroySettingService(ISettingService* pSettingService) {
+    delete pSettingService;
+    return SDKERR_SUCCESS;
+}
+
+SDKError CreateAuthService(IAuthService** ppAuthService) {
+    if (!ppAuthService) return SDKERR_INVALID_PARAMETER;
+
+    *ppAuthService = new AuthService();
+    return SDKERR_SUCCESS;
+}
+
+SDKError DestroyAuthService(IAuthService* pAuthService) {
+    delete pAuthService;
+    return SDKERR_SUCCESS;
+}
+
+SDKError createRenderer(IZoomSDKRenderer** ppRenderer, IZoomSDKRendererDelegate* pDelegate) {
+    if (!ppRenderer || !pDelegate) return SDKERR_INVALID_PARAMETER;
+
+    *ppRenderer = new Renderer(pDelegate);
+    return SDKERR_SUCCESS;
+}
+
+SDKError destroyRenderer(IZoomSDKRenderer* pRenderer) {
+    auto* renderer = static_cast<Renderer*>(pRenderer);
+    if (!renderer) return SDKERR_INVALID_PARAMETER;
+
+    FakeMeeting::instance().unsubscribeVideo(renderer->delegate());
+    renderer->delegate()->onRendererBeDestroyed();
+
+    delete renderer;
+    return SDKERR_SUCCESS;
+}
+
+IZoomSDKAudioRawDataHelper* GetAudioRawdataHelper() {
+    static AudioRawDataHelper helper;
+    return &helper;
+}
+
+END_ZOOM_SDK_NAMESPACE
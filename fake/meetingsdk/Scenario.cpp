@@ -0,0 +1,150 @@
+#include "Scenario.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+static string rest(istringstream& line) {
+    string text;
+    getline(line >> ws, text);
+
+    while (!text.empty() && isspace(static_cast<unsigned char>(text.back())))
+        text.pop_back();
+
+    return text;
+}
+
+static bool parsePrivilege(const string& value, Scenario::Privilege& privilege) {
+    if (value == "granted") privilege = Scenario::Granted;
+    else if (value == "denied") privilege = Scenario::Denied;
+    else if (value == "on-request") privilege = Scenario::OnRequest;
+    else return false;
+
+    return true;
+}
+
+static bool parseEvent(istringstream& line, Scenario::Event& event) {
+    string type;
+    if (!(line >> event.at >> type) || event.at < 0) return false;
+
+    if (type == "join" || type == "rename") {
+        event.type = type == "join" ? Scenario::Event::Join : Scenario::Event::Rename;
+        if (!(line >> event.userId)) return false;
+
+        event.text = rest(line);
+        return !event.text.empty();
+    }
+
+    if (type == "left") {
+        event.type = Scenario::Event::Left;
+        return static_cast<bool>(line >> event.userId);
+    }
+
+    if (type == "privilege") {
+        string value;
+        Scenario::Privilege privilege;
+        if (!(line >> value) || !parsePrivilege(value, privilege) || privilege == Scenario::OnRequest)
+            return false;
+
+        event.type = Scenario::Event::SetPrivilege;
+        event.granted = privilege == Scenario::Granted;
+        return true;
+    }
+
+    if (type == "reminder") {
+        event.type = Scenario::Event::Reminder;
+        event.text = rest(line);
+        return !event.text.empty();
+    }
+
+    if (type == "end") {
+        event.type = Scenario::Event::End;
+        return true;
+    }
+
+    return false;
+}
+
+bool Scenario::parse(const string& text, string& error) {
+    istringstream lines(text);
+    string raw;
+
+    while (getline(lines, raw)) {
+        auto comment = raw.find('#');
+        istringstream line(raw.substr(0, comment));
+
+        string directive;
+        if (!(line >> directive)) continue;
+
+        bool ok;
+        if (directive == "auth-delay") ok = static_cast<bool>(line >> authDelay) && authDelay >= 0;
+        else if (directive == "join-delay") ok = static_cast<bool>(line >> joinDelay) && joinDelay >= 0;
+        else if (directive == "speed") ok = static_cast<bool>(line >> speed) && speed > 0;
+        else if (directive == "privilege") {
+            string value;
+            ok = static_cast<bool>(line >> value) && parsePrivilege(value, privilege);
+        }
+        else if (directive == "audio")
+            ok = static_cast<bool>(line >> audioFile >> sampleRate >> channels) && sampleRate >= 100 && channels > 0;
+        else if (directive == "video")
+            ok = static_cast<bool>(line >> videoFile >> width >> height >> fps)
+                    && width > 0 && height > 0 && width % 2 == 0 && height % 2 == 0 && fps > 0;
+        else if (directive == "participants") {
+            ok = static_cast<bool>(line >> participants);
+            auto name = rest(line);
+            if (!name.empty()) prefix = name;
+        }
+        else if (directive == "at") {
+            Event event{};
+            ok = parseEvent(line, event);
+            if (ok) timeline.push_back(event);
+        }
+        else ok = false;
+
+        if (!ok) {
+            error = "invalid scenario line: " + raw;
+            return false;
+        }
+    }
+
+    // events at the same time keep the order they were written in
+    stable_sort(timeline.begin(), timeline.end(), [](const Event& a, const Event& b) { return a.at < b.at; });
+    return true;
+}
+
+bool Scenario::load(const string& path, string& error) {
+    ifstream file(path);
+    if (!file.is_open()) {
+        error = "unable to read scenario " + path;
+        return false;
+    }
+
+    stringstream ss;
+    ss << file.rdbuf();
+    return parse(ss.str(), error);
+}
+
+bool Scenario::applyEnvironment(string& error) {
+    if (auto* value = getenv("FAKE_MEETINGSDK_PARTICIPANTS")) {
+        char* end;
+        auto count = strtoul(value, &end, 10);
+        if (*value == '\0' || *end != '\0') {
+            error = string("invalid FAKE_MEETINGSDK_PARTICIPANTS ") + value;
+            return false;
+        }
+        participants = static_cast<unsigned int>(count);
+    }
+
+    if (auto* value = getenv("FAKE_MEETINGSDK_SPEED")) {
+        char* end;
+        auto factor = strtod(value, &end);
+        if (*value == '\0' || *end != '\0' || factor <= 0) {
+            error = string("invalid FAKE_MEETINGSDK_SPEED ") + value;
+            return false;
+        }
+        speed = factor;
+    }
+
+    return true;
+}
@@ -0,0 +1,94 @@
+#ifndef FAKE_MEETINGSDK_SCENARIO_H
+#define FAKE_MEETINGSDK_SCENARIO_H
+
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/**
+ * Script of a simulated meeting, read from the file named by
+ * FAKE_MEETINGSDK_SCENARIO. One directive per line, # starts a comment:
+ *
+ *   auth-delay 0.2                    seconds until authentication returns
+ *   join-delay 0.5                    seconds from Join() until in the meeting
+ *   privilege granted                 raw recording allowed, or denied / on-request
+ *   speed 2                           run the timeline and media twice as fast
+ *   audio voices.pcm 32000 1          PCM fixture, sample rate, channels; - for a tone
+ *   video camera.yuv 640 360 30       I420 fixture, width, height, fps; - for bars
+ *   participants 3 Guest              users present on join besides the bot
+ *
+ * and timeline events, in seconds after the bot joined:
+ *
+ *   at 5 join 42 Jane Doe             user 42 joins
+ *   at 8 rename 42 Jane D.
+ *   at 9 privilege denied             the host changes the recording privilege
+ *   at 10 reminder Recording disclaimer
+ *   at 30 left 42
+ *   at 60 end                         the host ends the meeting
+ */
+struct Scenario {
+    enum Privilege {
+        Granted,
+        Denied,
+        OnRequest
+    };
+
+    struct Event {
+        enum Type {
+            Join,
+            Left,
+            Rename,
+            SetPrivilege,
+            Reminder,
+            End
+        };
+
+        double at;
+        Type type;
+        unsigned int userId;
+        string text;
+        bool granted;
+    };
+
+    double authDelay = 0.2;
+    double joinDelay = 0.5;
+    double speed = 1;
+    Privilege privilege = Granted;
+
+    string audioFile;
+    unsigned int sampleRate = 32000;
+    unsigned int channels = 1;
+
+    string videoFile;
+    unsigned int width = 640;
+    unsigned int height = 360;
+    unsigned int fps = 30;
+
+    unsigned int participants = 1;
+    string prefix = "Participant";
+
+    vector<Event> timeline;
+
+    /**
+     * Parse a scenario, settings not in it keep their defaults
+     * @param error set to the offending line if parsing fails
+     * @return false if a line could not be parsed
+     */
+    bool parse(const string& text, string& error);
+
+    /**
+     * Read and parse a scenario file
+     * @return false if the file could not be read or parsed
+     */
+    bool load(const string& path, string& error);
+
+    /**
+     * Apply FAKE_MEETINGSDK_PARTICIPANTS and FAKE_MEETINGSDK_SPEED
+     * @return false if one of them is not a valid number
+     */
+    bool applyEnvironment(string& error);
+};
+
+
+#endif //FAKE_MEETINGSDK_SCENARIO_H
@@ -0,0 +1,6 @@
+#ifndef FAKE_MEETINGSDK_MEETING_AUDIO_INTERFACE_H
+#define FAKE_MEETINGSDK_MEETING_AUDIO_INTERFACE_H
+
+#include "../zoom_sdk_def.h"
+
+#endif //FAKE_MEETINGSDK_MEETING_AUDIO_INTERFACE_H
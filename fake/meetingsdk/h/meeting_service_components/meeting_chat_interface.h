@@ -0,0 +1,38 @@
+#ifndef FAKE_MEETINGSDK_MEETING_CHAT_INTERFACE_H
+#define FAKE_MEETINGSDK_MEETING_CHAT_INTERFACE_H
+
+#include "../zoom_sdk_def.h"
+
+BEGIN_ZOOM_SDK_NAMESPACE
+
+enum SDKChatMessageType {
+    SDKChatMessageType_To_None,
+    SDKChatMessageType_To_All,
+    SDKChatMessageType_To_Individual_CcPanelist,
+    SDKChatMessageType_To_Individual
+};
+
+class IChatMsgInfo {
+public:
+    virtual ~IChatMsgInfo() {}
+};
+
+class IChatMsgInfoBuilder {
+public:
+    virtual ~IChatMsgInfoBuilder() {}
+    virtual IChatMsgInfoBuilder* SetContent(const zchar_t* content) = 0;
+    virtual IChatMsgInfoBuilder* SetReceiver(unsigned int receiver) = 0;
+    virtual IChatMsgInfoBuilder* SetMessageType(SDKChatMessageType type) = 0;
+    virtual IChatMsgInfo* Build() = 0;
+};
+
+class IMeetingChatController {
+public:
+    virtual ~IMeetingChatController() {}
+    virtual IChatMsgInfoBuilder* GetChatMessageBuilder() = 0;
+    virtual SDKError SendChatMsgTo(IChatMsgInfo* msg) = 0;
+};
+
+END_ZOOM_SDK_NAMESPACE
+
+#endif //FAKE_MEETINGSDK_MEETING_CHAT_INTERFACE_H
@@ -0,0 +1,64 @@
+#ifndef FAKE_MEETINGSDK_MEETING_PARTICIPANTS_CTRL_INTERFACE_H
+#define FAKE_MEETINGSDK_MEETING_PARTICIPANTS_CTRL_INTERFACE_H
+
+#include "../zoom_sdk_def.h"
+
+BEGIN_ZOOM_SDK_NAMESPACE
+
+enum LocalRecordingRequestPrivilegeStatus {
+    LocalRecordingRequestPrivilege_None,
+    LocalRecordingRequestPrivilege_AllowRequest,
+    LocalRecordingRequestPrivilege_AutoGrant,
+    LocalRecordingRequestPrivilege_AutoDeny
+};
+
+enum FocusModeShareType {
+    FocusModeShareType_None,
+    FocusModeShareType_HostOnly,
+    FocusModeShareType_AllParticipants
+};
+
+class IUserInfo {
+public:
+    virtual ~IUserInfo() {}
+    virtual const zchar_t* GetUserName() = 0;
+    virtual unsigned int GetUserID() = 0;
+    virtual bool IsMySelf() = 0;
+};
+
+class IMeetingParticipantsCtrlEvent {
+public:
+    virtual ~IMeetingParticipantsCtrlEvent() {}
+    virtual void onUserJoin(IList<unsigned int>* lstUserID, const zchar_t* strUserList = nullptr) = 0;
+    virtual void onUserLeft(IList<unsigned int>* lstUserID, const zchar_t* strUserList = nullptr) = 0;
+    virtual void onHostChangeNotification(unsigned int userId) = 0;
+    virtual void onLowOrRaiseHandStatusChanged(bool bLow, unsigned int userid) = 0;
+    virtual void onUserNamesChanged(IList<unsigned int>* lstUserID) = 0;
+    virtual void onCoHostChangeNotification(unsigned int userId, bool isCoHost) = 0;
+    virtual void onInvalidReclaimHostkey() = 0;
+    virtual void onAllHandsLowered() = 0;
+    virtual void onLocalRecordingStatusChanged(unsigned int user_id, RecordingStatus status) = 0;
+    virtual void onAllowParticipantsRenameNotification(bool bAllow) = 0;
+    virtual void onAllowParticipantsUnmuteSelfNotification(bool bAllow) = 0;
+    virtual void onAllowParticipantsStartVideoNotification(bool bAllow) = 0;
+    virtual void onAllowParticipantsShareWhiteBoardNotification(bool bAllow) = 0;
+    virtual void onRequestLocalRecordingPrivilegeChanged(LocalRecordingRequestPrivilegeStatus status) = 0;
+    virtual void onAllowParticipantsRequestCloudRecording(bool bAllow) = 0;
+    virtual void onInMeetingUserAvatarPathUpdated(unsigned int userID) = 0;
+    virtual void onParticipantProfilePictureStatusChange(bool bHidden) = 0;
+    virtual void onFocusModeStateChanged(bool bEnabled) = 0;
+    virtual void onFocusModeShareTypeChanged(FocusModeShareType type) = 0;
+};
+
+class IMeetingParticipantsController {
+public:
+    virtual ~IMeetingParticipantsController() {}
+    virtual SDKError SetEvent(IMeetingParticipantsCtrlEvent* pEvent) = 0;
+    virtual IList<unsigned int>* GetParticipantsList() = 0;
+    virtual IUserInfo* GetUserByUserID(unsigned int userid) = 0;
+    virtual IUserInfo* GetMySelfUser() = 0;
+};
+
+END_ZOOM_SDK_NAMESPACE
+
+#endif //FAKE_MEETINGSDK_MEETING_PARTICIPANTS_CTRL_INTERFACE_H
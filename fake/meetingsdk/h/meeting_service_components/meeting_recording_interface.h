@@ -0,0 +1,52 @@
+#ifndef FAKE_MEETINGSDK_MEETING_RECORDING_INTERFACE_H
+#define FAKE_MEETINGSDK_MEETING_RECORDING_INTERFACE_H
+
+#include "../zoom_sdk_def.h"
+
+BEGIN_ZOOM_SDK_NAMESPACE
+
+enum RequestLocalRecordingStatus {
+    RequestLocalRecording_Granted,
+    RequestLocalRecording_Denied,
+    RequestLocalRecording_Timeout
+};
+
+enum RequestStartCloudRecordingStatus {
+    RequestStartCloudRecording_Granted,
+    RequestStartCloudRecording_Denied,
+    RequestStartCloudRecording_Timeout
+};
+
+class IRequestLocalRecordingPrivilegeHandler;
+class IRequestStartCloudRecordingHandler;
+class IRequestEnableAndStartSmartRecordingHandler;
+class ISmartRecordingEnableActionHandler;
+
+class IMeetingRecordingCtrlEvent {
+public:
+    virtual ~IMeetingRecordingCtrlEvent() {}
+    virtual void onRecordingStatus(RecordingStatus status) = 0;
+    virtual void onCloudRecordingStatus(RecordingStatus status) = 0;
+    virtual void onRecordPrivilegeChanged(bool bCanRec) = 0;
+    virtual void onLocalRecordingPrivilegeRequestStatus(RequestLocalRecordingStatus status) = 0;
+    virtual void onLocalRecordingPrivilegeRequested(IRequestLocalRecordingPrivilegeHandler* handler) = 0;
+    virtual void onCloudRecordingStorageFull(time_t gracePeriodDate) = 0;
+    virtual void onRequestCloudRecordingResponse(RequestStartCloudRecordingStatus status) = 0;
+    virtual void onStartCloudRecordingRequested(IRequestStartCloudRecordingHandler* handler) = 0;
+    virtual void onEnableAndStartSmartRecordingRequested(IRequestEnableAndStartSmartRecordingHandler* handler) = 0;
+    virtual void onSmartRecordingEnableActionCallback(ISmartRecordingEnableActionHandler* handler) = 0;
+};
+
+class IMeetingRecordingController {
+public:
+    virtual ~IMeetingRecordingController() {}
+    virtual SDKError SetEvent(IMeetingRecordingCtrlEvent* pEvent) = 0;
+    virtual SDKError CanStartRawRecording() = 0;
+    virtual SDKError StartRawRecording() = 0;
+    virtual SDKError StopRawRecording() = 0;
+    virtual SDKError RequestLocalRecordingPrivilege() = 0;
+};
+
+END_ZOOM_SDK_NAMESPACE
+
+#endif //FAKE_MEETINGSDK_MEETING_RECORDING_INTERFACE_H
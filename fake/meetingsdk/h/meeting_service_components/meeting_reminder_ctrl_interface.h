@@ -0,0 +1,54 @@
+#ifndef FAKE_MEETINGSDK_MEETING_REMINDER_CTRL_INTERFACE_H
+#define FAKE_MEETINGSDK_MEETING_REMINDER_CTRL_INTERFACE_H
+
+#include "../zoom_sdk_def.h"
+
+BEGIN_ZOOM_SDK_NAMESPACE
+
+enum MeetingReminderType {
+    TYPE_LOGIN_REQUIRED,
+    TYPE_START_OR_JOIN_MEETING,
+    TYPE_RECORD_REMINDER,
+    TYPE_RECORD_DISCLAIMER,
+    TYPE_LIVE_STREAM_REMINDER,
+    TYPE_LIVE_STREAM_DISCLAIMER,
+    TYPE_ARCHIVE_REMINDER,
+    TYPE_ARCHIVE_DISCLAIMER,
+    TYPE_WEBINAR_AS_PANELIST_JOIN
+};
+
+class IMeetingReminderContent {
+public:
+    virtual ~IMeetingReminderContent() {}
+    virtual MeetingReminderType GetType() = 0;
+    virtual const zchar_t* GetTitle() = 0;
+    virtual const zchar_t* GetContent() = 0;
+    virtual bool IsBlocking() = 0;
+};
+
+class IMeetingReminderHandler {
+public:
+    virtual ~IMeetingReminderHandler() {}
+    virtual SDKError Accept() = 0;
+    virtual SDKError Decline() = 0;
+    virtual SDKError Ignore() = 0;
+};
+
+class IMeetingEnableReminderHandler;
+
+class IMeetingReminderEvent {
+public:
+    virtual ~IMeetingReminderEvent() {}
+    virtual void onReminderNotify(IMeetingReminderContent* content, IMeetingReminderHandler* handle) = 0;
+    virtual void onEnableReminderNotify(IMeetingReminderContent* content, IMeetingEnableReminderHandler* handle) = 0;
+};
+
+class IMeetingReminderController {
+public:
+    virtual ~IMeetingReminderController() {}
+    virtual SDKError SetEvent(IMeetingReminderEvent* pEvent) = 0;
+};
+
+END_ZOOM_SDK_NAMESPACE
+
+#endif //FAKE_MEETINGSDK_MEETING_REMINDER_CTRL_INTERFACE_H
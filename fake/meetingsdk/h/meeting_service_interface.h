@@ -0,0 +1,103 @@
+#ifndef FAKE_MEETINGSDK_MEETING_SERVICE_INTERFACE_H
+#define FAKE_MEETINGSDK_MEETING_SERVICE_INTERFACE_H
+
+#include "zoom_sdk_def.h"
+#include "meeting_service_components/meeting_chat_interface.h"
+#include "meeting_service_components/meeting_participants_ctrl_interface.h"
+#include "meeting_service_components/meeting_recording_interface.h"
+#include "meeting_service_components/meeting_reminder_ctrl_interface.h"
+
+BEGIN_ZOOM_SDK_NAMESPACE
+
+enum MeetingStatus {
+    MEETING_STATUS_IDLE,
+    MEETING_STATUS_CONNECTING,
+    MEETING_STATUS_WAITINGFORHOST,
+    MEETING_STATUS_INMEETING,
+    MEETING_STATUS_DISCONNECTING,
+    MEETING_STATUS_RECONNECTING,
+    MEETING_STATUS_FAILED,
+    MEETING_STATUS_ENDED
+};
+
+enum StatisticsWarningType {
+    Statistics_Warning_None,
+    Statistics_Warning_Network_Quality_Bad
+};
+
+struct MeetingParameter {
+    uint64_t meeting_number = 0;
+    const zchar_t* meeting_topic = nullptr;
+};
+
+enum LeaveMeetingCmd {
+    LEAVE_MEETING,
+    END_MEETING
+};
+
+enum SDKUserType {
+    SDK_UT_NORMALUSER = 100,
+    SDK_UT_WITHOUT_LOGIN
+};
+
+struct JoinParam4WithoutLogin {
+    uint64_t meetingNumber;
+    const zchar_t* vanityID;
+    const zchar_t* userName;
+    const zchar_t* psw;
+    const zchar_t* app_privilege_token;
+    const zchar_t* userZAK;
+    const zchar_t* customer_key;
+    const zchar_t* webinarToken;
+    bool isVideoOff;
+    bool isAudioOff;
+};
+
+struct JoinParam {
+    SDKUserType userType;
+    union {
+        JoinParam4WithoutLogin withoutloginuserJoin;
+    } param;
+};
+
+struct StartParam4NormalUser {
+    const zchar_t* vanityID;
+    const zchar_t* customer_key;
+    bool isVideoOff;
+    bool isAudioOff;
+};
+
+struct StartParam {
+    SDKUserType userType;
+    union {
+        StartParam4NormalUser normaluserStart;
+    } param;
+};
+
+class IMeetingServiceEvent {
+public:
+    virtual ~IMeetingServiceEvent() {}
+    virtual void onMeetingStatusChanged(MeetingStatus status, int iResult = 0) = 0;
+    virtual void onMeetingStatisticsWarningNotification(StatisticsWarningType type) = 0;
+    virtual void onMeetingParameterNotification(const MeetingParameter* meeting_param) = 0;
+    virtual void onSuspendParticipantsActivities() = 0;
+    virtual void onAICompanionActiveChangeNotice(bool bActive) = 0;
+};
+
+class IMeetingService {
+public:
+    virtual ~IMeetingService() {}
+    virtual SDKError SetEvent(IMeetingServiceEvent* pEvent) = 0;
+    virtual SDKError Join(JoinParam& joinParam) = 0;
+    virtual SDKError Start(StartParam& startParam) = 0;
+    virtual SDKError Leave(LeaveMeetingCmd leaveCmd) = 0;
+    virtual MeetingStatus GetMeetingStatus() = 0;
+    virtual IMeetingRecordingController* GetMeetingRecordingController() = 0;
+    virtual IMeetingParticipantsController* GetMeetingParticipantsController() = 0;
+    virtual IMeetingChatController* GetMeetingChatController() = 0;
+    virtual IMeetingReminderController* GetMeetingReminderController() = 0;
+};
+
+END_ZOOM_SDK_NAMESPACE
+
+#endif //FAKE_MEETINGSDK_MEETING_SERVICE_INTERFACE_H
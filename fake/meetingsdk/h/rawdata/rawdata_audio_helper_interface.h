@@ -0,0 +1,25 @@
+#ifndef FAKE_MEETINGSDK_RAWDATA_AUDIO_HELPER_INTERFACE_H
+#define FAKE_MEETINGSDK_RAWDATA_AUDIO_HELPER_INTERFACE_H
+
+#include "../zoom_sdk_raw_data_def.h"
+
+BEGIN_ZOOM_SDK_NAMESPACE
+
+class IZoomSDKAudioRawDataDelegate {
+public:
+    virtual ~IZoomSDKAudioRawDataDelegate() {}
+    virtual void onMixedAudioRawDataReceived(AudioRawData* data_) = 0;
+    virtual void onOneWayAudioRawDataReceived(AudioRawData* data_, uint32_t node_id) = 0;
+    virtual void onShareAudioRawDataReceived(AudioRawData* data_) = 0;
+};
+
+class IZoomSDKAudioRawDataHelper {
+public:
+    virtual ~IZoomSDKAudioRawDataHelper() {}
+    virtual SDKError subscribe(IZoomSDKAudioRawDataDelegate* pDelegate, bool bWithInterpreters = false) = 0;
+    virtual SDKError unSubscribe() = 0;
+};
+
+END_ZOOM_SDK_NAMESPACE
+
+#endif //FAKE_MEETINGSDK_RAWDATA_AUDIO_HELPER_INTERFACE_H
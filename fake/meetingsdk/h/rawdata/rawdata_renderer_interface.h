@@ -0,0 +1,45 @@
+#ifndef FAKE_MEETINGSDK_RAWDATA_RENDERER_INTERFACE_H
+#define FAKE_MEETINGSDK_RAWDATA_RENDERER_INTERFACE_H
+
+#include "../zoom_sdk_raw_data_def.h"
+
+BEGIN_ZOOM_SDK_NAMESPACE
+
+enum ZoomSDKRawDataType {
+    RAW_DATA_TYPE_VIDEO = 0,
+    RAW_DATA_TYPE_SHARE
+};
+
+enum ZoomSDKResolution {
+    ZoomSDKResolution_90P,
+    ZoomSDKResolution_180P,
+    ZoomSDKResolution_360P,
+    ZoomSDKResolution_720P,
+    ZoomSDKResolution_1080P,
+    ZoomSDKResolution_NoUse = 100
+};
+
+class IZoomSDKRendererDelegate {
+public:
+    enum RawDataStatus {
+        RawData_On,
+        RawData_Off
+    };
+
+    virtual ~IZoomSDKRendererDelegate() {}
+    virtual void onRawDataFrameReceived(YUVRawDataI420* data) = 0;
+    virtual void onRawDataStatusChanged(RawDataStatus status) = 0;
+    virtual void onRendererBeDestroyed() = 0;
+};
+
+class IZoomSDKRenderer {
+public:
+    virtual ~IZoomSDKRenderer() {}
+    virtual SDKError setRawDataResolution(ZoomSDKResolution resolution) = 0;
+    virtual SDKError subscribe(uint32_t subscribeId, ZoomSDKRawDataType type) = 0;
+    virtual SDKError unSubscribe() = 0;
+};
+
+END_ZOOM_SDK_NAMESPACE
+
+#endif //FAKE_MEETINGSDK_RAWDATA_RENDERER_INTERFACE_H
@@ -0,0 +1,16 @@
+#ifndef FAKE_MEETINGSDK_ZOOM_RAWDATA_API_H
+#define FAKE_MEETINGSDK_ZOOM_RAWDATA_API_H
+
+#include "rawdata_audio_helper_interface.h"
+#include "rawdata_renderer_interface.h"
+
+BEGIN_ZOOM_SDK_NAMESPACE
+
+SDKError createRenderer(IZoomSDKRenderer** ppRenderer, IZoomSDKRendererDelegate* pDelegate);
+SDKError destroyRenderer(IZoomSDKRenderer* pRenderer);
+
+IZoomSDKAudioRawDataHelper* GetAudioRawdataHelper();
+
+END_ZOOM_SDK_NAMESPACE
+
+#endif //FAKE_MEETINGSDK_ZOOM_RAWDATA_API_H
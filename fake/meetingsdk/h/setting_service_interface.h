@@ -0,0 +1,22 @@
+#ifndef FAKE_MEETINGSDK_SETTING_SERVICE_INTERFACE_H
+#define FAKE_MEETINGSDK_SETTING_SERVICE_INTERFACE_H
+
+#include "zoom_sdk_def.h"
+
+BEGIN_ZOOM_SDK_NAMESPACE
+
+class IAudioSettingContext {
+public:
+    virtual ~IAudioSettingContext() {}
+    virtual SDKError EnableAutoJoinAudio(bool bEnable) = 0;
+};
+
+class ISettingService {
+public:
+    virtual ~ISettingService() {}
+    virtual IAudioSettingContext* GetAudioSettings() = 0;
+};
+
+END_ZOOM_SDK_NAMESPACE
+
+#endif //FAKE_MEETINGSDK_SETTING_SERVICE_INTERFACE_H
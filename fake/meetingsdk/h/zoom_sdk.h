@@ -0,0 +1,34 @@
+#ifndef FAKE_MEETINGSDK_ZOOM_SDK_H
+#define FAKE_MEETINGSDK_ZOOM_SDK_H
+
+#include "zoom_sdk_def.h"
+
+BEGIN_ZOOM_SDK_NAMESPACE
+
+class IMeetingService;
+class ISettingService;
+class IAuthService;
+
+struct InitParam {
+    const zchar_t* strWebDomain = nullptr;
+    const zchar_t* strSupportUrl = nullptr;
+    SDK_LANGUAGE_ID emLanguageID = LANGUAGE_Unknown;
+    bool enableLogByDefault = false;
+    bool enableGenerateDump = false;
+};
+
+SDKError InitSDK(InitParam& initParam);
+SDKError CleanUPSDK();
+
+SDKError CreateMeetingService(IMeetingService** ppMeetingService);
+SDKError DestroyMeetingService(IMeetingService* pMeetingService);
+
+SDKError CreateSettingService(ISettingService** ppSettingService);
+SDKError DestroySettingService(ISettingService* pSettingService);
+
+SDKError CreateAuthService(IAuthService** ppAuthService);
+SDKError DestroyAuthService(IAuthService* pAuthService);
+
+END_ZOOM_SDK_NAMESPACE
+
+#endif //FAKE_MEETINGSDK_ZOOM_SDK_H
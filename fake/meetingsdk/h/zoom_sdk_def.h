@@ -0,0 +1,64 @@
+#ifndef FAKE_MEETINGSDK_ZOOM_SDK_DEF_H
+#define FAKE_MEETINGSDK_ZOOM_SDK_DEF_H
+
+/**
+ * Subset of the Meeting SDK headers the bot uses, implemented by the
+ * fake_meetingsdk library so the bot builds and runs without the SDK.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+
+#define ZOOM_SDK_NAMESPACE ZOOMSDK
+#define BEGIN_ZOOM_SDK_NAMESPACE namespace ZOOM_SDK_NAMESPACE {
+#define END_ZOOM_SDK_NAMESPACE }
+
+typedef char zchar_t;
+
+BEGIN_ZOOM_SDK_NAMESPACE
+
+enum SDKError {
+    SDKERR_SUCCESS = 0,
+    SDKERR_NO_IMPL,
+    SDKERR_WRONG_USAGE,
+    SDKERR_INVALID_PARAMETER,
+    SDKERR_MODULE_LOAD_FAILED,
+    SDKERR_MEMORY_FAILED,
+    SDKERR_SERVICE_FAILED,
+    SDKERR_UNINITIALIZE,
+    SDKERR_UNAUTHENTICATION,
+    SDKERR_NORECORDINGINPROCESS,
+    SDKERR_TRANSCODER_NOFOUND,
+    SDKERR_VIDEO_NOTREADY,
+    SDKERR_NO_PERMISSION,
+    SDKERR_UNKNOWN,
+    SDKERR_OTHER_SDK_INSTANCE_RUNNING,
+    SDKERR_INTERNAL_ERROR
+};
+
+enum SDK_LANGUAGE_ID {
+    LANGUAGE_Unknown = 0,
+    LANGUAGE_English
+};
+
+enum RecordingStatus {
+    Recording_Start,
+    Recording_Stop,
+    Recording_DiskFull,
+    Recording_Pause,
+    Recording_Connecting,
+    Recording_Fail
+};
+
+template<class T>
+class IList {
+public:
+    virtual ~IList() {}
+    virtual int GetCount() = 0;
+    virtual T GetItem(int index) = 0;
+};
+
+END_ZOOM_SDK_NAMESPACE
+
+#endif //FAKE_MEETINGSDK_ZOOM_SDK_DEF_H
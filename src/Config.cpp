@@ -22,6 +22,42 @@ Config::Config() :
 
     m_app.add_flag("-s, --start", m_isMeetingStart, "Start a Zoom Meeting");
 
+    m_app.add_option("--consent-url", m_consentUrl, "URL of the recording consent API")->capture_default_str();
+    m_app.add_option("--consent-timeout", m_consentTimeout, "Timeout for a consent API request in milliseconds")->capture_default_str();
+    m_app.add_option("--consent-retries", m_consentRetries, "Retries for a failed consent API request")->capture_default_str();
+    m_app.add_option("--consent-poll-interval", m_consentPollInterval, "Seconds between consent API polls")->capture_default_str();
+    m_app.add_option("--consent-reconcile-interval", m_consentReconcileInterval, "Seconds between consent API polls when the webhook is enabled")->capture_default_str();
+
+    m_app.add_option("--webhook-host", m_webhookHost, "Address the consent webhook listens on")->capture_default_str();
+    m_app.add_option("--webhook-port", m_webhookPort, "Port for consent change webhooks, 0 to disable");
+    m_app.add_option("--webhook-secret", m_webhookSecret, "Bearer token the consent webhook requires, the webhook is disabled without it")->envname("ZOOMSDK_WEBHOOK_SECRET");
+
+    m_app.add_flag("--selective-recording", m_selectiveRecording, "Record audio and video only of participants who consented");
+    m_app.add_option("--audit-file", m_auditFile, "File that purges of revoked recordings are logged to")->capture_default_str();
+
+    m_app.add_option("--chat-rate", m_chatRate, "Chat messages sent per second")->capture_default_str();
+    m_app.add_option("--chat-burst", m_chatBurst, "Chat messages that may be sent back to back")->capture_default_str();
+    m_app.add_option("--chat-max-length", m_chatMaxLength, "Longest chat message, longer lists are split")->capture_default_str();
+
+    m_app.add_option("--consent-link", m_consentLink, "Link to the consent form sent to participants")->capture_default_str();
+    m_app.add_flag("--private-reminders", m_privateReminders, "Remind each participant without consent in a private chat");
+    m_app.add_option("--reminder-interval", m_reminderInterval, "Minimum seconds between reminders to the same participant")->capture_default_str();
+
+    m_app.add_option("--journal-dir", m_journalDir, "Directory for the per meeting consent journal, empty to disable")->capture_default_str();
+
+    m_app.add_option("--breaker-failures", m_breakerFailures, "Consecutive consent API failures that stop polling it")->capture_default_str();
+    m_app.add_option("--breaker-cooldown", m_breakerCooldown, "Seconds before polling a failing consent API again")->capture_default_str();
+    m_app.add_option("--consent-staleness", m_consentStaleness, "Seconds the last consent snapshot may be used while the API is down")->capture_default_str();
+
+    m_app.add_option("--shutdown-timeout", m_shutdownTimeout, "Milliseconds shutdown may spend flushing recordings to disk")->capture_default_str();
+
+    m_app.add_option("--stats", m_statsName, "Shared memory stats segment read by zoomsdk-stat, /zoomsdk-<pid> by default");
+
+    m_app.add_option("--metrics-host", m_metricsHost, "Address the Prometheus metrics endpoint listens on")->capture_default_str();
+    m_app.add_option("--metrics-port", m_metricsPort, "Port serving Prometheus metrics on /metrics, 0 to disable");
+    m_app.add_option("--trace-file", m_traceFile, "Record a Chrome trace of the bot, written to this file at exit and on SIGUSR1");
+    m_app.add_option("--latency-report-interval", m_latencyReportInterval, "Seconds between logged callback latency percentiles, 0 to only log them at exit")->capture_default_str();
+
     m_rawRecordAudioCmd->add_option("-f, --file", m_audioFile, "Output PCM audio file")->required();
     m_rawRecordAudioCmd->add_option("-d, --dir", m_audioDir, "Audio Output Directory");
     m_rawRecordAudioCmd->add_flag("-s, --separate-participants", m_separateParticipantAudio, "Output to separate PCM files for each participant");
@@ -150,3 +186,110 @@ const string& Config::zoomHost() const {
     return m_zoomHost;
 }
 
+const string& Config::consentUrl() const {
+    return m_consentUrl;
+}
+
+int Config::consentTimeout() const {
+    return m_consentTimeout;
+}
+
+int Config::consentRetries() const {
+    return m_consentRetries;
+}
+
+int Config::consentPollInterval() const {
+    return m_consentPollInterval;
+}
+
+int Config::consentReconcileInterval() const {
+    return m_consentReconcileInterval;
+}
+
+const string& Config::webhookHost() const {
+    return m_webhookHost;
+}
+
+int Config::webhookPort() const {
+    return m_webhookPort;
+}
+
+const string& Config::webhookSecret() const {
+    return m_webhookSecret;
+}
+
+bool Config::useWebhook() const {
+    return m_webhookPort > 0;
+}
+
+bool Config::selectiveRecording() const {
+    return m_selectiveRecording;
+}
+
+const string& Config::auditFile() const {
+    return m_auditFile;
+}
+
+double Config::chatRate() const {
+    return m_chatRate;
+}
+
+int Config::chatBurst() const {
+    return m_chatBurst;
+}
+
+int Config::chatMaxLength() const {
+    return m_chatMaxLength;
+}
+
+const string& Config::consentLink() const {
+    return m_consentLink;
+}
+
+bool Config::privateReminders() const {
+    return m_privateReminders;
+}
+
+int Config::reminderInterval() const {
+    return m_reminderInterval;
+}
+
+const string& Config::journalDir() const {
+    return m_journalDir;
+}
+
+int Config::breakerFailures() const {
+    return m_breakerFailures;
+}
+
+int Config::breakerCooldown() const {
+    return m_breakerCooldown;
+}
+
+int Config::consentStaleness() const {
+    return m_consentStaleness;
+}
+
+int Config::shutdownTimeout() const {
+    return m_shutdownTimeout;
+}
+
+const string& Config::statsName() const {
+    return m_statsName;
+}
+
+const string& Config::metricsHost() const {
+    return m_metricsHost;
+}
+
+int Config::metricsPort() const {
+    return m_metricsPort;
+}
+
+int Config::latencyReportInterval() const {
+    return m_latencyReportInterval;
+}
+
+const string& Config::traceFile() const {
+    return m_traceFile;
+}
@@ -47,6 +47,43 @@ class Config {
 
     bool m_isMeetingStart;
 
+    string m_consentUrl = "http://localhost:5000/consent";
+    int m_consentTimeout = 5000;
+    int m_consentRetries = 3;
+    int m_consentPollInterval = 2;
+    int m_consentReconcileInterval = 60;
+
+    string m_webhookHost = "127.0.0.1";
+    int m_webhookPort = 0;
+    string m_webhookSecret;
+
+    bool m_selectiveRecording = false;
+    string m_auditFile = "out/consent-audit.jsonl";
+
+    double m_chatRate = 1;
+    int m_chatBurst = 5;
+    int m_chatMaxLength = 1000;
+
+    string m_consentLink = "https://testui.identifai.info/consent-form?bot_id=25aad7b0-a6a5-4c1e-b379-e44eb85e1bc7";
+    bool m_privateReminders = false;
+    int m_reminderInterval = 120;
+
+    string m_journalDir = "out";
+
+    int m_breakerFailures = 5;
+    int m_breakerCooldown = 30;
+    int m_consentStaleness = 300;
+
+    int m_shutdownTimeout = 5000;
+
+    string m_statsName;
+
+    string m_metricsHost = "127.0.0.1";
+    int m_metricsPort = 0;
+    int m_latencyReportInterval = 60;
+
+    string m_traceFile;
+
 
 public:
     Config();
@@ -82,6 +119,44 @@ public:
     const string& videoDir() const;
 
     bool separateParticipantAudio() const;
+
+    const string& consentUrl() const;
+    int consentTimeout() const;
+    int consentRetries() const;
+    int consentPollInterval() const;
+    int consentReconcileInterval() const;
+
+    const string& webhookHost() const;
+    int webhookPort() const;
+    const string& webhookSecret() const;
+    bool useWebhook() const;
+
+    bool selectiveRecording() const;
+    const string& auditFile() const;
+
+    double chatRate() const;
+    int chatBurst() const;
+    int chatMaxLength() const;
+
+    const string& consentLink() const;
+    bool privateReminders() const;
+    int reminderInterval() const;
+
+    const string& journalDir() const;
+
+    int breakerFailures() const;
+    int breakerCooldown() const;
+    int consentStaleness() const;
+
+    int shutdownTimeout() const;
+
+    const string& statsName() const;
+
+    const string& metricsHost() const;
+    int metricsPort() const;
+    int latencyReportInterval() const;
+
+    const string& traceFile() const;
 };
 
 
@@ -1,19 +1,30 @@
 #include "Zoom.h"
-#include <future> 
-#include <thread> 
-#include <json/json.h>
+#include <glib.h>
+#include <algorithm>
+#include <filesystem>
+#include <future>
+
+#include <fcntl.h>
+#include <unistd.h>
 
 SDKError Zoom::config(int ac, char** av) {
+    m_configAt = Tracer::Clock::now();
+
     auto status = m_config.read(ac, av);
     if (status) {
         Log::error("failed to read configuration");
         return SDKERR_INTERNAL_ERROR;
     }
 
+    // only now known whether to trace, config itself is recorded after the fact
+    Tracer::enable(!m_config.traceFile().empty());
+    Tracer::complete("config", "lifecycle", m_configAt);
+
     return SDKERR_SUCCESS;
 }
 
 SDKError Zoom::init() {
+    Tracer::Scope scope("init", "lifecycle");
     InitParam initParam;
 
     auto host = m_config.zoomHost().c_str();
@@ -26,12 +37,25 @@ SDKError Zoom::init() {
     initParam.enableLogByDefault = true;
     initParam.enableGenerateDump = true;
 
+    auto initAt = Tracer::Clock::now();
     auto err = InitSDK(initParam);
+    Tracer::complete("InitSDK", "sdk", initAt);
+
     if (hasError(err)) {
         Log::error("InitSDK failed");
         return err;
     }
 
+    attachStats();
+    serveMetrics();
+
+    m_consent.setStats(m_statsSlot);
+    m_consent.setMetrics(&m_metrics);
+
+    // also logged at exit, percentiles are since the start
+    if (m_config.latencyReportInterval() > 0)
+        m_timers.every(chrono::seconds(m_config.latencyReportInterval()), [this]() { reportLatency(); });
+
     return createServices();
 }
 
@@ -44,6 +68,7 @@ SDKError Zoom::createServices() {
 
     auto meetingServiceEvent = new MeetingServiceEvent();
     meetingServiceEvent->setOnMeetingJoin(onJoin);
+    meetingServiceEvent->setOnMeetingEnd(onEnd);
 
     err = m_meetingService->SetEvent(meetingServiceEvent);
     if (hasError(err)) return err;
@@ -52,6 +77,7 @@ SDKError Zoom::createServices() {
 }
 
 SDKError Zoom::auth() {
+    Tracer::Scope scope("auth", "lifecycle");
     SDKError err{SDKERR_UNINITIALIZE};
 
     auto id = m_config.clientId();
@@ -75,6 +101,7 @@ SDKError Zoom::auth() {
     AuthContext ctx;
     ctx.jwt_token =  m_jwt.c_str();
 
+    m_authAt = Tracer::Clock::now();
     return m_authService->SDKAuth(ctx);
 }
 
@@ -92,6 +119,7 @@ void Zoom::generateJWT(const string& key, const string& secret) {
 }
 
 SDKError Zoom::join() {
+    Tracer::Scope scope("join", "lifecycle");
     SDKError err{SDKERR_UNINITIALIZE};
 
     auto mid = m_config.meetingId();
@@ -148,6 +176,7 @@ SDKError Zoom::join() {
         audioSettings->EnableAutoJoinAudio(true);
     }
 
+    m_joinAt = Tracer::Clock::now();
     return m_meetingService->Join(joinParam);
 }
 
@@ -163,6 +192,7 @@ SDKError Zoom::start() {
     normalUser.isAudioOff = true;
     normalUser.isVideoOff = true;
 
+    m_joinAt = Tracer::Clock::now();
     err = m_meetingService->Start(startParam);
     hasError(err, "start meeting");
 
@@ -181,6 +211,15 @@ SDKError Zoom::leave() {
 }
 
 SDKError Zoom::clean() {
+    // runs again atexit() after a signal already shut down
+    if (m_cleaned)
+        return SDKERR_SUCCESS;
+
+    m_cleaned = true;
+
+    reportLatency();
+    writeTrace();
+
     if (m_meetingService)
         DestroyMeetingService(m_meetingService);
 
@@ -196,53 +235,238 @@ SDKError Zoom::clean() {
     if (m_videoHelper)
         m_videoHelper->unSubscribe();
 
+    while (!m_userVideo.empty())
+        unsubscribeUserVideo(m_userVideo.begin()->first);
+
     delete m_videoSource;
 
     return CleanUPSDK();
 }
 
-SDKError Zoom::sendConsentRequest(IMeetingChatController* chatCtrl) {
-    if (!chatCtrl) {
-        return SDKERR_UNINITIALIZE;
+void Zoom::shutdown() {
+    Tracer::Scope scope("shutdown", "lifecycle");
+    auto deadline = chrono::steady_clock::now() + chrono::milliseconds(m_config.shutdownTimeout());
+    Log::info("shutting down");
+
+    // refuse new frames first, then stop the SDK from delivering them
+    auto counters = frameCounters();
+    for (auto* frames : counters)
+        frames->stop();
+
+    if (m_audioHelper) {
+        m_audioHelper->unSubscribe();
+        m_audioHelper = nullptr;
     }
 
-    // Build the chat message
-    IChatMsgInfoBuilder* msgBuilder = chatCtrl->GetChatMessageBuilder();
-    if (!msgBuilder) {
-        return SDKERR_UNINITIALIZE;
+    if (m_videoHelper) {
+        m_videoHelper->unSubscribe();
+        m_videoHelper = nullptr;
     }
 
-    const char* consentMessage = "We would like to record this meeting. Please provide your consent by visiting the following link: https://testui.identifai.info/consent-form?bot_id=25aad7b0-a6a5-4c1e-b379-e44eb85e1bc7";
-    msgBuilder->SetContent(consentMessage)->SetReceiver(0)->SetMessageType(SDKChatMessageType_To_All);
-    IChatMsgInfo* chatMsg = msgBuilder->Build();
-    if (!chatMsg) {
-        return SDKERR_UNINITIALIZE;
+    // the delegates stay alive until clean(), a callback may still be running
+    for (const auto& entry : m_userVideo)
+        entry.second.first->unSubscribe();
+
+    if (m_consent.recording())
+        stopRawRecording();
+
+    // let callbacks that got in before stop() finish their write
+    auto idle = [&counters]() {
+        return all_of(counters.begin(), counters.end(), [](FrameCounter* frames) { return frames->idle(); });
+    };
+
+    while (!idle() && chrono::steady_clock::now() < deadline)
+        this_thread::sleep_for(chrono::milliseconds(1));
+
+    if (!idle())
+        Log::error("capture callbacks still writing at the shutdown deadline");
+
+    // revoked media is purged before the recordings are made durable
+    m_purger.drain();
+    m_consent.close();
+
+    auto synced = syncRecordings(deadline);
+
+    uint64_t written = 0, dropped = 0;
+    for (auto* frames : counters) {
+        written += frames->written();
+        dropped += frames->dropped();
     }
 
-    // Send the chat message
-    SDKError err = chatCtrl->SendChatMsgTo(chatMsg);
-    if (err != SDKERR_SUCCESS) {
-        return err;
+    stringstream ss;
+    ss << "shutdown " << (synced ? "flushed " : "wrote but did not flush ") << written << " frames, dropped " << dropped;
+
+    if (synced) Log::success(ss.str());
+    else Log::error(ss.str());
+
+    if (m_statsSlot)
+        publishStats();
+}
+
+vector<FrameCounter*> Zoom::frameCounters() const {
+    vector<FrameCounter*> counters;
+    if (m_audioSource) counters.push_back(&m_audioSource->frames());
+    if (m_videoSource) counters.push_back(&m_videoSource->frames());
+    for (const auto& entry : m_userVideo)
+        counters.push_back(&entry.second.second->frames());
+
+    return counters;
+}
+
+void Zoom::attachStats() {
+    // set by the supervisor for the workers it starts
+    auto* name = getenv("ZOOMSDK_STATS");
+    auto* index = getenv("ZOOMSDK_WORKER");
+
+    if (name && index) {
+        if (!m_stats.attach(name)) return;
+
+        m_supervised = true;
+        m_statsSlot = m_stats.slot(static_cast<uint32_t>(strtoul(index, nullptr, 10)));
+        if (!m_statsSlot) {
+            Log::error(string("stats segment has no slot for worker ") + index);
+            return;
+        }
+    } else {
+        auto own = m_config.statsName().empty() ? "/zoomsdk-" + to_string(getpid()) : m_config.statsName();
+        if (!m_stats.create(own, 1)) return;
+
+        m_statsSlot = m_stats.slot(0);
+        m_statsSlot->pid.store(getpid(), memory_order_relaxed);
+        m_statsSlot->startedAt.store(StatsSegment::now(), memory_order_relaxed);
+        m_statsSlot->state.store(StatsSegment::Running, memory_order_relaxed);
+
+        Log::info("publishing stats to " + own);
     }
 
-    Log::info("Consent request sent successfully");
-    return SDKERR_SUCCESS;
+    publishStats();
+    m_timers.every(chrono::seconds(1), [this]() { publishStats(); });
+}
+
+void Zoom::serveMetrics() {
+    if (m_config.metricsPort() <= 0) return;
+
+    m_metrics.setStats(m_statsSlot);
+    m_metrics.addBreaker("consent_api", &m_consent.breaker());
+
+    m_metricsListener.route("GET", "/metrics", [this](const HttpListener::Request&, HttpListener::Response& res) {
+        res.contentType = "text/plain; version=0.0.4";
+        res.body = m_metrics.scrape();
+    });
+
+    if (Tracer::enabled()) {
+        m_metricsListener.route("GET", "/trace", [](const HttpListener::Request&, HttpListener::Response& res) {
+            res.body = Tracer::json();
+        });
+    }
+
+    if (m_metricsListener.listen(m_config.metricsHost(), m_config.metricsPort()))
+        Log::success("serving metrics on port " + to_string(m_config.metricsPort()));
+}
+
+void Zoom::writeTrace() {
+    if (m_config.traceFile().empty()) return;
+
+    auto spans = Tracer::write(m_config.traceFile());
+    if (spans < 0)
+        return Log::error("failed to write trace to " + m_config.traceFile());
+
+    Log::success("wrote " + to_string(spans) + " spans to " + m_config.traceFile());
 }
 
+void Zoom::reportLatency() {
+    for (const auto& line : m_metrics.summary())
+        Log::info(line);
+}
+
+void Zoom::publishStats() {
+    // queue depths are sampled, everything else is counted where it happens
+    m_statsSlot->set(StatsSegment::ExecutorQueue, m_executor.pending());
+    m_statsSlot->set(StatsSegment::ChatQueue, m_chat.pending());
+    m_statsSlot->set(StatsSegment::PurgeQueue, m_purger.pending());
+
+    // doubles as the heartbeat, it stops when the main loop hangs
+    m_statsSlot->heartbeat.value.store(StatsSegment::now(), memory_order_relaxed);
+}
+
+void Zoom::count(StatsSegment::Stat stat, uint64_t n) {
+    if (m_statsSlot) m_statsSlot->add(stat, n);
+}
+
+void Zoom::onMeetingEnd() {
+    // a supervised worker exits so its slot can take the next meeting
+    if (!m_supervised) return;
+
+    shutdown();
+    exit(0);
+}
+
+bool Zoom::syncRecordings(chrono::steady_clock::time_point deadline) {
+    Tracer::Scope scope("syncRecordings", "lifecycle");
+    vector<string> dirs;
+    if (m_config.useRawAudio()) dirs.push_back(m_config.audioDir());
+    if (m_config.useRawVideo() && m_config.videoDir() != m_config.audioDir()) dirs.push_back(m_config.videoDir());
+
+    vector<string> paths;
+    for (const auto& dir : dirs) {
+        error_code ec;
+        for (const auto& entry : filesystem::directory_iterator(dir, ec)) {
+            auto extension = entry.path().extension();
+            if (entry.is_regular_file(ec) && (extension == ".pcm" || extension == ".yuv"))
+                paths.push_back(entry.path().string());
+        }
+
+        // the directory entries of new recordings must be durable too
+        paths.push_back(dir);
+    }
+
+    if (paths.empty())
+        return true;
+
+    // fsync can block on a slow disk, it runs aside so the deadline holds
+    auto done = make_shared<promise<int>>();
+    auto failures = done->get_future();
+
+    thread([paths, done]() {
+        int errors = 0;
+        for (const auto& path : paths) {
+            int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd < 0 || fsync(fd) < 0) ++errors;
+            if (fd >= 0) close(fd);
+        }
+        done->set_value(errors);
+    }).detach();
+
+    if (failures.wait_until(deadline) != future_status::ready) {
+        Log::error("recordings were not synced to disk before the shutdown deadline");
+        return false;
+    }
+
+    auto errors = failures.get();
+    if (errors)
+        Log::error("failed to sync " + to_string(errors) + " of " + to_string(paths.size()) + " recordings");
+
+    return errors == 0;
+}
 
 SDKError Zoom::startRawRecording() {
+    Tracer::Scope scope("startRawRecording", "lifecycle");
 
     auto recCtrl = m_meetingService->GetMeetingRecordingController();
 
     SDKError err = recCtrl->CanStartRawRecording();
     if (hasError(err)) {
+        // asked once, the privilege callback retries the start when the host grants it
+        if (m_privilegeRequested) return err;
+        m_privilegeRequested = true;
+
+        // paced and deduplicated with the reminders
         Log::info("requesting local recording privilege");
-        auto chatCtrl = m_meetingService->GetMeetingChatController();
-        err = sendConsentRequest(chatCtrl);
-        if (hasError(err, "send consent request")) {
-            return err;
-        }
-        return recCtrl->RequestLocalRecordingPrivilege();
+        m_chat.post(0, "We would like to record this meeting. Please provide your consent by visiting the following link: " + m_config.consentLink());
+
+        // not recording yet, the privilege callback starts it once granted
+        hasError(recCtrl->RequestLocalRecordingPrivilege(), "request local recording privilege");
+        return err;
     }
 
     err = recCtrl->StartRawRecording();
@@ -250,13 +474,26 @@ SDKError Zoom::startRawRecording() {
         return err;
     }
 
-    if (m_config.useRawVideo()) {
-        if (!m_videoSource)
+    if (m_config.useRawVideo() && m_config.selectiveRecording()) {
+        // one renderer per participant, the gate drops frames of those without consent
+        auto bot = self();
+        for (const auto& entry : m_consent.participants()) {
+            if (entry.first != bot)
+                subscribeUserVideo(entry.first);
+        }
+    } else if (m_config.useRawVideo()) {
+        if (!m_videoSource) {
             m_videoSource = new ZoomSDKRendererDelegate();
+            m_videoSource->setStats(m_statsSlot);
+            m_videoSource->setMetrics(&m_metrics);
+        }
 
-        err = createRenderer(&m_videoHelper, m_videoSource);
-        if (hasError(err, "create raw video renderer")) {
-            return err;
+        // kept across a retried start, a second renderer would leak the first
+        if (!m_videoHelper) {
+            err = createRenderer(&m_videoHelper, m_videoSource);
+            if (hasError(err, "create raw video renderer")) {
+                return err;
+            }
         }
 
         m_videoSource->setDir(m_config.videoDir());
@@ -279,9 +516,20 @@ SDKError Zoom::startRawRecording() {
         }
 
         if (!m_audioSource) {
-            m_audioSource = new ZoomSDKAudioRawDataDelegate(!m_config.separateParticipantAudio());
+            // selective recording needs one-way audio to tell participants apart
+            auto separate = m_config.separateParticipantAudio() || m_config.selectiveRecording();
+
+            m_audioSource = new ZoomSDKAudioRawDataDelegate(!separate);
             m_audioSource->setDir(m_config.audioDir());
             m_audioSource->setFilename(m_config.audioFile());
+            m_audioSource->setStats(m_statsSlot);
+            m_audioSource->setMetrics(&m_metrics);
+
+            if (m_config.selectiveRecording()) {
+                m_audioSource->setGate(&m_consent.gate());
+                m_audioSource->setLedger(&m_segments);
+                m_purger.watch(&m_audioSource->frames());
+            }
         }
 
         err = m_audioHelper->subscribe(m_audioSource);
@@ -290,9 +538,64 @@ SDKError Zoom::startRawRecording() {
         }
     }
 
+    // the critical path of the first recording, from the command line to frames
+    if (m_joinedAt != Tracer::Clock::time_point()) {
+        Tracer::async("waiting for consent", "lifecycle", m_joinedAt);
+        Tracer::async("startup", "lifecycle", m_configAt);
+        m_joinedAt = Tracer::Clock::time_point();
+    }
+
+    return SDKERR_SUCCESS;
+}
+
+SDKError Zoom::subscribeUserVideo(unsigned int userId) {
+    if (m_userVideo.count(userId))
+        return SDKERR_SUCCESS;
+
+    stringstream filename;
+    filename << "node-" << userId << ".yuv";
+
+    auto* source = new ZoomSDKRendererDelegate();
+    source->setDir(m_config.videoDir());
+    source->setFilename(filename.str());
+    source->setGate(&m_consent.gate());
+    source->setLedger(&m_segments);
+    source->setStats(m_statsSlot);
+    source->setMetrics(&m_metrics);
+
+    IZoomSDKRenderer* renderer;
+    auto err = createRenderer(&renderer, source);
+    if (hasError(err, "create raw video renderer")) {
+        delete source;
+        return err;
+    }
+
+    renderer->setRawDataResolution(ZoomSDKResolution_720P);
+    err = renderer->subscribe(userId, RAW_DATA_TYPE_VIDEO);
+    if (hasError(err, "subscribe to raw video")) {
+        destroyRenderer(renderer);
+        delete source;
+        return err;
+    }
+
+    m_purger.watch(&source->frames());
+    m_userVideo[userId] = {renderer, source};
+
     return SDKERR_SUCCESS;
 }
 
+void Zoom::unsubscribeUserVideo(unsigned int userId) {
+    auto it = m_userVideo.find(userId);
+    if (it == m_userVideo.end()) return;
+
+    it->second.first->unSubscribe();
+    destroyRenderer(it->second.first);
+    m_purger.unwatch(&it->second.second->frames());
+    delete it->second.second;
+
+    m_userVideo.erase(it);
+}
+
 SDKError Zoom::stopRawRecording() {
     auto recCtrl = m_meetingService->GetMeetingRecordingController();
     auto err = recCtrl->StopRawRecording();
@@ -320,125 +623,120 @@ bool Zoom::hasError(const SDKError e, const string& action) {
     return isError;
 }
 
-// Method to fetch participants
-void Zoom::fetchParticipants() {
-    auto* participantsController = m_meetingService->GetMeetingParticipantsController();
-    if (!participantsController) return;
+// Copy the IDs out of an SDK list, it is only valid during the callback
+static vector<unsigned int> copyUserIds(IList<unsigned int>* userIds) {
+    vector<unsigned int> ids;
+    ids.reserve(userIds->GetCount());
 
-    auto participantsList = participantsController->GetParticipantsList();
-    if (!participantsList) return;
-
-    participants.clear();
-    for (int i = 0; i < participantsList->GetCount(); ++i) {
-        unsigned int userId = participantsList->GetItem(i);
-        if (userId) {
-            IUserInfo* userInfo = participantsController->GetUserByUserID(userId);
-            if (userInfo) {
-                std::string userName = userInfo->GetUserName();
-                participants.insert(userName);
-            }
-        }
+    for (int i = 0; i < userIds->GetCount(); ++i)
+        ids.push_back(userIds->GetItem(i));
+
+    return ids;
+}
+
+void Zoom::onMeetingJoin() {
+    Tracer::Scope scope("onMeetingJoin", "lifecycle");
+    auto* reminderController = m_meetingService->GetMeetingReminderController();
+    reminderController->SetEvent(new MeetingReminderEvent());
+
+    m_chat.setSender([this](unsigned int receiver, const string& text) {
+        return sendMessage(text, receiver);
+    });
+    m_chat.setRate(m_config.chatRate(), m_config.chatBurst());
+    m_chat.setMaxLength(m_config.chatMaxLength());
+
+    auto* participantsCtrl = m_meetingService->GetMeetingParticipantsController();
+    if (participantsCtrl) {
+        auto participantsEvent = new MeetingParticipantsCtrlEvent();
+        participantsEvent->setOnUserJoin([this](IList<unsigned int>* ids) {
+            m_executor.post([this, userIds = copyUserIds(ids)]() { m_consent.onUserJoin(userIds); });
+        });
+        participantsEvent->setOnUserLeft([this](IList<unsigned int>* ids) {
+            m_executor.post([this, userIds = copyUserIds(ids)]() { m_consent.onUserLeft(userIds); });
+        });
+        participantsEvent->setOnUserNamesChanged([this](IList<unsigned int>* ids) {
+            m_executor.post([this, userIds = copyUserIds(ids)]() { m_consent.onUserNamesChanged(userIds); });
+        });
+        participantsCtrl->SetEvent(participantsEvent);
+    }
+
+    // take the initial snapshot, the event above keeps it current
+    m_consent.fetchParticipants();
+
+    if (m_config.useRawRecording()) {
+        auto recordingCtrl = m_meetingService->GetMeetingRecordingController();
+        function<void(bool)> onRecordingPrivilegeChanged = [this](bool canRec) {
+            m_executor.post([this, canRec]() { m_consent.onRecordingPrivilege(canRec); });
+        };
+        auto recordingEvent = new MeetingRecordingCtrlEvent(onRecordingPrivilegeChanged);
+        recordingCtrl->SetEvent(recordingEvent);
+        m_consent.start();
     }
 }
 
 // Method to send a message in the chat
-void Zoom::sendMessage(const std::string& message) {
+bool Zoom::sendMessage(const std::string& message, unsigned int receiver) {
+    Tracer::Scope scope("sendMessage", "chat");
     auto* chatController = m_meetingService->GetMeetingChatController();
-    if (!chatController) return;
+    if (!chatController) return false;
 
     IChatMsgInfoBuilder* msgBuilder = chatController->GetChatMessageBuilder();
-    if (!msgBuilder) return;
+    if (!msgBuilder) return false;
 
-    msgBuilder->SetContent(message.c_str())->SetReceiver(0)->SetMessageType(SDKChatMessageType_To_All);
+    auto type = receiver ? SDKChatMessageType_To_Individual : SDKChatMessageType_To_All;
+    msgBuilder->SetContent(message.c_str())->SetReceiver(receiver)->SetMessageType(type);
     IChatMsgInfo* chatMsg = msgBuilder->Build();
-    if (chatMsg) {
-        chatController->SendChatMsgTo(chatMsg);
-    }
-}
+    if (!chatMsg) return false;
 
-void Zoom::checkConsentStatus() {
-    while (!recordingStarted) {
-        // Simulate API call
-        std::this_thread::sleep_for(std::chrono::seconds(2)); // Adjust interval as needed
-        fetchParticipants();
-
-        // API call to fetch consent status
-        std::string apiUrl = "http://localhost:5000/consent"; // Replace with actual API URL
-        std::future<std::string> response = std::async(std::launch::async, [&apiUrl] {
-            // Your HTTP GET request to fetch consent status
-            // Perform the HTTP request here and return the response as a string
-            // For demonstration purposes, a mock implementation is provided below
-            // Replace this with your actual HTTP request code
-            std::string dummyApiResponse = "{\"consenting_users\": [\"IdentifAI KYE\", \"Harshit Soni\"]}";
-            return dummyApiResponse;
-        });
+    auto sent = !hasError(chatController->SendChatMsgTo(chatMsg), "send chat message");
+    count(sent ? StatsSegment::ChatSent : StatsSegment::ChatFailed);
 
-        auto result = response.get();
-        Json::Value jsonData;
-        Json::Reader reader;
-        if (reader.parse(result, jsonData)) {
-            auto consentingUsers = jsonData["consenting_users"];
-            std::vector<std::string> users;
-            for (const auto& user : consentingUsers) {
-                users.push_back(user.asString());
-            }
-            onConsentUpdate(users);
-        }
-    }
+    return sent;
 }
 
+bool Zoom::list(vector<unsigned int>& ids) {
+    auto* participantsController = m_meetingService->GetMeetingParticipantsController();
+    if (!participantsController) return false;
 
-// Callback when consent API is called
-void Zoom::onConsentUpdate(const std::vector<std::string>& consentingUsers) {
-    for (const auto& user : participants) {
-        consentStatus[user] = std::find(consentingUsers.begin(), consentingUsers.end(), user) != consentingUsers.end();
-    }
+    auto participantsList = participantsController->GetParticipantsList();
+    if (!participantsList) return false;
 
-    bool allConsented = std::all_of(participants.begin(), participants.end(), [this](const std::string& user) {
-        return consentStatus[user];
-    });
+    ids.clear();
+    for (int i = 0; i < participantsList->GetCount(); ++i)
+        ids.push_back(participantsList->GetItem(i));
 
-    if (allConsented) {
-        recordingStarted = true;
-        startRawRecording();
-    } else {
-        sendConsentReminder();
-    }
+    return true;
 }
 
-// Send consent reminder message
-void Zoom::sendConsentReminder() {
-    std::string reminder = "Please provide your consent for recording.";
-    for (const auto& user : participants) {
-        if (!consentStatus[user]) {
-            reminder += "\n- " + user;
-        }
-    }
-    sendMessage(reminder);
+const char* Zoom::name(unsigned int userId) {
+    auto* participantsController = m_meetingService->GetMeetingParticipantsController();
+    if (!participantsController) return nullptr;
+
+    IUserInfo* userInfo = participantsController->GetUserByUserID(userId);
+    return userInfo ? userInfo->GetUserName() : nullptr;
 }
 
-// New function implementation
-void Zoom::startRecordingIfAllConsented() {
-    bool allConsented = std::all_of(consentStatus.begin(), consentStatus.end(),
-                                     [](const auto& entry) { return entry.second; });
+unsigned int Zoom::self() {
+    auto* participantsController = m_meetingService->GetMeetingParticipantsController();
+    if (!participantsController || !participantsController->GetMySelfUser()) return 0;
 
-    if (allConsented) {
-        Log::info("All participants have consented. Starting recording...");
-        startRawRecording();
-    } else {
-        Log::info("Not all participants have consented yet. Waiting...");
-    }
+    return participantsController->GetMySelfUser()->GetUserID();
 }
 
+bool Zoom::startRecording() {
+    return startRawRecording() == SDKERR_SUCCESS;
+}
 
-// Start checking for consent
-void Zoom::startConsentCheck() {
-    std::thread([this]() {
-        std::this_thread::sleep_for(std::chrono::seconds(30));
-        if (!recordingStarted) {
-            sendConsentReminder();
-        }
-    }).detach();
+void Zoom::stopRecording() {
+    stopRawRecording();
+}
+
+// one renderer per participant, only when recording video selectively
+void Zoom::joined(unsigned int userId) {
+    if (m_config.useRawVideo())
+        subscribeUserVideo(userId);
+}
 
-    std::thread(&Zoom::checkConsentStatus, this).detach();
+void Zoom::left(unsigned int userId) {
+    unsubscribeUserVideo(userId);
 }
@@ -7,7 +7,6 @@
 #include <sstream>
 #include <unordered_set>
 #include <unordered_map>
-#include <future>
 #include <thread>
 
 #include <jwt-cpp/jwt.h>
@@ -15,6 +14,8 @@
 #include "Config.h"
 #include "util/Singleton.h"
 #include "util/Log.h"
+#include "util/Executor.h"
+#include "util/TimerWheel.h"
 
 #include "zoom_sdk.h"
 #include "rawdata/zoom_rawdata_api.h"
@@ -29,9 +30,23 @@
 #include "events/MeetingServiceEvent.h"
 #include "events/MeetingReminderEvent.h"
 #include "events/MeetingRecordingCtrlEvent.h"
+#include "events/MeetingParticipantsCtrlEvent.h"
+
+#include "consent/ConsentEngine.h"
+
+#include "net/HttpListener.h"
+
+#include "chat/ChatOutbox.h"
 
 #include "raw_record/ZoomSDKRendererDelegate.h"
 #include "raw_record/ZoomSDKAudioRawDataDelegate.h"
+#include "raw_record/SegmentLedger.h"
+#include "raw_record/SegmentPurger.h"
+#include "raw_record/FrameCounter.h"
+
+#include "stats/StatsSegment.h"
+#include "metrics/Metrics.h"
+#include "metrics/Tracer.h"
 
 using namespace std;
 using namespace jwt;
@@ -39,7 +54,8 @@ using namespace ZOOMSDK;
 
 typedef chrono::time_point<chrono::system_clock> time_point;
 
-class Zoom : public Singleton<Zoom> {
+// the SDK side of the consent engine, which decides when to record
+class Zoom : public Singleton<Zoom>, ConsentEngine::Participants, ConsentEngine::Recording {
     friend class Singleton<Zoom>;
 
     Config m_config;
@@ -53,37 +69,75 @@ class Zoom : public Singleton<Zoom> {
     ZoomSDKRendererDelegate* m_videoSource;
     IZoomSDKAudioRawDataHelper* m_audioHelper;
     ZoomSDKAudioRawDataDelegate* m_audioSource;
-    unordered_set<string> m_consentingUsers;
+    unordered_map<unsigned int, pair<IZoomSDKRenderer*, ZoomSDKRendererDelegate*>> m_userVideo;
+
+    bool m_privilegeRequested = false;
+
+    SegmentLedger m_segments;
+    SegmentPurger m_purger{m_segments};
+    bool m_cleaned = false;
+
+    StatsSegment m_stats;
+    StatsSegment::Slot* m_statsSlot = nullptr;
+    bool m_supervised = false;
 
-    unordered_set<string> participants; // Add this declaration
-    unordered_map<string, bool> consentStatus; // Add this declaration
-    bool recordingStarted = false; // Add this declaration
+    Executor m_executor;
+    TimerWheel m_timers;
+    ChatOutbox m_chat{m_executor, m_timers};
+    ConsentEngine m_consent{m_config, m_timers, m_chat, m_purger, *this, *this};
+
+    Metrics m_metrics;
+    HttpListener m_metricsListener{m_timers};
+
+    // starts of the steps that finish in an SDK callback, for the trace
+    Tracer::Clock::time_point m_configAt;
+    Tracer::Clock::time_point m_authAt;
+    Tracer::Clock::time_point m_joinAt;
+    Tracer::Clock::time_point m_joinedAt;
 
     SDKError createServices();
     void generateJWT(const string& key, const string& secret);
-    SDKError sendConsentRequest(IMeetingChatController* chatCtrl);
-    void startRecordingIfAllConsented();
-    void checkConsentStatus();
+    SDKError subscribeUserVideo(unsigned int userId);
+    void unsubscribeUserVideo(unsigned int userId);
+    void onMeetingJoin();
+    bool syncRecordings(chrono::steady_clock::time_point deadline);
+    vector<FrameCounter*> frameCounters() const;
+    void attachStats();
+    void publishStats();
+    void serveMetrics();
+    void reportLatency();
+    void count(StatsSegment::Stat stat, uint64_t n = 1);
+    void onMeetingEnd();
+
+    // ConsentEngine::Participants
+    bool list(vector<unsigned int>& ids) override;
+    const char* name(unsigned int userId) override;
+    unsigned int self() override;
+
+    // ConsentEngine::Recording
+    bool startRecording() override;
+    void stopRecording() override;
+    void joined(unsigned int userId) override;
+    void left(unsigned int userId) override;
 
     function<void()> onAuth = [&]() {
+        Tracer::async("authenticating", "lifecycle", m_authAt);
+
         auto e = isMeetingStart() ? start() : join();
         string action = isMeetingStart() ? "start" : "join";
         if (hasError(e, action + " a meeting")) exit(e);
     };
 
+    // SDK callbacks only post to the executor, all state changes run on it
     function<void()> onJoin = [&]() {
-        auto* reminderController = m_meetingService->GetMeetingReminderController();
-        reminderController->SetEvent(new MeetingReminderEvent());
-        if (m_config.useRawRecording()) {
-            auto recordingCtrl = m_meetingService->GetMeetingRecordingController();
-            function<void(bool)> onRecordingPrivilegeChanged = [&](bool canRec) {
-                if (canRec) startRecordingIfAllConsented();
-                else stopRawRecording();
-            };
-            auto recordingEvent = new MeetingRecordingCtrlEvent(onRecordingPrivilegeChanged);
-            recordingCtrl->SetEvent(recordingEvent);
-            checkConsentStatus();
-        }
+        Tracer::async("joining", "lifecycle", m_joinAt);
+        m_joinedAt = Tracer::Clock::now();
+
+        m_executor.post([this]() { onMeetingJoin(); });
+    };
+
+    function<void()> onEnd = [&]() {
+        m_executor.post([this]() { onMeetingEnd(); });
     };
 
 public:
@@ -94,13 +148,11 @@ public:
     SDKError start();
     SDKError startRawRecording();
     SDKError stopRawRecording();
-    void fetchParticipants();
-    void sendMessage(const std::string& message);
-    void onConsentUpdate(const std::vector<std::string>& consentingUsers);
-    void sendConsentReminder();
-    void startConsentCheck();
+    bool sendMessage(const std::string& message, unsigned int receiver = 0);
     SDKError leave();
     SDKError clean();
+    void shutdown();
+    void writeTrace();
     bool isMeetingStart();
     static bool hasError(SDKError e, const string& action = "");
 };
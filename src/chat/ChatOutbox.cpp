@@ -0,0 +1,154 @@
+#include "ChatOutbox.h"
+
+#include <algorithm>
+#include <sstream>
+
+#include "../util/Log.h"
+
+ChatOutbox::ChatOutbox(Executor& executor, TimerWheel& timers) :
+        m_executor(executor),
+        m_timers(timers),
+        m_tokens(m_burst),
+        m_refilledAt(chrono::steady_clock::now())
+{
+
+}
+
+ChatOutbox::~ChatOutbox() {
+    m_timers.cancel(m_timer);
+}
+
+void ChatOutbox::setSender(const Sender& sender) {
+    m_sender = sender;
+}
+
+void ChatOutbox::setRate(double perSecond, size_t burst) {
+    m_rate = max(perSecond, 0.01);
+    m_burst = max<double>(burst, 1);
+    m_tokens = m_burst;
+}
+
+void ChatOutbox::setMaxLength(size_t maxLength) {
+    m_maxLength = max<size_t>(maxLength, 16);
+}
+
+void ChatOutbox::post(unsigned int receiver, const string& text) {
+    post(receiver, text, {});
+}
+
+void ChatOutbox::post(unsigned int receiver, const string& header, const vector<string>& lines) {
+    m_executor.post([this, receiver, header, lines]() {
+        enqueue(receiver, header, lines);
+        drain();
+    });
+}
+
+void ChatOutbox::forget(unsigned int receiver) {
+    m_lastSent.erase(receiver);
+}
+
+size_t ChatOutbox::pending() const {
+    return m_queue.size();
+}
+
+void ChatOutbox::enqueue(unsigned int receiver, const string& header, const vector<string>& lines) {
+    string text = header;
+    for (const auto& line : lines)
+        text += "\n" + line;
+
+    auto it = m_waiting.find(receiver);
+
+    if (it != m_waiting.end()) {
+        auto* waiting = it->second;
+        if (waiting->text == text) return;
+
+        // a half sent message is finished first, only an untouched one is replaced
+        if (!waiting->sent) {
+            waiting->text = move(text);
+            waiting->parts = split(header, lines);
+            return;
+        }
+    } else {
+        auto last = m_lastSent.find(receiver);
+        if (last != m_lastSent.end() && last->second == text)
+            return;
+    }
+
+    m_queue.push_back({receiver, move(text), split(header, lines)});
+    m_waiting[receiver] = &m_queue.back();
+}
+
+vector<string> ChatOutbox::split(const string& header, const vector<string>& lines) const {
+    vector<string> parts;
+    string part = header.substr(0, m_maxLength);
+    bool empty = true;
+
+    for (const auto& line : lines) {
+        if (!empty && part.size() + 1 + line.size() > m_maxLength) {
+            parts.push_back(move(part));
+            part = header.substr(0, m_maxLength);
+            empty = true;
+        }
+
+        // a single line too long for a message of its own is cut short
+        auto room = m_maxLength > part.size() + 1 ? m_maxLength - part.size() - 1 : 0;
+        if (room) {
+            part += "\n" + line.substr(0, room);
+            empty = false;
+        }
+    }
+
+    parts.push_back(move(part));
+
+    return parts;
+}
+
+void ChatOutbox::refill() {
+    auto now = chrono::steady_clock::now();
+    auto elapsed = chrono::duration<double>(now - m_refilledAt).count();
+
+    m_tokens = min(m_burst, m_tokens + elapsed * m_rate);
+    m_refilledAt = now;
+}
+
+void ChatOutbox::drain() {
+    refill();
+
+    while (!m_queue.empty() && m_tokens >= 1) {
+        auto& message = m_queue.front();
+
+        m_tokens -= 1;
+        if (!m_sender || !m_sender(message.receiver, message.parts[message.sent])) {
+            // an unsent reminder must not suppress the next identical one
+            Log::error("failed to send chat message");
+            pop();
+            continue;
+        }
+
+        if (++message.sent < message.parts.size())
+            continue;
+
+        m_lastSent[message.receiver] = move(message.text);
+        pop();
+    }
+
+    if (m_queue.empty() || m_timer)
+        return;
+
+    auto wait = chrono::duration<double>((1 - m_tokens) / m_rate);
+    m_timer = m_timers.after(chrono::duration_cast<TimerWheel::Duration>(wait) + TimerWheel::Duration(1), [this]() {
+        m_timer = 0;
+        drain();
+    });
+}
+
+void ChatOutbox::pop() {
+    auto& message = m_queue.front();
+
+    // a newer message to the same receiver queued behind this one stays indexed
+    auto it = m_waiting.find(message.receiver);
+    if (it != m_waiting.end() && it->second == &message)
+        m_waiting.erase(it);
+
+    m_queue.pop_front();
+}
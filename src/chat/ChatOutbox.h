@@ -0,0 +1,117 @@
+#ifndef MEETING_SDK_LINUX_SAMPLE_CHATOUTBOX_H
+#define MEETING_SDK_LINUX_SAMPLE_CHATOUTBOX_H
+
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "../util/Executor.h"
+#include "../util/TimerWheel.h"
+
+using namespace std;
+
+/**
+ * Rate limited queue for chat messages sent by the bot.
+ *
+ * A message posted for a receiver that still has one waiting replaces it, and
+ * a message identical to the last one the receiver got is dropped. Long lists
+ * are split into parts that fit the chat size limit, and parts go out at most
+ * as fast as a token bucket allows. Everything runs on the executor.
+ */
+class ChatOutbox {
+public:
+    /**
+     * Sends one chat message
+     * @param receiver user id of the receiver, 0 for everyone
+     * @param text content of the message
+     * @return true if the message was sent
+     */
+    typedef function<bool(unsigned int receiver, const string& text)> Sender;
+
+private:
+    struct Message {
+        unsigned int receiver;
+        string text;
+        vector<string> parts;
+        size_t sent = 0;
+    };
+
+    Executor& m_executor;
+    TimerWheel& m_timers;
+    Sender m_sender;
+
+    double m_rate = 1;
+    double m_burst = 5;
+    size_t m_maxLength = 1000;
+
+    double m_tokens = 0;
+    chrono::steady_clock::time_point m_refilledAt;
+    TimerWheel::Id m_timer = 0;
+
+    deque<Message> m_queue;
+    // newest queued message of each receiver, deque ends never move elements
+    unordered_map<unsigned int, Message*> m_waiting;
+    unordered_map<unsigned int, string> m_lastSent;
+
+    void enqueue(unsigned int receiver, const string& header, const vector<string>& lines);
+    vector<string> split(const string& header, const vector<string>& lines) const;
+    void refill();
+    void drain();
+    void pop();
+
+public:
+    /**
+     * @param executor main executor the messages are sent on
+     * @param timers wheel used to wait for the bucket to refill
+     */
+    ChatOutbox(Executor& executor, TimerWheel& timers);
+    ~ChatOutbox();
+
+    ChatOutbox(const ChatOutbox&) = delete;
+    ChatOutbox& operator=(const ChatOutbox&) = delete;
+
+    void setSender(const Sender& sender);
+
+    /**
+     * @param perSecond messages sent per second once the burst is used up
+     * @param burst messages that may be sent back to back
+     */
+    void setRate(double perSecond, size_t burst);
+
+    /**
+     * @param maxLength longest message the chat accepts
+     */
+    void setMaxLength(size_t maxLength);
+
+    /**
+     * Queue a message, safe to call from any thread
+     * @param receiver user id of the receiver, 0 for everyone
+     * @param text content of the message
+     */
+    void post(unsigned int receiver, const string& text);
+
+    /**
+     * Queue a header followed by one line per item, split across messages if too long
+     * @param receiver user id of the receiver, 0 for everyone
+     * @param header first line of every part
+     * @param lines items listed below the header
+     */
+    void post(unsigned int receiver, const string& header, const vector<string>& lines);
+
+    /**
+     * Let the next message to a receiver repeat the last one it got
+     * @param receiver user id of the receiver
+     */
+    void forget(unsigned int receiver);
+
+    /**
+     * @return messages not fully sent yet
+     */
+    size_t pending() const;
+};
+
+
+#endif //MEETING_SDK_LINUX_SAMPLE_CHATOUTBOX_H
@@ -0,0 +1,610 @@
+#include "ConsentEngine.h"
+
+#include <algorithm>
+#include <sstream>
+
+#include <json/json.h>
+
+#include "../util/Log.h"
+#include "../metrics/Tracer.h"
+
+ConsentEngine::ConsentEngine(const Config& config, TimerWheel& timers, ChatOutbox& chat, SegmentPurger& purger,
+                             Participants& participants, Recording& recording) :
+        m_config(config),
+        m_timers(timers),
+        m_chat(chat),
+        m_purger(purger),
+        m_participants(participants),
+        m_recording(recording)
+{
+
+}
+
+void ConsentEngine::setStats(StatsSegment::Slot* stats)
+{
+    m_stats = stats;
+}
+
+void ConsentEngine::setMetrics(Metrics* metrics)
+{
+    m_metrics = metrics;
+}
+
+// Only used for the initial snapshot and a rare reconciliation pass, the
+// participants events keep the roster current in between.
+void ConsentEngine::fetchParticipants() {
+    Tracer::Scope scope("fetchParticipants", "consent");
+    if (!m_participants.list(m_present)) return;
+
+    unordered_set<unsigned int> present;
+    present.reserve(m_present.size());
+
+    for (auto userId : m_present) {
+        if (userId) {
+            present.insert(userId);
+            addParticipant(userId);
+        }
+    }
+
+    vector<unsigned int> stale;
+    for (const auto& entry : m_roster) {
+        if (!present.count(entry.first))
+            stale.push_back(entry.first);
+    }
+
+    for (auto userId : stale)
+        removeParticipant(userId);
+
+    if (!stale.empty()) {
+        stringstream ss;
+        ss << "reconciliation dropped " << stale.size() << " stale participant(s)";
+        Log::info(ss.str());
+    }
+}
+
+void ConsentEngine::addParticipant(unsigned int userId) {
+    auto* userName = m_participants.name(userId);
+    if (!userName) return;
+
+    string name = userName;
+    auto* known = m_roster.name(userId);
+
+    if (!known)
+        m_tracker.join(name);
+    else if (*known != name)
+        m_tracker.rename(*known, name);
+
+    m_roster.add(userId, name);
+    m_gate.set(userId, m_tracker.hasConsent(name));
+
+    if (m_config.selectiveRecording())
+        m_recordedIds[name].insert(userId);
+
+    if (!known && m_recordingStarted && m_config.selectiveRecording())
+        m_recording.joined(userId);
+}
+
+void ConsentEngine::removeParticipant(unsigned int userId) {
+    auto* name = m_roster.name(userId);
+    if (!name) return;
+
+    m_tracker.leave(*name);
+    m_roster.remove(userId);
+
+    m_gate.set(userId, false);
+    m_recording.left(userId);
+    m_remindedIds.erase(userId);
+
+    m_chat.forget(userId);
+}
+
+void ConsentEngine::onUserJoin(const vector<unsigned int>& userIds) {
+    for (auto userId : userIds)
+        addParticipant(userId);
+}
+
+void ConsentEngine::onUserLeft(const vector<unsigned int>& userIds) {
+    for (auto userId : userIds)
+        removeParticipant(userId);
+}
+
+void ConsentEngine::onUserNamesChanged(const vector<unsigned int>& userIds) {
+    for (auto userId : userIds) {
+        if (m_roster.contains(userId))
+            addParticipant(userId);
+    }
+}
+
+void ConsentEngine::onRecordingPrivilege(bool canRecord) {
+    if (canRecord) return startRecordingIfAllConsented();
+
+    // the SDK stopped recording, a later grant starts it again
+    if (m_recordingStarted) m_recording.stopRecording();
+    m_recordingStarted = false;
+}
+
+void ConsentEngine::checkConsentStatus() {
+    // the previous poll is still in flight or backing off
+    if (m_api.busy()) return;
+
+    // the API keeps failing, go on with the last good snapshot for now
+    if (!m_breaker.allow()) return;
+
+    // reconcile the roster against the full participants list every minute
+    const int reconcileEvery = max(1, 60 / m_pollInterval);
+    if (++m_polls % reconcileEvery == 0)
+        fetchParticipants();
+
+    auto sentAt = chrono::steady_clock::now();
+    auto tracedAt = Tracer::Clock::now();
+
+    m_api.get([this, sentAt, tracedAt](const HttpClient::Response& response) {
+        Tracer::async("consent request", "consent", tracedAt);
+
+        auto latency = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - sentAt).count();
+        count(StatsSegment::ConsentPolls);
+
+        if (m_stats) {
+            m_stats->set(StatsSegment::ConsentPollLatency, latency);
+            if (static_cast<uint64_t>(latency) > m_stats->get(StatsSegment::ConsentPollLatencyMax))
+                m_stats->set(StatsSegment::ConsentPollLatencyMax, latency);
+        }
+
+        if (!response.ok()) {
+            count(StatsSegment::ConsentPollFailures);
+            m_breaker.failure();
+
+            stringstream ss;
+            ss << "failed to fetch consent status: ";
+            if (response.error.empty()) ss << "HTTP " << response.status;
+            else ss << response.error;
+            return Log::error(ss.str());
+        }
+
+        m_breaker.success();
+        onConsentResponse(response.body);
+    });
+}
+
+void ConsentEngine::onConsentResponse(const string& body) {
+    Tracer::Scope scope("onConsentResponse", "consent");
+    if (!watchingConsent()) return;
+
+    // same response as last time, only roster changes need a look
+    if (body == m_lastResponse) {
+        markConsentFresh();
+        return evaluateConsent();
+    }
+
+    // keep spare capacity so the parser can read the copy in place
+    m_lastResponse.reserve(body.size() + ConsentParser::padding);
+    m_lastResponse.assign(body);
+
+    if (!m_parser.parse(m_lastResponse, m_tracker)) {
+        Log::error("failed to parse consent API response");
+        m_lastResponse.clear();
+        return;
+    }
+
+    markConsentFresh();
+
+    if (!m_tracker.changes().empty()) {
+        m_consentAt = chrono::system_clock::now();
+        applyConsentChanges();
+    }
+
+    evaluateConsent();
+}
+
+// Consent change pushed by the consent service
+void ConsentEngine::onConsentWebhook(const HttpListener::Request& request, HttpListener::Response& response) {
+    Tracer::Scope scope("onConsentWebhook", "consent");
+
+    // a single push can start recording, only the consent service may send one
+    if (!authorized(request)) {
+        response.status = 401;
+        return;
+    }
+
+    Json::Value jsonData;
+    Json::Reader reader;
+    if (!reader.parse(request.body, jsonData) || !jsonData.isObject()) {
+        response.status = 400;
+        return;
+    }
+
+    response.status = 202;
+    auto lastChange = m_consentAt;
+
+    // a full snapshot takes the same path as a polled response
+    if (jsonData.isMember("consenting_users")) {
+        onConsentResponse(request.body);
+    } else if (jsonData["user"].isString() && jsonData["consent"].isBool()) {
+        if (m_tracker.set(jsonData["user"].asString(), jsonData["consent"].asBool())) {
+            m_consentAt = chrono::system_clock::now();
+            applyConsentChanges();
+
+            // the next poll must be diffed even if its body did not change
+            m_lastResponse.clear();
+        }
+    } else {
+        response.status = 400;
+        return;
+    }
+
+    // the consent service may tell us when the consent was actually given
+    if (m_consentAt != lastChange && jsonData["timestamp"].isIntegral())
+        m_consentAt = time_point(chrono::milliseconds(jsonData["timestamp"].asInt64()));
+
+    if (watchingConsent())
+        evaluateConsent();
+}
+
+// Bearer token of the consent service, compared in constant time
+bool ConsentEngine::authorized(const HttpListener::Request& request) const {
+    auto header = request.headers.find("authorization");
+    if (header == request.headers.end()) return false;
+
+    auto expected = "Bearer " + m_config.webhookSecret();
+    const auto& given = header->second;
+    if (given.size() != expected.size()) return false;
+
+    unsigned char diff = 0;
+    for (size_t i = 0; i < given.size(); ++i)
+        diff |= static_cast<unsigned char>(given[i] ^ expected[i]);
+
+    return diff == 0;
+}
+
+void ConsentEngine::onConsentUpdate(const vector<string>& consentingUsers) {
+    if (m_tracker.update(consentingUsers))
+        m_consentAt = chrono::system_clock::now();
+
+    evaluateConsent();
+}
+
+// Log how long it took from the last consent change to recording
+void ConsentEngine::reportConsentLatency() {
+    if (m_consentAt == time_point()) return;
+
+    auto latency = chrono::duration_cast<chrono::milliseconds>(chrono::system_clock::now() - m_consentAt);
+    m_consentAt = time_point();
+
+    if (m_metrics) m_metrics->consentToRecord().observe(latency);
+
+    stringstream ss;
+    ss << "recording started " << latency.count() << "ms after the last consent change";
+    Log::info(ss.str());
+}
+
+// Mirror consent changes into the gate read by the recorders, only for the users they concern
+void ConsentEngine::applyConsentChanges() {
+    const auto& changes = m_tracker.changes();
+
+    for (const auto& change : changes) {
+        auto* ids = m_roster.ids(change.first);
+        if (!ids) continue;
+
+        for (auto userId : *ids)
+            m_gate.set(userId, change.second);
+    }
+
+    for (const auto& change : changes)
+        m_journal.consent(change.first, change.second);
+
+    // the gate is closed first, the purger then waits out frames already past it
+    for (const auto& change : changes) {
+        auto ids = m_recordedIds.find(change.first);
+        if (change.second || ids == m_recordedIds.end()) continue;
+
+        for (auto userId : ids->second)
+            m_purger.purge(userId, change.first);
+    }
+}
+
+// Resume the consent state journaled before a restart of the bot
+void ConsentEngine::restoreConsent() {
+    if (m_config.journalDir().empty()) return;
+
+    string meetingId;
+    for (char c : m_config.meetingId()) {
+        if (isalnum(static_cast<unsigned char>(c))) meetingId += c;
+    }
+
+    auto start = chrono::steady_clock::now();
+    if (!m_journal.open(m_config.journalDir() + "/consent-" + meetingId + ".journal"))
+        return;
+
+    for (const auto& entry : m_journal.lastReminded())
+        m_remindedAt[entry.first] = time_point(chrono::milliseconds(entry.second));
+
+    if (m_journal.consenting().empty()) return;
+
+    m_tracker.begin();
+    for (const auto& name : m_journal.consenting())
+        m_tracker.consent(name);
+    m_tracker.commit();
+
+    for (const auto& entry : m_roster)
+        m_gate.set(entry.first, m_tracker.hasConsent(entry.second));
+
+    auto elapsed = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start);
+
+    stringstream ss;
+    ss << "restored consent of " << m_journal.consenting().size() << " user(s) in " << elapsed.count() << "us";
+    Log::info(ss.str());
+
+    // only seeds the tracker and gate, the first fresh snapshot decides about recording
+}
+
+// Selective recording keeps following consent after recording started
+bool ConsentEngine::watchingConsent() const {
+    return !m_recordingStarted || m_config.selectiveRecording();
+}
+
+// A full consent snapshot arrived, it can be trusted again
+void ConsentEngine::markConsentFresh() {
+    m_freshAt = chrono::steady_clock::now();
+    if (!m_stale) return;
+
+    m_stale = false;
+    m_gate.suspend(false);
+    Log::success("consent is up to date again, resuming");
+}
+
+// Stop relying on the last good snapshot once it is too old
+void ConsentEngine::checkConsentStaleness() {
+    if (m_stale || !watchingConsent()) return;
+
+    // steady, so a wall clock step neither hides nor fakes an outage
+    auto age = chrono::duration_cast<chrono::seconds>(chrono::steady_clock::now() - m_freshAt);
+    if (age.count() <= m_config.consentStaleness()) return;
+
+    m_stale = true;
+    m_gate.suspend(true);
+
+    stringstream ss;
+    ss << "last consent snapshot is " << age.count() << "s old, pausing until the consent API recovers";
+    Log::error(ss.str());
+}
+
+// Start recording or remind, only when the roster or consent changed
+void ConsentEngine::evaluateConsent() {
+    Tracer::Scope scope("evaluateConsent", "consent");
+    // a stale snapshot must not start anything, changes wait for fresh data
+    if (m_stale) return;
+
+    if (!m_tracker.takeDirty()) return;
+
+    // a start is only tried once from here, a failed one asked for the privilege
+    // and onRecordingPrivilege retries it when the host grants it
+    if (m_config.selectiveRecording()) {
+        // nothing is written for participants without consent, so start right away
+        if (!m_startAttempted)
+            startRecording();
+
+        if (!m_tracker.allConsented())
+            sendConsentReminder();
+        return;
+    }
+
+    if (m_tracker.allConsented()) {
+        if (!m_startAttempted)
+            startRecording();
+        if (m_recordingStarted) stopWatching();
+    } else {
+        sendConsentReminder();
+    }
+}
+
+void ConsentEngine::startRecording() {
+    m_startAttempted = true;
+    m_recordingStarted = m_recording.startRecording();
+    if (m_recordingStarted) reportConsentLatency();
+}
+
+void ConsentEngine::startRecordingIfAllConsented() {
+    // already recording, or consent is too old to start anything on
+    if (m_recordingStarted || m_stale) return;
+
+    if (m_config.selectiveRecording()) {
+        Log::info("Recording the participants who have consented...");
+        startRecording();
+    } else if (m_tracker.allConsented()) {
+        Log::info("All participants have consented. Starting recording...");
+        startRecording();
+        if (m_recordingStarted) stopWatching();
+    } else {
+        Log::info("Not all participants have consented yet. Waiting...");
+    }
+}
+
+// Everyone consented and recording runs, consent is no longer followed
+void ConsentEngine::stopWatching() {
+    m_timers.cancel(m_reminderTimer);
+    m_timers.cancel(m_pollTimer);
+    m_timers.cancel(m_stalenessTimer);
+}
+
+void ConsentEngine::sendConsentReminder() {
+    if (m_config.privateReminders())
+        return sendPrivateReminders();
+
+    auto now = chrono::system_clock::now();
+
+    // everyone who would be listed was reminded recently, e.g. before a restart
+    auto due = any_of(m_roster.begin(), m_roster.end(), [&](const auto& entry) {
+        return !m_tracker.hasConsent(entry.second) && reminderDue(entry.second, now);
+    });
+    if (!due) return;
+
+    vector<string> missing;
+    for (const auto& entry : m_roster) {
+        if (!m_tracker.hasConsent(entry.second)) {
+            markReminded(entry.second, now);
+            missing.push_back("- " + entry.second);
+        }
+    }
+
+    // sorted, so an unchanged list is recognised as a repeat and dropped
+    sort(missing.begin(), missing.end());
+    m_chat.post(0, "Please provide your consent for recording.", missing);
+}
+
+bool ConsentEngine::reminderDue(const string& name, time_point now) const {
+    auto it = m_remindedAt.find(name);
+    return it == m_remindedAt.end() || now - it->second >= chrono::seconds(m_config.reminderInterval());
+}
+
+// Participants sharing a display name are each reminded on their own
+bool ConsentEngine::reminderDue(unsigned int userId, const string& name, time_point now) const {
+    auto it = m_remindedIds.find(userId);
+    if (it != m_remindedIds.end())
+        return now - it->second >= chrono::seconds(m_config.reminderInterval());
+
+    // not reminded since the bot started, the journal only knows the name
+    return reminderDue(name, now);
+}
+
+void ConsentEngine::markReminded(unsigned int userId, const string& name, time_point now) {
+    m_remindedIds[userId] = now;
+    m_journal.reminded(name, chrono::duration_cast<chrono::milliseconds>(now.time_since_epoch()).count());
+}
+
+void ConsentEngine::markReminded(const string& name, time_point now) {
+    m_remindedAt[name] = now;
+    m_journal.reminded(name, chrono::duration_cast<chrono::milliseconds>(now.time_since_epoch()).count());
+}
+
+// Percent-encode a display name for use in a query string
+static string urlEncode(const string& value) {
+    static const char* hex = "0123456789ABCDEF";
+
+    string encoded;
+    for (unsigned char c : value) {
+        if (isalnum(c) || c == '-' || c == '_' || c == '.' || c == '~') {
+            encoded += c;
+        } else {
+            encoded += '%';
+            encoded += hex[c >> 4];
+            encoded += hex[c & 15];
+        }
+    }
+
+    return encoded;
+}
+
+// Consent form link that identifies the participant it is sent to
+string ConsentEngine::consentLink(const string& name) const {
+    const auto& link = m_config.consentLink();
+    auto separator = link.find('?') == string::npos ? "?" : "&";
+
+    return link + separator + "name=" + urlEncode(name);
+}
+
+// Remind each participant without consent privately, at most once per interval
+void ConsentEngine::sendPrivateReminders() {
+    auto now = chrono::system_clock::now();
+
+    // the bot does not need to remind itself
+    auto self = m_participants.self();
+
+    for (const auto& entry : m_roster) {
+        if (entry.first == self || m_tracker.hasConsent(entry.second)) continue;
+
+        if (!reminderDue(entry.first, entry.second, now)) continue;
+
+        markReminded(entry.first, entry.second, now);
+
+        // the interval is the repeat limit here, the outbox pacing spreads the sends
+        m_chat.forget(entry.first);
+        m_chat.post(entry.first, "We would like to record this meeting. Please provide your consent here: " + consentLink(entry.second));
+    }
+}
+
+void ConsentEngine::start() {
+    auto remind = [this]() {
+        if (watchingConsent() && !m_tracker.allConsented()) {
+            sendConsentReminder();
+        }
+    };
+
+    // private reminders repeat, each participant is only reminded once per interval
+    if (m_config.privateReminders())
+        m_reminderTimer = m_timers.every(chrono::seconds(30), remind);
+    else
+        m_reminderTimer = m_timers.after(chrono::seconds(30), remind);
+
+    m_purger.setAuditFile(m_config.auditFile());
+
+    restoreConsent();
+
+    if (!m_api.setUrl(m_config.consentUrl())) {
+        Log::error("unable to use consent API URL " + m_config.consentUrl());
+        return;
+    }
+
+    m_api.setTimeout(chrono::milliseconds(m_config.consentTimeout()));
+    m_api.setRetries(m_config.consentRetries(), chrono::milliseconds(250));
+
+    m_breaker.configure(m_config.breakerFailures(), chrono::seconds(m_config.breakerCooldown()));
+    m_freshAt = chrono::steady_clock::now();
+
+    // on a timer of its own, a poll stuck in flight or held by the breaker must not keep it from firing
+    m_stalenessTimer = m_timers.every(chrono::seconds(1), [this]() {
+        checkConsentStaleness();
+    });
+
+    m_pollInterval = m_config.consentPollInterval();
+
+    if (m_config.useWebhook() && m_config.webhookSecret().empty()) {
+        Log::error("the consent webhook needs --webhook-secret, polling the consent API instead");
+    } else if (m_config.useWebhook()) {
+        m_webhook.route("POST", "/consent", [this](const HttpListener::Request& req, HttpListener::Response& res) {
+            onConsentWebhook(req, res);
+        });
+
+        // changes are pushed, polling is only a slow reconciliation fallback
+        if (m_webhook.listen(m_config.webhookHost(), m_config.webhookPort())) {
+            Log::success("listening for consent webhooks");
+            m_pollInterval = m_config.consentReconcileInterval();
+        }
+    }
+
+    m_pollInterval = max(m_pollInterval, 1);
+
+    // poll on the main loop until recording starts, armed before anything can cancel it
+    m_pollTimer = m_timers.every(chrono::seconds(m_pollInterval), [this]() {
+        checkConsentStatus();
+    });
+
+    checkConsentStatus();
+}
+
+void ConsentEngine::close() {
+    m_journal.close();
+}
+
+bool ConsentEngine::recording() const {
+    return m_recordingStarted;
+}
+
+bool ConsentEngine::stale() const {
+    return m_stale;
+}
+
+const ConsentGate& ConsentEngine::gate() const {
+    return m_gate;
+}
+
+const ParticipantRoster& ConsentEngine::participants() const {
+    return m_roster;
+}
+
+CircuitBreaker& ConsentEngine::breaker() {
+    return m_breaker;
+}
+
+void ConsentEngine::count(StatsSegment::Stat stat, uint64_t n) {
+    if (m_stats) m_stats->add(stat, n);
+}
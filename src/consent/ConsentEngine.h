@@ -0,0 +1,239 @@
+#ifndef MEETING_SDK_LINUX_SAMPLE_CONSENTENGINE_H
+#define MEETING_SDK_LINUX_SAMPLE_CONSENTENGINE_H
+
+#include <chrono>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "../Config.h"
+#include "../util/TimerWheel.h"
+#include "../chat/ChatOutbox.h"
+#include "../net/HttpClient.h"
+#include "../net/HttpListener.h"
+#include "../net/CircuitBreaker.h"
+#include "../raw_record/SegmentPurger.h"
+#include "../stats/StatsSegment.h"
+#include "../metrics/Metrics.h"
+
+#include "ParticipantRoster.h"
+#include "ConsentTracker.h"
+#include "ConsentParser.h"
+#include "ConsentGate.h"
+#include "ConsentJournal.h"
+
+using namespace std;
+
+/**
+ * Decides who may be recorded and when recording starts.
+ *
+ * Keeps the roster in step with the meeting, polls the consent API and takes
+ * webhook pushes, mirrors consent into the gate the recorders read, purges the
+ * media of participants who revoke it and reminds those who did not give it.
+ * Consent is journaled so a restarted bot resumes where it stopped, and a
+ * snapshot older than the staleness limit pauses recording until the API
+ * answers again.
+ *
+ * Knows nothing of the SDK. The meeting is reached through the Participants
+ * and Recording interfaces and the chat through the outbox's sender, Zoom
+ * implements them on top of the SDK. Everything runs on the main loop thread.
+ */
+class ConsentEngine {
+public:
+    /**
+     * Who is in the meeting
+     */
+    class Participants {
+    public:
+        virtual ~Participants() = default;
+
+        /**
+         * @param ids filled with the user id of everyone in the meeting
+         * @return false if the list is not available
+         */
+        virtual bool list(vector<unsigned int>& ids) = 0;
+
+        /**
+         * @return display name of a participant, nullptr if unknown
+         */
+        virtual const char* name(unsigned int userId) = 0;
+
+        /**
+         * @return user id of the bot itself, 0 if unknown
+         */
+        virtual unsigned int self() = 0;
+    };
+
+    /**
+     * Raw recording of the meeting
+     */
+    class Recording {
+    public:
+        virtual ~Recording() = default;
+
+        /**
+         * Start recording, or ask for the privilege to
+         * @return true if recording started
+         */
+        virtual bool startRecording() = 0;
+
+        virtual void stopRecording() = 0;
+
+        /**
+         * A participant joined while recording selectively
+         */
+        virtual void joined(unsigned int userId) = 0;
+
+        /**
+         * A participant left, whether or not recording started
+         */
+        virtual void left(unsigned int userId) = 0;
+    };
+
+private:
+    typedef chrono::system_clock::time_point time_point;
+
+    const Config& m_config;
+    TimerWheel& m_timers;
+    ChatOutbox& m_chat;
+    SegmentPurger& m_purger;
+    Participants& m_participants;
+    Recording& m_recording;
+
+    StatsSegment::Slot* m_stats = nullptr;
+    Metrics* m_metrics = nullptr;
+
+    ParticipantRoster m_roster;
+    ConsentTracker m_tracker;
+    ConsentParser m_parser;
+    ConsentGate m_gate;
+    ConsentJournal m_journal;
+    bool m_recordingStarted = false;
+    bool m_startAttempted = false;
+
+    // remembered past leaving, a revocation purges every id a name was recorded under
+    unordered_map<string, unordered_set<unsigned int>> m_recordedIds;
+    // broadcast reminders and those journaled before a restart go by name, private ones by user id
+    unordered_map<string, time_point> m_remindedAt;
+    unordered_map<unsigned int, time_point> m_remindedIds;
+    vector<unsigned int> m_present;
+
+    TimerWheel::Id m_reminderTimer = 0;
+    TimerWheel::Id m_pollTimer = 0;
+    TimerWheel::Id m_stalenessTimer = 0;
+
+    HttpClient m_api;
+    CircuitBreaker m_breaker{"consent API"};
+    chrono::steady_clock::time_point m_freshAt;
+    bool m_stale = false;
+    string m_lastResponse;
+    int m_polls = 0;
+    int m_pollInterval = 2;
+
+    HttpListener m_webhook{m_timers};
+    time_point m_consentAt;
+
+    void addParticipant(unsigned int userId);
+    void removeParticipant(unsigned int userId);
+    void checkConsentStatus();
+    void onConsentWebhook(const HttpListener::Request& request, HttpListener::Response& response);
+    bool authorized(const HttpListener::Request& request) const;
+    void applyConsentChanges();
+    void evaluateConsent();
+    void startRecording();
+    void startRecordingIfAllConsented();
+    void stopWatching();
+    void reportConsentLatency();
+    void sendPrivateReminders();
+    bool reminderDue(const string& name, time_point now) const;
+    bool reminderDue(unsigned int userId, const string& name, time_point now) const;
+    void markReminded(const string& name, time_point now);
+    void markReminded(unsigned int userId, const string& name, time_point now);
+    string consentLink(const string& name) const;
+    void restoreConsent();
+    void markConsentFresh();
+    void checkConsentStaleness();
+    bool watchingConsent() const;
+    void count(StatsSegment::Stat stat, uint64_t n = 1);
+
+public:
+    /**
+     * @param config consent settings, read when start() is called
+     * @param timers main loop timers for polls, reminders and staleness
+     * @param chat outbox reminders are posted to
+     * @param purger removes the media of participants who revoke consent
+     * @param participants who is in the meeting
+     * @param recording started once consent allows it
+     */
+    ConsentEngine(const Config& config, TimerWheel& timers, ChatOutbox& chat, SegmentPurger& purger,
+                  Participants& participants, Recording& recording);
+
+    ConsentEngine(const ConsentEngine&) = delete;
+    ConsentEngine& operator=(const ConsentEngine&) = delete;
+
+    void setStats(StatsSegment::Slot* stats);
+    void setMetrics(Metrics* metrics);
+
+    /**
+     * Restore the journal, start polling the consent API and listen for webhooks
+     */
+    void start();
+
+    /**
+     * Take a full snapshot of the participants and reconcile the roster with it
+     */
+    void fetchParticipants();
+
+    void onUserJoin(const vector<unsigned int>& userIds);
+    void onUserLeft(const vector<unsigned int>& userIds);
+    void onUserNamesChanged(const vector<unsigned int>& userIds);
+
+    /**
+     * The host granted or took back the privilege to record
+     */
+    void onRecordingPrivilege(bool canRecord);
+
+    /**
+     * A full consent snapshot, polled or pushed
+     * @param body JSON with the consenting_users array
+     */
+    void onConsentResponse(const string& body);
+
+    /**
+     * @param consentingUsers everyone who consented
+     */
+    void onConsentUpdate(const vector<string>& consentingUsers);
+
+    /**
+     * Remind the participants without consent, in the chat or privately
+     */
+    void sendConsentReminder();
+
+    /**
+     * Flush and close the journal, on shutdown
+     */
+    void close();
+
+    bool recording() const;
+
+    /**
+     * @return true while the last snapshot is too old to rely on
+     */
+    bool stale() const;
+
+    /**
+     * @return consent of each participant, read by the recorders
+     */
+    const ConsentGate& gate() const;
+
+    const ParticipantRoster& participants() const;
+
+    /**
+     * @return breaker in front of the consent API, for the metrics
+     */
+    CircuitBreaker& breaker();
+};
+
+
+#endif //MEETING_SDK_LINUX_SAMPLE_CONSENTENGINE_H
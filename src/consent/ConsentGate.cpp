@@ -0,0 +1,93 @@
+#include "ConsentGate.h"
+
+ConsentGate::Table::Table(size_t capacity) :
+        mask(capacity - 1),
+        entries(new atomic<uint64_t>[capacity])
+{
+    for (size_t i = 0; i < capacity; ++i)
+        entries[i].store(0, memory_order_relaxed);
+}
+
+ConsentGate::ConsentGate() {
+    m_tables.emplace_back(new Table(minCapacity));
+    m_table.store(m_tables.back().get(), memory_order_release);
+}
+
+size_t ConsentGate::hash(uint32_t nodeId) {
+    // fibonacci hashing, node ids are often sequential
+    return static_cast<size_t>((nodeId * 0x9E3779B97F4A7C15ull) >> 32);
+}
+
+atomic<uint64_t>* ConsentGate::find(const Table& table, uint32_t nodeId) {
+    // tables are at most half full, so probing always ends at an empty slot
+    for (auto i = hash(nodeId);; ++i) {
+        auto& entry = table.entries[i & table.mask];
+        auto value = entry.load(memory_order_acquire);
+
+        if (!value || static_cast<uint32_t>(value >> 32) == nodeId)
+            return &entry;
+    }
+}
+
+void ConsentGate::set(uint32_t nodeId, bool allowed) {
+    auto* table = m_table.load(memory_order_relaxed);
+    auto* entry = find(*table, nodeId);
+    auto value = (static_cast<uint64_t>(nodeId) << 32) | occupied | (allowed ? granted : 0);
+
+    if (entry->load(memory_order_relaxed)) {
+        entry->store(value, memory_order_release);
+        return;
+    }
+
+    // unknown participants are denied already
+    if (!allowed) return;
+
+    if ((table->used + 1) * 2 > table->mask + 1) {
+        rebuild();
+        table = m_table.load(memory_order_relaxed);
+        entry = find(*table, nodeId);
+    }
+
+    entry->store(value, memory_order_release);
+    ++table->used;
+}
+
+void ConsentGate::rebuild() {
+    auto* old = m_table.load(memory_order_relaxed);
+
+    // revoked entries are left behind, only granted ones count toward the size
+    size_t live = 0;
+    for (size_t i = 0; i <= old->mask; ++i) {
+        if (old->entries[i].load(memory_order_relaxed) & granted)
+            ++live;
+    }
+
+    auto capacity = minCapacity;
+    while (capacity < (live + 1) * 4)
+        capacity <<= 1;
+
+    auto* table = new Table(capacity);
+    for (size_t i = 0; i <= old->mask; ++i) {
+        auto value = old->entries[i].load(memory_order_relaxed);
+        if (!(value & granted)) continue;
+
+        find(*table, static_cast<uint32_t>(value >> 32))->store(value, memory_order_relaxed);
+        ++table->used;
+    }
+
+    // readers may still be probing the old table, it is freed with the gate
+    m_tables.emplace_back(table);
+    m_table.store(table, memory_order_release);
+}
+
+bool ConsentGate::allowed(uint32_t nodeId) const {
+    if (m_suspended.load(memory_order_relaxed))
+        return false;
+
+    auto* table = m_table.load(memory_order_acquire);
+    return find(*table, nodeId)->load(memory_order_acquire) & granted;
+}
+
+void ConsentGate::suspend(bool suspended) {
+    m_suspended.store(suspended, memory_order_relaxed);
+}
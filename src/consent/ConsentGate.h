@@ -0,0 +1,71 @@
+#ifndef MEETING_SDK_LINUX_SAMPLE_CONSENTGATE_H
+#define MEETING_SDK_LINUX_SAMPLE_CONSENTGATE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+using namespace std;
+
+/**
+ * Lock-free node_id to consent lookup for the raw data delegates.
+ *
+ * The main loop thread is the only writer; SDK threads read it on every frame.
+ * Entries live in an open addressing table of atomic words, so a lookup is a
+ * hash and a few relaxed loads without locks or allocation. Revoked entries
+ * are dropped whenever the table is rebuilt, and replaced tables are kept
+ * until destruction so a reader never touches freed memory.
+ */
+class ConsentGate {
+    struct Table {
+        size_t mask;
+        size_t used = 0;
+        unique_ptr<atomic<uint64_t>[]> entries;
+
+        explicit Table(size_t capacity);
+    };
+
+    static constexpr uint64_t occupied = 1;
+    static constexpr uint64_t granted = 2;
+    static constexpr size_t minCapacity = 256;
+
+    atomic<Table*> m_table;
+    atomic<bool> m_suspended{false};
+    vector<unique_ptr<Table>> m_tables;
+
+    static size_t hash(uint32_t nodeId);
+    static atomic<uint64_t>* find(const Table& table, uint32_t nodeId);
+
+    void rebuild();
+
+public:
+    ConsentGate();
+
+    ConsentGate(const ConsentGate&) = delete;
+    ConsentGate& operator=(const ConsentGate&) = delete;
+
+    /**
+     * Grant or revoke recording of a participant, main loop thread only
+     * @param nodeId user id of the participant
+     * @param allowed true if the participant consented
+     */
+    void set(uint32_t nodeId, bool allowed);
+
+    /**
+     * Check whether a participant may be recorded, safe from any thread
+     * @param nodeId user id of the participant
+     * @return true only if consent was granted
+     */
+    bool allowed(uint32_t nodeId) const;
+
+    /**
+     * Deny everyone while consent cannot be trusted, without forgetting it
+     * @param suspended true to deny everyone
+     */
+    void suspend(bool suspended);
+};
+
+
+#endif //MEETING_SDK_LINUX_SAMPLE_CONSENTGATE_H
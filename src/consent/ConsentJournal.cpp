@@ -0,0 +1,270 @@
+#include "ConsentJournal.h"
+
+#include <cerrno>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "../util/Log.h"
+
+// record layout: checksum (4) | payload length (2) | kind (1) | payload
+static const size_t headerSize = 7;
+static const string magic("CJNL\x01\0\0\0", 8);
+
+ConsentJournal::~ConsentJournal() {
+    close();
+}
+
+bool ConsentJournal::open(const string& path) {
+    close();
+
+    m_path = path;
+    m_consenting.clear();
+    m_reminded.clear();
+
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0 && errno != ENOENT) {
+        Log::error("failed to read consent journal " + path + ": " + strerror(errno));
+        return false;
+    }
+
+    if (fd >= 0) {
+        int error = 0;
+        bool known = true;
+
+        struct stat st{};
+        if (fstat(fd, &st) < 0) {
+            error = errno;
+        } else if (st.st_size > 0) {
+            auto size = static_cast<size_t>(st.st_size);
+            auto* data = static_cast<const char*>(mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0));
+
+            if (data == MAP_FAILED) {
+                error = errno;
+            } else {
+                size_t valid = 0;
+                known = replay(data, size, valid);
+                munmap(const_cast<char*>(data), size);
+
+                if (known && valid < size)
+                    Log::info("consent journal " + path + " ends in a torn record, dropping it");
+            }
+        }
+        ::close(fd);
+
+        // compacting now would replace consent we could not read with nothing
+        if (error) {
+            Log::error("failed to read consent journal " + path + ": " + strerror(error));
+            return false;
+        }
+
+        if (!known && !moveAside())
+            return false;
+    }
+
+    if (!compact())
+        return false;
+
+    m_fd = ::open(path.c_str(), O_WRONLY | O_APPEND | O_CLOEXEC);
+    if (m_fd < 0) {
+        Log::error("failed to open consent journal " + path + ": " + strerror(errno));
+        return false;
+    }
+
+    return true;
+}
+
+void ConsentJournal::close() {
+    if (m_fd >= 0) {
+        ::close(m_fd);
+        m_fd = -1;
+    }
+}
+
+bool ConsentJournal::isOpen() const {
+    return m_fd >= 0;
+}
+
+bool ConsentJournal::replay(const char* data, size_t size, size_t& valid) {
+    if (size < magic.size() || memcmp(data, magic.data(), magic.size()) != 0)
+        return false;
+
+    size_t offset = magic.size();
+
+    while (size - offset >= headerSize) {
+        const char* header = data + offset;
+
+        uint32_t sum;
+        uint16_t length;
+        memcpy(&sum, header, sizeof(sum));
+        memcpy(&length, header + 4, sizeof(length));
+        auto kind = static_cast<Kind>(header[6]);
+
+        // a crash mid-append leaves a short or garbled last record
+        if (size - offset - headerSize < length || checksum(header + 4, 3 + length) != sum)
+            break;
+
+        string payload(header + headerSize, length);
+
+        if (kind == Grant) {
+            m_consenting.insert(payload);
+        } else if (kind == Revoke) {
+            m_consenting.erase(payload);
+        } else if (kind == Reminded && payload.size() >= sizeof(int64_t)) {
+            int64_t at;
+            memcpy(&at, payload.data(), sizeof(at));
+            m_reminded[payload.substr(sizeof(at))] = at;
+        }
+
+        offset += headerSize + length;
+    }
+
+    valid = offset;
+    return true;
+}
+
+bool ConsentJournal::moveAside() {
+    auto aside = m_path + ".unknown";
+    if (rename(m_path.c_str(), aside.c_str()) < 0) {
+        Log::error("failed to move aside consent journal " + m_path + ": " + strerror(errno));
+        return false;
+    }
+
+    Log::error("consent journal " + m_path + " has an unknown format, moved it to " + aside);
+    return true;
+}
+
+bool ConsentJournal::compact() {
+    string contents = magic;
+
+    for (const auto& name : m_consenting)
+        contents += record(Grant, name);
+
+    for (const auto& entry : m_reminded) {
+        string payload(sizeof(int64_t), '\0');
+        memcpy(&payload[0], &entry.second, sizeof(int64_t));
+        contents += record(Reminded, payload + entry.first);
+    }
+
+    // write the compacted journal aside and swap it in, so a crash keeps one of the two
+    auto temp = m_path + ".tmp";
+    int fd = ::open(temp.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        Log::error("failed to write consent journal " + temp + ": " + strerror(errno));
+        return false;
+    }
+
+    size_t written = 0;
+    while (written < contents.size()) {
+        auto n = write(fd, contents.data() + written, contents.size() - written);
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0) break;
+        written += n;
+    }
+
+    bool ok = written == contents.size() && fsync(fd) == 0;
+    ::close(fd);
+
+    if (!ok || rename(temp.c_str(), m_path.c_str()) < 0) {
+        Log::error("failed to compact consent journal " + m_path + ": " + strerror(errno));
+        unlink(temp.c_str());
+        return false;
+    }
+
+    // the rename is only durable once the directory entry is
+    return syncDir();
+}
+
+bool ConsentJournal::syncDir() {
+    auto slash = m_path.find_last_of('/');
+    auto dir = slash == string::npos ? string(".") : slash == 0 ? string("/") : m_path.substr(0, slash);
+
+    int fd = ::open(dir.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd < 0 || fsync(fd) < 0) {
+        Log::error("failed to sync consent journal directory " + dir + ": " + strerror(errno));
+        if (fd >= 0) ::close(fd);
+        return false;
+    }
+
+    ::close(fd);
+    return true;
+}
+
+void ConsentJournal::consent(const string& name, bool granted) {
+    append(granted ? Grant : Revoke, name);
+}
+
+void ConsentJournal::reminded(const string& name, int64_t at) {
+    string payload(sizeof(at), '\0');
+    memcpy(&payload[0], &at, sizeof(at));
+
+    append(Reminded, payload + name);
+}
+
+bool ConsentJournal::append(Kind kind, const string& payload) {
+    if (m_fd < 0 || payload.size() > UINT16_MAX) return false;
+
+    // one write per record, a killed process leaves whole records behind
+    auto data = record(kind, payload);
+    auto end = lseek(m_fd, 0, SEEK_END);
+    bool retried = false;
+
+    for (;;) {
+        auto n = write(m_fd, data.data(), data.size());
+        if (n == static_cast<ssize_t>(data.size())) return true;
+        if (n < 0 && errno == EINTR) continue;
+
+        if (n > 0) {
+            // replay stops at a torn record, everything appended after it would be lost
+            if (end < 0 || ftruncate(m_fd, end) < 0) {
+                Log::error("consent journal " + m_path + " is torn, no longer appending to it");
+                ::close(m_fd);
+                m_fd = -1;
+                return false;
+            }
+
+            if (!retried) {
+                retried = true;
+                continue;
+            }
+        }
+
+        Log::error("failed to append to consent journal " + m_path);
+        return false;
+    }
+}
+
+string ConsentJournal::record(Kind kind, const string& payload) {
+    string data(headerSize, '\0');
+
+    auto length = static_cast<uint16_t>(payload.size());
+    memcpy(&data[4], &length, sizeof(length));
+    data[6] = static_cast<char>(kind);
+    data += payload;
+
+    auto sum = checksum(data.data() + 4, data.size() - 4);
+    memcpy(&data[0], &sum, sizeof(sum));
+
+    return data;
+}
+
+// FNV-1a, enough to tell a torn tail from a whole record
+uint32_t ConsentJournal::checksum(const char* data, size_t size) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+const unordered_set<string>& ConsentJournal::consenting() const {
+    return m_consenting;
+}
+
+const unordered_map<string, int64_t>& ConsentJournal::lastReminded() const {
+    return m_reminded;
+}
@@ -0,0 +1,86 @@
+#ifndef MEETING_SDK_LINUX_SAMPLE_CONSENTJOURNAL_H
+#define MEETING_SDK_LINUX_SAMPLE_CONSENTJOURNAL_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+using namespace std;
+
+/**
+ * Append-only journal of the consent state of one meeting.
+ *
+ * Every consent change and reminder is appended as a checksummed record, so a
+ * bot restarted mid-meeting can pick up where it left off. On open the file is
+ * memory-mapped and replayed up to the first torn or corrupt record, then
+ * rewritten with one record per known user before appending resumes. A file
+ * that is not a journal at all is moved aside to <path>.unknown rather than
+ * overwritten.
+ */
+class ConsentJournal {
+    enum Kind : uint8_t {
+        Grant = 1,
+        Revoke = 2,
+        Reminded = 3
+    };
+
+    int m_fd = -1;
+    string m_path;
+
+    unordered_set<string> m_consenting;
+    unordered_map<string, int64_t> m_reminded;
+
+    bool replay(const char* data, size_t size, size_t& valid);
+    bool moveAside();
+    bool compact();
+    bool syncDir();
+    bool append(Kind kind, const string& payload);
+
+    static string record(Kind kind, const string& payload);
+    static uint32_t checksum(const char* data, size_t size);
+
+public:
+    ConsentJournal() = default;
+    ~ConsentJournal();
+
+    ConsentJournal(const ConsentJournal&) = delete;
+    ConsentJournal& operator=(const ConsentJournal&) = delete;
+
+    /**
+     * Load and compact the journal, creating it if it does not exist
+     * @param path journal file of the meeting
+     * @return true if the journal can be appended to
+     */
+    bool open(const string& path);
+
+    void close();
+    bool isOpen() const;
+
+    /**
+     * Record a consent change
+     * @param name display name of the user
+     * @param granted true if the user consented
+     */
+    void consent(const string& name, bool granted);
+
+    /**
+     * Record that a user was reminded
+     * @param name display name of the user
+     * @param at milliseconds since the epoch
+     */
+    void reminded(const string& name, int64_t at);
+
+    /**
+     * Users with consent when the journal was opened
+     */
+    const unordered_set<string>& consenting() const;
+
+    /**
+     * Last reminder per user when the journal was opened, in milliseconds since the epoch
+     */
+    const unordered_map<string, int64_t>& lastReminded() const;
+};
+
+
+#endif //MEETING_SDK_LINUX_SAMPLE_CONSENTJOURNAL_H
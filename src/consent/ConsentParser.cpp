@@ -0,0 +1,54 @@
+#include "ConsentParser.h"
+
+#include <json/json.h>
+
+bool ConsentParser::parse(const string& body, ConsentTracker& tracker) {
+    using namespace simdjson;
+
+    padded_string copy;
+    padded_string_view json;
+
+    if (body.capacity() - body.size() >= padding) {
+        json = padded_string_view(body.data(), body.size(), body.capacity());
+    } else {
+        copy = padded_string(body);
+        json = copy;
+    }
+
+    ondemand::document doc;
+    if (m_parser.iterate(json).get(doc))
+        return false;
+
+    ondemand::array users;
+    if (doc["consenting_users"].get_array().get(users))
+        return false;
+
+    tracker.begin();
+
+    for (auto user : users) {
+        string_view name;
+        if (user.get_string().get(name))
+            return false;
+
+        tracker.consent(name);
+    }
+
+    tracker.commit();
+    return true;
+}
+
+bool ConsentParser::parseDom(const string& body, ConsentTracker& tracker) {
+    Json::Value jsonData;
+    Json::Reader reader;
+    if (!reader.parse(body, jsonData))
+        return false;
+
+    auto consentingUsers = jsonData["consenting_users"];
+    vector<string> users;
+    for (const auto& user : consentingUsers) {
+        users.push_back(user.asString());
+    }
+
+    tracker.update(users);
+    return true;
+}
@@ -0,0 +1,42 @@
+#ifndef MEETING_SDK_LINUX_SAMPLE_CONSENTPARSER_H
+#define MEETING_SDK_LINUX_SAMPLE_CONSENTPARSER_H
+
+#include <string>
+
+#include <simdjson.h>
+
+#include "ConsentTracker.h"
+
+using namespace std;
+
+/**
+ * Reads consent API responses straight into a ConsentTracker.
+ *
+ * Uses the simdjson On-Demand API so consenting user names are handed to the
+ * tracker as string views into the response, without building a DOM.
+ */
+class ConsentParser {
+    simdjson::ondemand::parser m_parser;
+
+public:
+    /**
+     * Bytes of spare capacity a response needs to be parsed without a copy
+     */
+    static const size_t padding = simdjson::SIMDJSON_PADDING;
+
+    /**
+     * Parse a response and apply its consenting_users to the tracker
+     * @param body response body, copied once if it lacks padding capacity
+     * @param tracker consent tracker to update
+     * @return false if the response is not valid, the tracker is left untouched
+     */
+    bool parse(const string& body, ConsentTracker& tracker);
+
+    /**
+     * Same as parse() using a jsoncpp DOM, kept as a baseline for benchmarks
+     */
+    static bool parseDom(const string& body, ConsentTracker& tracker);
+};
+
+
+#endif //MEETING_SDK_LINUX_SAMPLE_CONSENTPARSER_H
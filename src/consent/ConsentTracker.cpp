@@ -0,0 +1,133 @@
+#include "ConsentTracker.h"
+
+void ConsentTracker::join(const string& name) {
+    ++m_present[name];
+    ++m_participants;
+
+    if (!hasConsent(name))
+        ++m_pending;
+
+    m_dirty = true;
+}
+
+void ConsentTracker::leave(const string& name) {
+    auto it = m_present.find(name);
+    if (it == m_present.end())
+        return;
+
+    if (--it->second == 0)
+        m_present.erase(it);
+
+    --m_participants;
+
+    if (!hasConsent(name))
+        --m_pending;
+
+    m_dirty = true;
+}
+
+void ConsentTracker::rename(const string& from, const string& to) {
+    if (from == to)
+        return;
+
+    leave(from);
+    join(to);
+}
+
+void ConsentTracker::begin() {
+    m_next.clear();
+}
+
+void ConsentTracker::consent(string_view name) {
+    m_next.emplace(name);
+}
+
+size_t ConsentTracker::commit() {
+    m_changes.clear();
+
+    for (const auto& name : m_next) {
+        if (m_consenting.count(name)) continue;
+
+        auto it = m_present.find(name);
+        if (it != m_present.end())
+            m_pending -= it->second;
+
+        m_changes.emplace_back(name, true);
+    }
+
+    for (const auto& name : m_consenting) {
+        if (m_next.count(name)) continue;
+
+        auto it = m_present.find(name);
+        if (it != m_present.end())
+            m_pending += it->second;
+
+        m_changes.emplace_back(name, false);
+    }
+
+    // keep the old buckets around for the next response
+    m_consenting.swap(m_next);
+    m_next.clear();
+
+    if (!m_changes.empty())
+        m_dirty = true;
+
+    return m_changes.size();
+}
+
+size_t ConsentTracker::update(const vector<string>& consentingUsers) {
+    begin();
+    for (const auto& user : consentingUsers)
+        consent(user);
+
+    return commit();
+}
+
+bool ConsentTracker::set(const string& name, bool granted) {
+    m_changes.clear();
+
+    if (granted == hasConsent(name))
+        return false;
+
+    if (granted)
+        m_consenting.insert(name);
+    else
+        m_consenting.erase(name);
+
+    auto it = m_present.find(name);
+    if (it != m_present.end()) {
+        if (granted) m_pending -= it->second;
+        else m_pending += it->second;
+    }
+
+    m_changes.emplace_back(name, granted);
+    m_dirty = true;
+
+    return true;
+}
+
+const vector<pair<string, bool>>& ConsentTracker::changes() const {
+    return m_changes;
+}
+
+bool ConsentTracker::takeDirty() {
+    auto dirty = m_dirty;
+    m_dirty = false;
+    return dirty;
+}
+
+bool ConsentTracker::hasConsent(const string& name) const {
+    return m_consenting.count(name) > 0;
+}
+
+bool ConsentTracker::allConsented() const {
+    return m_pending == 0;
+}
+
+size_t ConsentTracker::pending() const {
+    return m_pending;
+}
+
+size_t ConsentTracker::participants() const {
+    return m_participants;
+}
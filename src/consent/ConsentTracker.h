@@ -0,0 +1,102 @@
+#ifndef MEETING_SDK_LINUX_SAMPLE_CONSENTTRACKER_H
+#define MEETING_SDK_LINUX_SAMPLE_CONSENTTRACKER_H
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+/**
+ * Tracks which participants have consented to being recorded.
+ *
+ * The consent API reports display names, so participants are counted per name.
+ * Each response is diffed against the previous one and a running count of
+ * participants without consent is kept, so only changed names cost any work
+ * and allConsented() is O(1).
+ */
+class ConsentTracker {
+    unordered_set<string> m_consenting;
+    unordered_set<string> m_next;
+    unordered_map<string, size_t> m_present;
+    vector<pair<string, bool>> m_changes;
+
+    size_t m_participants = 0;
+    size_t m_pending = 0;
+    bool m_dirty = true;
+
+public:
+    /**
+     * A participant joined the meeting
+     * @param name display name of the participant
+     */
+    void join(const string& name);
+
+    /**
+     * A participant left the meeting
+     * @param name display name of the participant
+     */
+    void leave(const string& name);
+
+    /**
+     * A participant changed their display name
+     * @param from previous display name
+     * @param to new display name
+     */
+    void rename(const string& from, const string& to);
+
+    /**
+     * Start reading a new consent API response
+     */
+    void begin();
+
+    /**
+     * Add a consenting user from the response being read
+     * @param name display name of the consenting user
+     */
+    void consent(string_view name);
+
+    /**
+     * Diff the response being read against the previous one and apply it
+     * @return number of names whose consent changed
+     */
+    size_t commit();
+
+    /**
+     * Apply a complete consent API response
+     * @param consentingUsers display names of every consenting user
+     * @return number of names whose consent changed
+     */
+    size_t update(const vector<string>& consentingUsers);
+
+    /**
+     * Grant or revoke consent for a single user, e.g. from a webhook
+     * @param name display name of the user
+     * @param granted true if the user consented
+     * @return true if the consent of the user changed
+     */
+    bool set(const string& name, bool granted);
+
+    /**
+     * Names whose consent changed in the last commit or set, true if it was granted
+     */
+    const vector<pair<string, bool>>& changes() const;
+
+    /**
+     * Check and reset whether anything changed since the last call
+     * @return true if the roster or consent changed
+     */
+    bool takeDirty();
+
+    bool hasConsent(const string& name) const;
+    bool allConsented() const;
+
+    size_t pending() const;
+    size_t participants() const;
+};
+
+
+#endif //MEETING_SDK_LINUX_SAMPLE_CONSENTTRACKER_H
@@ -0,0 +1,89 @@
+#include "ParticipantRoster.h"
+
+#include <algorithm>
+
+bool ParticipantRoster::add(unsigned int userId, const string& name) {
+    // try_emplace only builds a node for new users, reconciliation re-adds everyone
+    auto result = m_users.try_emplace(userId, name);
+    if (result.second) {
+        index(userId, name);
+    } else if (result.first->second != name) {
+        unindex(userId, result.first->second);
+        result.first->second = name;
+        index(userId, name);
+    }
+
+    return result.second;
+}
+
+bool ParticipantRoster::remove(unsigned int userId) {
+    auto it = m_users.find(userId);
+    if (it == m_users.end())
+        return false;
+
+    unindex(userId, it->second);
+    m_users.erase(it);
+    return true;
+}
+
+bool ParticipantRoster::rename(unsigned int userId, const string& name) {
+    auto it = m_users.find(userId);
+    if (it == m_users.end() || it->second == name)
+        return false;
+
+    unindex(userId, it->second);
+    it->second = name;
+    index(userId, name);
+    return true;
+}
+
+bool ParticipantRoster::contains(unsigned int userId) const {
+    return m_users.count(userId) > 0;
+}
+
+const string* ParticipantRoster::name(unsigned int userId) const {
+    auto it = m_users.find(userId);
+    return it == m_users.end() ? nullptr : &it->second;
+}
+
+const vector<unsigned int>* ParticipantRoster::ids(const string& name) const {
+    auto it = m_ids.find(name);
+    return it == m_ids.end() ? nullptr : &it->second;
+}
+
+size_t ParticipantRoster::size() const {
+    return m_users.size();
+}
+
+bool ParticipantRoster::empty() const {
+    return m_users.empty();
+}
+
+void ParticipantRoster::clear() {
+    m_users.clear();
+    m_ids.clear();
+}
+
+ParticipantRoster::const_iterator ParticipantRoster::begin() const {
+    return m_users.begin();
+}
+
+ParticipantRoster::const_iterator ParticipantRoster::end() const {
+    return m_users.end();
+}
+
+void ParticipantRoster::index(unsigned int userId, const string& name) {
+    m_ids[name].push_back(userId);
+}
+
+// a name rarely has more than one user, the vector is scanned
+void ParticipantRoster::unindex(unsigned int userId, const string& name) {
+    auto it = m_ids.find(name);
+    if (it == m_ids.end()) return;
+
+    auto& ids = it->second;
+    ids.erase(std::remove(ids.begin(), ids.end(), userId), ids.end());
+
+    if (ids.empty())
+        m_ids.erase(it);
+}
@@ -0,0 +1,67 @@
+#ifndef MEETING_SDK_LINUX_SAMPLE_PARTICIPANTROSTER_H
+#define MEETING_SDK_LINUX_SAMPLE_PARTICIPANTROSTER_H
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace std;
+
+/**
+ * Participants currently in the meeting, keyed by user ID.
+ * Kept up to date incrementally from participants controller callbacks, with
+ * an index from display name to the users going by it so a consent change
+ * only touches the users it concerns.
+ */
+class ParticipantRoster {
+    unordered_map<unsigned int, string> m_users;
+    unordered_map<string, vector<unsigned int>> m_ids;
+
+    void index(unsigned int userId, const string& name);
+    void unindex(unsigned int userId, const string& name);
+
+public:
+    typedef unordered_map<unsigned int, string>::const_iterator const_iterator;
+
+    /**
+     * Add a user or update the name of an existing one
+     * @param userId user ID of the participant
+     * @param name display name of the participant
+     * @return true if the user was not already in the roster
+     */
+    bool add(unsigned int userId, const string& name);
+
+    /**
+     * Remove a user from the roster
+     * @param userId user ID of the participant
+     * @return true if the user was in the roster
+     */
+    bool remove(unsigned int userId);
+
+    /**
+     * Change the display name of a user already in the roster
+     * @param userId user ID of the participant
+     * @param name new display name
+     * @return true if the name changed
+     */
+    bool rename(unsigned int userId, const string& name);
+
+    bool contains(unsigned int userId) const;
+    const string* name(unsigned int userId) const;
+
+    /**
+     * @param name display name
+     * @return user IDs of the participants going by the name, nullptr if none
+     */
+    const vector<unsigned int>* ids(const string& name) const;
+
+    size_t size() const;
+    bool empty() const;
+    void clear();
+
+    const_iterator begin() const;
+    const_iterator end() const;
+};
+
+
+#endif //MEETING_SDK_LINUX_SAMPLE_PARTICIPANTROSTER_H
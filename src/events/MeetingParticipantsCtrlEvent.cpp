@@ -0,0 +1,28 @@
+#include "MeetingParticipantsCtrlEvent.h"
+
+void MeetingParticipantsCtrlEvent::onUserJoin(IList<unsigned int>* lstUserID, const zchar_t* strUserList) {
+    if (m_onUserJoin && lstUserID)
+        m_onUserJoin(lstUserID);
+}
+
+void MeetingParticipantsCtrlEvent::onUserLeft(IList<unsigned int>* lstUserID, const zchar_t* strUserList) {
+    if (m_onUserLeft && lstUserID)
+        m_onUserLeft(lstUserID);
+}
+
+void MeetingParticipantsCtrlEvent::onUserNamesChanged(IList<unsigned int>* lstUserID) {
+    if (m_onUserNamesChanged && lstUserID)
+        m_onUserNamesChanged(lstUserID);
+}
+
+void MeetingParticipantsCtrlEvent::setOnUserJoin(const function<void(IList<unsigned int>*)>& callback) {
+    m_onUserJoin = callback;
+}
+
+void MeetingParticipantsCtrlEvent::setOnUserLeft(const function<void(IList<unsigned int>*)>& callback) {
+    m_onUserLeft = callback;
+}
+
+void MeetingParticipantsCtrlEvent::setOnUserNamesChanged(const function<void(IList<unsigned int>*)>& callback) {
+    m_onUserNamesChanged = callback;
+}
@@ -0,0 +1,144 @@
+#ifndef MEETING_SDK_LINUX_SAMPLE_MEETINGPARTICIPANTSCTRLEVENT_H
+#define MEETING_SDK_LINUX_SAMPLE_MEETINGPARTICIPANTSCTRLEVENT_H
+
+#include <iostream>
+#include <functional>
+#include "meeting_service_components/meeting_participants_ctrl_interface.h"
+
+using namespace std;
+using namespace ZOOMSDK;
+
+class MeetingParticipantsCtrlEvent : public IMeetingParticipantsCtrlEvent {
+    function<void(IList<unsigned int>*)> m_onUserJoin;
+    function<void(IList<unsigned int>*)> m_onUserLeft;
+    function<void(IList<unsigned int>*)> m_onUserNamesChanged;
+
+public:
+    MeetingParticipantsCtrlEvent() {};
+    ~MeetingParticipantsCtrlEvent() {};
+
+    /**
+     * Fires when users join the meeting
+     * @param lstUserID list of user IDs that joined
+     * @param strUserList user list in JSON format, may be null
+     */
+    void onUserJoin(IList<unsigned int>* lstUserID, const zchar_t* strUserList = NULL) override;
+
+    /**
+     * Fires when users leave the meeting
+     * @param lstUserID list of user IDs that left
+     * @param strUserList user list in JSON format, may be null
+     */
+    void onUserLeft(IList<unsigned int>* lstUserID, const zchar_t* strUserList = NULL) override;
+
+    /**
+     * Fires when the host changes
+     * @param userId user ID of the new host
+     */
+    void onHostChangeNotification(unsigned int userId) override {};
+
+    /**
+     * Fires when a user raises or lowers their hand
+     * @param bLow true if the hand was lowered
+     * @param userid user ID of the user
+     */
+    void onLowOrRaiseHandStatusChanged(bool bLow, unsigned int userid) override {};
+
+    /**
+     * Fires when users change their display name
+     * @param lstUserID list of user IDs whose name changed
+     */
+    void onUserNamesChanged(IList<unsigned int>* lstUserID) override;
+
+    /**
+     * Fires when a co-host is assigned or revoked
+     * @param userId user ID of the co-host
+     * @param isCoHost true if the user is now a co-host
+     */
+    void onCoHostChangeNotification(unsigned int userId, bool isCoHost) override {};
+
+    /**
+     * Fires when the host key used to reclaim the host role is invalid
+     */
+    void onInvalidReclaimHostkey() override {};
+
+    /**
+     * Fires when all raised hands are lowered
+     */
+    void onAllHandsLowered() override {};
+
+    /**
+     * Fires when a user's local recording status changes
+     * @param user_id user ID of the recording user
+     * @param status local recording status
+     */
+    void onLocalRecordingStatusChanged(unsigned int user_id, RecordingStatus status) override {};
+
+    /**
+     * Fires when the host allows or disallows participants to rename themselves
+     * @param bAllow true if renaming is allowed
+     */
+    void onAllowParticipantsRenameNotification(bool bAllow) override {};
+
+    /**
+     * Fires when the host allows or disallows participants to unmute themselves
+     * @param bAllow true if unmuting is allowed
+     */
+    void onAllowParticipantsUnmuteSelfNotification(bool bAllow) override {};
+
+    /**
+     * Fires when the host allows or disallows participants to start video
+     * @param bAllow true if starting video is allowed
+     */
+    void onAllowParticipantsStartVideoNotification(bool bAllow) override {};
+
+    /**
+     * Fires when the host allows or disallows participants to share a whiteboard
+     * @param bAllow true if whiteboard sharing is allowed
+     */
+    void onAllowParticipantsShareWhiteBoardNotification(bool bAllow) override {};
+
+    /**
+     * Fires when the local recording privilege request setting changes
+     * @param status status of the local recording request privilege
+     */
+    void onRequestLocalRecordingPrivilegeChanged(LocalRecordingRequestPrivilegeStatus status) override {};
+
+    /**
+     * Fires when the host allows or disallows participants to request cloud recording
+     * @param bAllow true if requesting cloud recording is allowed
+     */
+    void onAllowParticipantsRequestCloudRecording(bool bAllow) override {};
+
+    /**
+     * Fires when a user's avatar path is updated
+     * @param userID user ID of the user
+     */
+    void onInMeetingUserAvatarPathUpdated(unsigned int userID) override {};
+
+    /**
+     * Fires when participant profile pictures are hidden or shown
+     * @param bHidden true if profile pictures are hidden
+     */
+    void onParticipantProfilePictureStatusChange(bool bHidden) override {};
+
+    /**
+     * Fires when focus mode is enabled or disabled
+     * @param bEnabled true if focus mode is enabled
+     */
+    void onFocusModeStateChanged(bool bEnabled) override {};
+
+    /**
+     * Fires when the focus mode share type changes
+     * @param type focus mode share type
+     */
+    void onFocusModeShareTypeChanged(FocusModeShareType type) override {};
+
+    /* Setters for Callbacks */
+    void setOnUserJoin(const function<void(IList<unsigned int>*)>& callback);
+    void setOnUserLeft(const function<void(IList<unsigned int>*)>& callback);
+    void setOnUserNamesChanged(const function<void(IList<unsigned int>*)>& callback);
+};
+
+
+#endif //MEETING_SDK_LINUX_SAMPLE_MEETINGPARTICIPANTSCTRLEVENT_H
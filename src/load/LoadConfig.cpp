@@ -0,0 +1,136 @@
+#include "LoadConfig.h"
+
+#include <iostream>
+#include <thread>
+
+LoadConfig::LoadConfig() : m_app(m_name, "zoomsdk-load")
+{
+    m_app.add_option("-n, --participants", m_participants, "Simulated participants, 1 to 1000")->capture_default_str();
+    m_app.add_option("-j, --threads", m_threads, "Producer threads, one per CPU up to the participants by default");
+    m_app.add_option("-d, --duration", m_duration, "Seconds to run")->capture_default_str();
+
+    m_app.add_flag("!--no-audio", m_audio, "Do not deliver audio");
+    m_app.add_flag("--mixed", m_mixed, "Record the mixed stream instead of one-way audio");
+    m_app.add_option("--sample-rate", m_sampleRate, "Audio sample rate")->capture_default_str();
+    m_app.add_option("--channels", m_channels, "Audio channels")->capture_default_str();
+    m_app.add_option("--audio-file", m_audioFile, "PCM fixture replayed for every participant, a tone by default");
+
+    m_app.add_flag("!--no-video", m_video, "Do not deliver video");
+    m_app.add_option("--width", m_width, "Video width")->capture_default_str();
+    m_app.add_option("--height", m_height, "Video height")->capture_default_str();
+    m_app.add_option("--fps", m_fps, "Video frames per second of every participant")->capture_default_str();
+    m_app.add_option("--video-file", m_videoFile, "I420 fixture replayed for every participant, bars by default");
+
+    m_app.add_option("--consenting", m_consenting, "Share of participants that consented, the rest is gated")->capture_default_str();
+    m_app.add_option("--dir", m_dir, "Directory the delegates write to")->capture_default_str();
+    m_app.add_option("--log", m_logFile, "File receiving the delegates' log lines")->capture_default_str();
+    m_app.add_option("-o, --results", m_resultsFile, "JSON file the results are written to")->capture_default_str();
+}
+
+int LoadConfig::read(int ac, char** av) {
+    try {
+        m_app.parse(ac, av);
+    } catch (const CLI::CallForHelp& e) {
+        exit(m_app.exit(e));
+    } catch (const CLI::ParseError& err) {
+        return m_app.exit(err);
+    }
+
+    if (m_participants < 1 || m_participants > 1000) {
+        cerr << "--participants must be between 1 and 1000" << endl;
+        return 1;
+    }
+
+    if (!m_audio && !m_video) {
+        cerr << "nothing to deliver with --no-audio and --no-video" << endl;
+        return 1;
+    }
+
+    if (m_duration <= 0 || m_fps <= 0 || m_sampleRate < 100 || m_channels < 1) {
+        cerr << "--duration, --fps, --sample-rate and --channels must be positive" << endl;
+        return 1;
+    }
+
+    if (m_width < 2 || m_height < 2 || m_width % 2 || m_height % 2) {
+        cerr << "--width and --height must be even" << endl;
+        return 1;
+    }
+
+    if (m_consenting < 0 || m_consenting > 1) {
+        cerr << "--consenting must be between 0 and 1" << endl;
+        return 1;
+    }
+
+    if (m_threads < 1) m_threads = max(1u, thread::hardware_concurrency());
+    m_threads = min(m_threads, m_participants);
+
+    return 0;
+}
+
+int LoadConfig::participants() const {
+    return m_participants;
+}
+
+int LoadConfig::threads() const {
+    return m_threads;
+}
+
+double LoadConfig::duration() const {
+    return m_duration;
+}
+
+bool LoadConfig::audio() const {
+    return m_audio;
+}
+
+bool LoadConfig::mixed() const {
+    return m_mixed;
+}
+
+unsigned int LoadConfig::sampleRate() const {
+    return m_sampleRate;
+}
+
+unsigned int LoadConfig::channels() const {
+    return m_channels;
+}
+
+const string& LoadConfig::audioFile() const {
+    return m_audioFile;
+}
+
+bool LoadConfig::video() const {
+    return m_video;
+}
+
+unsigned int LoadConfig::width() const {
+    return m_width;
+}
+
+unsigned int LoadConfig::height() const {
+    return m_height;
+}
+
+double LoadConfig::fps() const {
+    return m_fps;
+}
+
+const string& LoadConfig::videoFile() const {
+    return m_videoFile;
+}
+
+double LoadConfig::consenting() const {
+    return m_consenting;
+}
+
+const string& LoadConfig::dir() const {
+    return m_dir;
+}
+
+const string& LoadConfig::logFile() const {
+    return m_logFile;
+}
+
+const string& LoadConfig::resultsFile() const {
+    return m_resultsFile;
+}
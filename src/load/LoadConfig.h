@@ -0,0 +1,78 @@
+#ifndef MEETING_SDK_LINUX_SAMPLE_LOADCONFIG_H
+#define MEETING_SDK_LINUX_SAMPLE_LOADCONFIG_H
+
+#include <string>
+
+#include <CLI/CLI.hpp>
+
+using namespace std;
+
+class LoadConfig {
+    const string m_name = "Raw data load generator for the Zoom Meeting SDK bot";
+
+    CLI::App m_app;
+
+    int m_participants = 10;
+    int m_threads = 0;
+    double m_duration = 10;
+
+    bool m_audio = true;
+    bool m_mixed = false;
+    unsigned int m_sampleRate = 32000;
+    unsigned int m_channels = 1;
+    string m_audioFile;
+
+    bool m_video = true;
+    unsigned int m_width = 640;
+    unsigned int m_height = 360;
+    double m_fps = 30;
+    string m_videoFile;
+
+    double m_consenting = 1;
+    string m_dir = "out/load";
+    string m_logFile = "/dev/null";
+    string m_resultsFile = "load-results.json";
+
+public:
+    LoadConfig();
+
+    int read(int ac, char** av);
+
+    /**
+     * Simulated participants, each with a node_id of its own
+     */
+    int participants() const;
+
+    /**
+     * Producer threads the participants are spread over
+     */
+    int threads() const;
+    double duration() const;
+
+    bool audio() const;
+    bool mixed() const;
+    unsigned int sampleRate() const;
+    unsigned int channels() const;
+    const string& audioFile() const;
+
+    bool video() const;
+    unsigned int width() const;
+    unsigned int height() const;
+    double fps() const;
+    const string& videoFile() const;
+
+    /**
+     * Share of participants the consent gate lets through, 0 to 1
+     */
+    double consenting() const;
+    const string& dir() const;
+
+    /**
+     * Where the delegates' log lines go, they are written as in the bot
+     */
+    const string& logFile() const;
+    const string& resultsFile() const;
+};
+
+
+#endif //MEETING_SDK_LINUX_SAMPLE_LOADCONFIG_H
@@ -0,0 +1,306 @@
+#include "LoadGenerator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+
+#include <sys/resource.h>
+#include <time.h>
+
+using namespace chrono;
+
+// node_ids are handed out by the SDK like this
+static const uint32_t firstNodeId = 16778240;
+static const uint32_t nodeIdStep = 1024;
+
+static const nanoseconds audioPeriod = milliseconds(10);
+
+static nanoseconds threadCpu() {
+    timespec ts{};
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return seconds(ts.tv_sec) + nanoseconds(ts.tv_nsec);
+}
+
+static double micros(nanoseconds value) {
+    return duration<double, micro>(value).count();
+}
+
+static double toSeconds(const timeval& value) {
+    return static_cast<double>(value.tv_sec) + value.tv_usec / 1e6;
+}
+
+/**
+ * Move a schedule that fell a whole period behind up to now
+ * @return number of periods skipped
+ */
+static uint64_t skip(steady_clock::time_point& next, nanoseconds period, steady_clock::time_point now) {
+    if (now < next + period) return 0;
+
+    auto missed = static_cast<uint64_t>((now - next) / period);
+    next += period * missed;
+
+    return missed;
+}
+
+static Json::Value percentiles(const Histogram& histogram) {
+    auto snapshot = histogram.snapshot();
+
+    Json::Value value;
+    value["p50"] = micros(snapshot.percentile(0.5));
+    value["p90"] = micros(snapshot.percentile(0.9));
+    value["p99"] = micros(snapshot.percentile(0.99));
+    value["p999"] = micros(snapshot.percentile(0.999));
+    value["max"] = micros(snapshot.max);
+
+    return value;
+}
+
+LoadGenerator::LoadGenerator(const LoadConfig& config) : m_config(config)
+{
+    auto participants = static_cast<size_t>(config.participants());
+    auto consenting = static_cast<size_t>(lround(config.consenting() * static_cast<double>(participants)));
+
+    m_audio = make_unique<ZoomSDKAudioRawDataDelegate>(config.mixed());
+    m_audio->setDir(config.dir());
+    m_audio->setGate(&m_gate);
+    m_audio->setLedger(&m_ledger);
+    m_audio->setMetrics(&m_metrics);
+
+    m_producers.resize(config.threads());
+
+    for (size_t i = 0; i < participants; ++i) {
+        auto node = firstNodeId + static_cast<uint32_t>(i) * nodeIdStep;
+        m_gate.set(node, i < consenting);
+        m_producers[i % m_producers.size()].nodes.push_back(node);
+
+        // a renderer per participant, as with selective recording
+        stringstream filename;
+        filename << "node-" << node << ".yuv";
+
+        auto video = make_unique<ZoomSDKRendererDelegate>();
+        video->setDir(config.dir());
+        video->setFilename(filename.str());
+        video->setGate(&m_gate);
+        video->setLedger(&m_ledger);
+        video->setMetrics(&m_metrics);
+        m_video.push_back(std::move(video));
+    }
+}
+
+bool LoadGenerator::run() {
+    Fixture audio, video;
+
+    if (m_config.audioFile().empty()) audio.tone(m_config.sampleRate(), m_config.channels());
+    else if (!audio.load(m_config.audioFile(), FakeAudioRawData(m_config.sampleRate(), m_config.channels()).GetBufferLen())) {
+        Log::error("unable to read audio fixture " + m_config.audioFile());
+        return false;
+    }
+
+    if (m_config.videoFile().empty()) video.bars(m_config.width(), m_config.height());
+    else if (!video.load(m_config.videoFile(), FakeVideoRawData(m_config.width(), m_config.height()).GetBufferLen())) {
+        Log::error("unable to read video fixture " + m_config.videoFile());
+        return false;
+    }
+
+    // every producer starts at the same time, once all threads exist
+    auto start = steady_clock::now() + milliseconds(100);
+    auto end = start + duration_cast<nanoseconds>(duration<double>(m_config.duration()));
+
+    vector<thread> threads;
+    for (size_t i = 0; i < m_producers.size(); ++i) {
+        threads.emplace_back([this, i, audio, video, start, end]() {
+            produce(m_producers[i], i, audio, video, start, end);
+        });
+    }
+
+    for (auto& producer : threads)
+        producer.join();
+
+    m_elapsed = duration<double>(steady_clock::now() - start).count();
+    return true;
+}
+
+void LoadGenerator::produce(Producer& producer, size_t index, Fixture audio, Fixture video,
+                            steady_clock::time_point start, steady_clock::time_point end) {
+    FakeAudioRawData audioFrame(m_config.sampleRate(), m_config.channels());
+    FakeVideoRawData videoFrame(m_config.width(), m_config.height());
+
+    auto videoPeriod = duration_cast<nanoseconds>(duration<double>(1 / m_config.fps()));
+    auto count = static_cast<int64_t>(m_producers.size());
+
+    // participants do not send their frames in lockstep, neither do the producers
+    auto nextAudio = start + audioPeriod * static_cast<int64_t>(index) / count;
+    auto nextVideo = start + videoPeriod * static_cast<int64_t>(index) / count;
+
+    // the one mixed stream is delivered by the first producer
+    auto mixed = index == 0;
+    auto gated = static_cast<uint64_t>(count_if(producer.nodes.begin(), producer.nodes.end(), [this](uint32_t node) {
+        return !m_gate.allowed(node);
+    }));
+
+    uint64_t audioFrames = m_config.mixed() ? (mixed ? 1 : 0) : producer.nodes.size();
+    uint64_t audioGated = m_config.mixed() ? 0 : gated;
+
+    while (true) {
+        auto next = steady_clock::time_point::max();
+        if (m_config.audio()) next = min(next, nextAudio);
+        if (m_config.video()) next = min(next, nextVideo);
+        if (next >= end) break;
+
+        this_thread::sleep_until(next);
+
+        if (m_config.audio() && steady_clock::now() >= nextAudio) {
+            auto cpu = threadCpu();
+
+            if (mixed) {
+                audio.next(audioFrame.GetBuffer(), audioFrame.GetBufferLen());
+                m_audio->onMixedAudioRawDataReceived(&audioFrame);
+            }
+
+            for (auto node : producer.nodes) {
+                audio.next(audioFrame.GetBuffer(), audioFrame.GetBufferLen());
+                m_audio->onOneWayAudioRawDataReceived(&audioFrame, node);
+            }
+
+            producer.audioCpu += threadCpu() - cpu;
+            producer.audioOffered += audioFrames;
+            producer.audioGated += audioGated;
+
+            nextAudio += audioPeriod;
+            auto missed = skip(nextAudio, audioPeriod, steady_clock::now());
+            producer.audioOffered += missed * audioFrames;
+            producer.audioSkipped += missed * audioFrames;
+        }
+
+        if (m_config.video() && steady_clock::now() >= nextVideo) {
+            auto cpu = threadCpu();
+
+            // the participants of a producer share one frame per tick
+            video.next(videoFrame.GetBuffer(), videoFrame.GetBufferLen());
+            for (auto node : producer.nodes) {
+                videoFrame.setSourceId(node);
+                m_video[(node - firstNodeId) / nodeIdStep]->onRawDataFrameReceived(&videoFrame);
+            }
+
+            producer.videoCpu += threadCpu() - cpu;
+            producer.videoOffered += producer.nodes.size();
+            producer.videoGated += gated;
+
+            nextVideo += videoPeriod;
+            auto missed = skip(nextVideo, videoPeriod, steady_clock::now());
+            producer.videoOffered += missed * producer.nodes.size();
+            producer.videoSkipped += missed * producer.nodes.size();
+        }
+    }
+}
+
+Json::Value LoadGenerator::stream(const char* name, bool audio) {
+    uint64_t offered = 0, skipped = 0, gated = 0, written = 0, failed = 0;
+    nanoseconds cpu{0};
+
+    for (const auto& producer : m_producers) {
+        offered += audio ? producer.audioOffered : producer.videoOffered;
+        skipped += audio ? producer.audioSkipped : producer.videoSkipped;
+        gated += audio ? producer.audioGated : producer.videoGated;
+        cpu += audio ? producer.audioCpu : producer.videoCpu;
+    }
+
+    if (audio) {
+        written = m_audio->frames().written();
+        failed = m_audio->frames().dropped();
+    } else {
+        for (const auto& video : m_video) {
+            written += video->frames().written();
+            failed += video->frames().dropped();
+        }
+    }
+
+    uint64_t frameBytes = audio
+            ? FakeAudioRawData(m_config.sampleRate(), m_config.channels()).GetBufferLen()
+            : static_cast<uint64_t>(m_config.width()) * m_config.height() * 3 / 2;
+
+    auto delivered = offered - skipped;
+    auto dropped = skipped + failed;
+    auto latency = audio ? (m_config.mixed() ? Metrics::MixedAudio : Metrics::OneWayAudio) : Metrics::Video;
+
+    Json::Value value;
+    value["name"] = name;
+    value["offered"] = static_cast<Json::UInt64>(offered);
+    value["delivered"] = static_cast<Json::UInt64>(delivered);
+    value["written"] = static_cast<Json::UInt64>(written);
+    value["gated"] = static_cast<Json::UInt64>(gated);
+    value["skipped"] = static_cast<Json::UInt64>(skipped);
+    value["failed"] = static_cast<Json::UInt64>(failed);
+    value["dropped"] = static_cast<Json::UInt64>(dropped);
+    value["drop_rate"] = offered ? static_cast<double>(dropped) / static_cast<double>(offered) : 0.0;
+    value["frames_per_second"] = m_elapsed > 0 ? static_cast<double>(written) / m_elapsed : 0.0;
+    value["bytes_per_second"] = m_elapsed > 0 ? static_cast<double>(written * frameBytes) / m_elapsed : 0.0;
+    value["cpu_seconds"] = duration<double>(cpu).count();
+    value["cpu_percent"] = m_elapsed > 0 ? 100 * duration<double>(cpu).count() / m_elapsed : 0.0;
+    value["cpu_us_per_frame"] = delivered ? micros(cpu) / static_cast<double>(delivered) : 0.0;
+    value["callback_us"] = percentiles(m_metrics.callback(latency));
+    value["capture_to_disk_us"] = percentiles(m_metrics.captureToDisk(latency));
+
+    return value;
+}
+
+Json::Value LoadGenerator::results() {
+    Json::Value config;
+    config["participants"] = m_config.participants();
+    config["threads"] = m_config.threads();
+    config["duration"] = m_config.duration();
+    config["mixed"] = m_config.mixed();
+    config["sample_rate"] = m_config.sampleRate();
+    config["channels"] = m_config.channels();
+    config["width"] = m_config.width();
+    config["height"] = m_config.height();
+    config["fps"] = m_config.fps();
+    config["consenting"] = m_config.consenting();
+
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+
+    Json::Value process;
+    process["user_seconds"] = toSeconds(usage.ru_utime);
+    process["system_seconds"] = toSeconds(usage.ru_stime);
+    process["max_rss_kb"] = static_cast<Json::Int64>(usage.ru_maxrss);
+    process["voluntary_context_switches"] = static_cast<Json::Int64>(usage.ru_nvcsw);
+    process["involuntary_context_switches"] = static_cast<Json::Int64>(usage.ru_nivcsw);
+
+    Json::Value results;
+    results["timestamp"] = static_cast<Json::Int64>(duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count());
+    results["config"] = config;
+    results["elapsed_seconds"] = m_elapsed;
+    results["streams"] = Json::Value(Json::arrayValue);
+    if (m_config.audio()) results["streams"].append(stream("audio", true));
+    if (m_config.video()) results["streams"].append(stream("video", false));
+    results["process"] = process;
+
+    return results;
+}
+
+vector<string> LoadGenerator::summary() {
+    vector<string> lines;
+    auto json = results();
+
+    for (const auto& stream : json["streams"]) {
+        stringstream ss;
+        ss << fixed << setprecision(1)
+           << stream["name"].asString() << ": " << stream["written"].asUInt64() << " frames written at "
+           << stream["frames_per_second"].asDouble() << "/s, "
+           << stream["bytes_per_second"].asDouble() / 1e6 << " MB/s, "
+           << setprecision(3) << 100 * stream["drop_rate"].asDouble() << "% dropped, "
+           << setprecision(1) << stream["cpu_percent"].asDouble() << "% of a core ("
+           << stream["cpu_us_per_frame"].asDouble() << "us per frame), callback p50 "
+           << stream["callback_us"]["p50"].asDouble() << "us, p99 "
+           << stream["callback_us"]["p99"].asDouble() << "us, p999 "
+           << stream["callback_us"]["p999"].asDouble() << "us, max "
+           << stream["callback_us"]["max"].asDouble() << "us";
+
+        lines.push_back(ss.str());
+    }
+
+    return lines;
+}
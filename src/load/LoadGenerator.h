@@ -0,0 +1,100 @@
+#ifndef MEETING_SDK_LINUX_SAMPLE_LOADGENERATOR_H
+#define MEETING_SDK_LINUX_SAMPLE_LOADGENERATOR_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <json/json.h>
+
+#include "FakeRawData.h"
+#include "LoadConfig.h"
+#include "../consent/ConsentGate.h"
+#include "../metrics/Metrics.h"
+#include "../raw_record/SegmentLedger.h"
+#include "../raw_record/ZoomSDKAudioRawDataDelegate.h"
+#include "../raw_record/ZoomSDKRendererDelegate.h"
+
+using namespace std;
+
+/**
+ * Feeds the raw data delegates like the SDK would in a meeting with many
+ * participants, to find how many one bot records before it drops frames.
+ *
+ * Participants are spread over producer threads. Every 10 ms a producer
+ * hands one audio frame of each of its participants to the audio delegate,
+ * and at the video frame rate one I420 frame to each participant's renderer
+ * delegate, as the bot subscribes them with selective recording. The SDK does
+ * not queue frames for a slow bot, so a producer that falls a whole period
+ * behind skips the frames it missed and counts them as dropped.
+ */
+class LoadGenerator {
+public:
+    struct Producer {
+        vector<uint32_t> nodes;
+
+        // frames due, those skipped because the producer fell behind, and those gated
+        uint64_t audioOffered = 0;
+        uint64_t audioSkipped = 0;
+        uint64_t audioGated = 0;
+        uint64_t videoOffered = 0;
+        uint64_t videoSkipped = 0;
+        uint64_t videoGated = 0;
+
+        // CPU time of the producer's thread spent in each stream's callbacks
+        chrono::nanoseconds audioCpu{0};
+        chrono::nanoseconds videoCpu{0};
+    };
+
+private:
+    const LoadConfig& m_config;
+
+    ConsentGate m_gate;
+    SegmentLedger m_ledger;
+    Metrics m_metrics;
+
+    unique_ptr<ZoomSDKAudioRawDataDelegate> m_audio;
+    vector<unique_ptr<ZoomSDKRendererDelegate>> m_video;
+    vector<Producer> m_producers;
+
+    double m_elapsed = 0;
+
+    /**
+     * Deliver the frames of one producer's participants until the end
+     * @param audio fixture of this producer, fixtures keep their position
+     * @param video fixture of this producer
+     */
+    void produce(Producer& producer, size_t index, Fixture audio, Fixture video,
+                 chrono::steady_clock::time_point start, chrono::steady_clock::time_point end);
+
+    Json::Value stream(const char* name, bool audio);
+
+public:
+    explicit LoadGenerator(const LoadConfig& config);
+
+    LoadGenerator(const LoadGenerator&) = delete;
+    LoadGenerator& operator=(const LoadGenerator&) = delete;
+
+    /**
+     * Deliver frames for the configured duration
+     * @return false if a fixture could not be read
+     */
+    bool run();
+
+    /**
+     * @return configuration, per stream throughput, drops, CPU and latency
+     *         percentiles, and the resource usage of the process
+     */
+    Json::Value results();
+
+    /**
+     * @return one line per stream for the terminal
+     */
+    vector<string> summary();
+};
+
+
+#endif //MEETING_SDK_LINUX_SAMPLE_LOADGENERATOR_H
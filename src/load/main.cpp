@@ -0,0 +1,65 @@
+#include <fcntl.h>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <unistd.h>
+
+#include "LoadConfig.h"
+#include "LoadGenerator.h"
+
+int main(int argc, char** argv) {
+    LoadConfig config;
+    if (auto status = config.read(argc, argv))
+        return status;
+
+    error_code ec;
+    filesystem::create_directories(config.dir(), ec);
+    if (ec) {
+        cerr << "unable to create " << config.dir() << ": " << ec.message() << endl;
+        return 1;
+    }
+
+    auto log = open(config.logFile().c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    if (log < 0) {
+        cerr << "unable to open " << config.logFile() << endl;
+        return 1;
+    }
+
+    cout << "delivering " << (config.audio() ? "audio" : "") << (config.audio() && config.video() ? " and " : "")
+         << (config.video() ? "video" : "") << " of " << config.participants() << " participants from "
+         << config.threads() << " threads for " << config.duration() << "s" << endl;
+
+    LoadGenerator generator(config);
+
+    // the delegates log every frame as they do in the bot, to stdout synced with stdio
+    cout.flush();
+    auto console = dup(STDOUT_FILENO);
+    dup2(log, STDOUT_FILENO);
+
+    auto ran = generator.run();
+
+    cout.flush();
+    dup2(console, STDOUT_FILENO);
+    close(console);
+    close(log);
+
+    if (!ran) return 1;
+
+    for (const auto& line : generator.summary())
+        cout << line << endl;
+
+    Json::StreamWriterBuilder builder;
+    builder["indentation"] = "  ";
+
+    ofstream results(config.resultsFile(), ios::out | ios::trunc);
+    results << Json::writeString(builder, generator.results()) << "\n";
+    results.close();
+
+    if (!results) {
+        cerr << "failed to write results to " << config.resultsFile() << endl;
+        return 1;
+    }
+
+    cout << "results written to " << config.resultsFile() << endl;
+    return 0;
+}
@@ -1,5 +1,9 @@
 #include <csignal>
+#include <cstring>
+#include <sys/signalfd.h>
+#include <unistd.h>
 #include <glib.h>
+#include <glib-unix.h>
 #include "Config.h"
 #include "Zoom.h"
 
@@ -15,25 +19,57 @@ void onExit() {
     cout << "exiting..." << endl;
 }
 
+static int exitSignal = 0;
+
 /**
- * Callback fired when a signal is trapped
- * @param signal type of signal
+ * Callback fired on the main loop when a signal is read from the signalfd,
+ * so shutdown runs outside of signal context. SIGUSR1 writes the trace.
+ * @param fd signalfd
+ * @param condition readiness of the fd
+ * @param data main loop to quit
  */
-void onSignal(int signal) {
-    onExit();
-    _Exit(signal);
-}
+gboolean onSignal(gint fd, GIOCondition condition, gpointer data) {
+    signalfd_siginfo info{};
+    if (read(fd, &info, sizeof(info)) != sizeof(info))
+        return G_SOURCE_CONTINUE;
+
+    if (info.ssi_signo == SIGUSR1) {
+        Zoom::getInstance().writeTrace();
+        return G_SOURCE_CONTINUE;
+    }
 
+    exitSignal = static_cast<int>(info.ssi_signo);
+    Log::info(string("received ") + strsignal(exitSignal));
+
+    Zoom::getInstance().shutdown();
+    g_main_loop_quit(static_cast<GMainLoop*>(data));
+
+    return G_SOURCE_REMOVE;
+}
 
 /**
- * Callback for glib event loop
- * @param data event data
- * @return always TRUE
+ * Block SIGINT, SIGTERM and SIGUSR1 and receive them through a signalfd instead
+ * @return signalfd, -1 on failure
  */
-gboolean onTimeout (gpointer data) {
-    return TRUE;
+int watchSignals() {
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    sigaddset(&signals, SIGUSR1);
+
+    // threads the SDK starts later inherit the mask, so only the signalfd sees them
+    if (pthread_sigmask(SIG_BLOCK, &signals, nullptr) != 0)
+        return -1;
+
+    auto fd = signalfd(-1, &signals, SFD_NONBLOCK | SFD_CLOEXEC);
+    if (fd < 0)
+        pthread_sigmask(SIG_UNBLOCK, &signals, nullptr);
+
+    return fd;
 }
 
+
 /**
  * Run the Zoom Meeting Bot
  * @param argc argument count
@@ -44,9 +80,6 @@ SDKError run(int argc, char** argv) {
     SDKError err{SDKERR_SUCCESS};
     auto* zoom = &Zoom::getInstance();
 
-    signal(SIGINT, onSignal);
-    signal(SIGTERM, onSignal);
-
     atexit(onExit);
 
     // read the CLI and config.ini file
@@ -68,19 +101,28 @@ SDKError run(int argc, char** argv) {
 }
 
 int main(int argc, char **argv) {
+    // before the SDK starts any thread
+    auto signalFd = watchSignals();
+    if (signalFd < 0)
+        Log::error("failed to watch for signals, shutdown will not be graceful");
+
     // Run the Meeting Bot
     SDKError err = run(argc, argv);
 
     if (Zoom::hasError(err)) 
         return err;
 
-    // Use an event loop to receive callbacks
+    // Use an event loop to receive callbacks, it sleeps until a source has work
     GMainLoop* eventLoop;
     eventLoop = g_main_loop_new(NULL, FALSE);
-    g_timeout_add(100, onTimeout, eventLoop);
+
+    if (signalFd >= 0)
+        g_unix_fd_add(signalFd, G_IO_IN, onSignal, eventLoop);
+
     g_main_loop_run(eventLoop);
 
-    return err;
+    // the SDK is torn down by onExit()
+    return exitSignal ? 128 + exitSignal : err;
 }
 
 
@@ -0,0 +1,93 @@
+#include "CycleClock.h"
+
+#include <time.h>
+
+#if defined(__x86_64__)
+#include <cpuid.h>
+#include <x86intrin.h>
+#endif
+
+static int64_t monotonicRaw() {
+    timespec ts{};
+    clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+}
+
+namespace {
+    struct Scale {
+        bool tsc = false;
+        // nanoseconds per tick as a 32.32 fixed point number
+        uint64_t multiplier = 0;
+    };
+}
+
+#if defined(__x86_64__)
+static bool invariantTsc() {
+    unsigned int eax, ebx, ecx, edx;
+    if (!__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx)) return false;
+
+    // a TSC that keeps its rate across frequency changes and sleep states
+    return edx & (1u << 8);
+}
+#endif
+
+static Scale calibrate() {
+    Scale scale;
+
+#if defined(__x86_64__)
+    if (!invariantTsc()) return scale;
+
+    auto start = monotonicRaw();
+    auto startTicks = __rdtsc();
+
+    int64_t end;
+    do {
+        end = monotonicRaw();
+    } while (end - start < 10000000);
+
+    auto ticks = __rdtsc() - startTicks;
+    if (!ticks) return scale;
+
+    scale.multiplier = (static_cast<uint64_t>(end - start) << 32) / ticks;
+    scale.tsc = scale.multiplier != 0;
+#endif
+
+    return scale;
+}
+
+static const Scale& scale() {
+    static const Scale scale = calibrate();
+    return scale;
+}
+
+// calibrate while the program starts rather than in the first timed callback
+static const bool calibrated = scale().tsc;
+
+CycleClock::time_point CycleClock::now() noexcept {
+    return time_point(between(0, ticks()));
+}
+
+uint64_t CycleClock::ticks() noexcept {
+#if defined(__x86_64__)
+    if (scale().tsc) return __rdtsc();
+#endif
+
+    return static_cast<uint64_t>(monotonicRaw());
+}
+
+CycleClock::duration CycleClock::between(uint64_t start, uint64_t end) noexcept {
+    // signed, so a reading taken before start gives a negative duration
+    auto elapsed = static_cast<int64_t>(end - start);
+
+#if defined(__x86_64__)
+    auto& s = scale();
+    if (s.tsc)
+        return duration(static_cast<rep>((static_cast<__int128>(elapsed) * s.multiplier) >> 32));
+#endif
+
+    return duration(elapsed);
+}
+
+bool CycleClock::usesTsc() {
+    return scale().tsc;
+}
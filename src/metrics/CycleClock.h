@@ -0,0 +1,51 @@
+#ifndef MEETING_SDK_LINUX_SAMPLE_CYCLECLOCK_H
+#define MEETING_SDK_LINUX_SAMPLE_CYCLECLOCK_H
+
+#include <chrono>
+#include <cstdint>
+
+using namespace std;
+
+/**
+ * Monotonic clock for timing code on the hot path.
+ *
+ * On x86-64 with an invariant TSC it reads the time stamp counter, scaled to
+ * nanoseconds with a factor calibrated against CLOCK_MONOTONIC_RAW when the
+ * program starts. Elsewhere it reads CLOCK_MONOTONIC_RAW, which unlike the
+ * steady clock is never slewed by NTP. Time points are only comparable within
+ * one process.
+ *
+ * Code that times itself on every frame reads ticks() and scales only the
+ * difference with between(), which saves the multiplication at the start.
+ * A read still costs what the hardware charges for rdtsc, about 25ns on the
+ * virtual machines the bot was measured on (see MetricsBench).
+ */
+class CycleClock {
+public:
+    typedef chrono::nanoseconds duration;
+    typedef duration::rep rep;
+    typedef duration::period period;
+    typedef chrono::time_point<CycleClock> time_point;
+
+    static const bool is_steady = true;
+
+    static time_point now() noexcept;
+
+    /**
+     * @return unscaled reading, time stamp counter ticks or nanoseconds
+     */
+    static uint64_t ticks() noexcept;
+
+    /**
+     * @return time between two readings of ticks()
+     */
+    static duration between(uint64_t start, uint64_t end) noexcept;
+
+    /**
+     * @return true if now() reads the time stamp counter
+     */
+    static bool usesTsc();
+};
+
+
+#endif //MEETING_SDK_LINUX_SAMPLE_CYCLECLOCK_H
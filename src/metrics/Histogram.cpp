@@ -0,0 +1,130 @@
+#include "Histogram.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace chrono;
+
+const nanoseconds Histogram::bounds[BoundCount] = {
+        microseconds(10), microseconds(25), microseconds(50),
+        microseconds(100), microseconds(250), microseconds(500),
+        milliseconds(1), microseconds(2500), milliseconds(5),
+        milliseconds(10), milliseconds(25), milliseconds(50),
+        milliseconds(100), milliseconds(250), milliseconds(500),
+        seconds(1), milliseconds(2500), seconds(5),
+        seconds(10), seconds(30), seconds(60)
+};
+
+// ids index the shard cache of each thread, they are never reused
+static atomic<size_t> nextId{0};
+
+Histogram::Shard::Shard() {
+    for (auto& count : counts)
+        count.store(0, memory_order_relaxed);
+
+    sum.store(0, memory_order_relaxed);
+    max.store(0, memory_order_relaxed);
+}
+
+Histogram::Histogram() : m_id(nextId.fetch_add(1, memory_order_relaxed)) {}
+
+Histogram::Shard& Histogram::local() {
+    static thread_local vector<Shard*> shards;
+
+    if (m_id < shards.size() && shards[m_id])
+        return *shards[m_id];
+
+    // first observation of this histogram on this thread
+    auto* shard = new Shard();
+    {
+        lock_guard<mutex> lock(m_mutex);
+        m_shards.emplace_back(shard);
+    }
+
+    if (m_id >= shards.size())
+        shards.resize(m_id + 1, nullptr);
+
+    shards[m_id] = shard;
+    return *shard;
+}
+
+size_t Histogram::bucket(uint64_t value) {
+    if (value < SubBucketCount) return value;
+
+    int exponent = 63 - __builtin_clzll(value);
+    if (exponent > MaxExponent) return BucketCount - 1;
+
+    // the top bits below the leading one pick the bucket within its power of two
+    auto shift = exponent - SubBucketBits;
+    return (shift + 1) * SubBucketCount + ((value >> shift) & (SubBucketCount - 1));
+}
+
+uint64_t Histogram::lowest(size_t bucket) {
+    if (bucket < SubBucketCount) return bucket;
+
+    auto shift = bucket / SubBucketCount - 1;
+    return (SubBucketCount + bucket % SubBucketCount) << shift;
+}
+
+uint64_t Histogram::highest(size_t bucket) {
+    if (bucket < SubBucketCount) return bucket;
+
+    auto shift = bucket / SubBucketCount - 1;
+    return lowest(bucket) + (uint64_t(1) << shift) - 1;
+}
+
+void Histogram::observe(nanoseconds value) {
+    auto ns = max<int64_t>(value.count(), 0);
+
+    auto& shard = local();
+    auto& count = shard.counts[bucket(static_cast<uint64_t>(ns))];
+
+    // this thread is the only writer of its shard, no read-modify-write needed
+    count.store(count.load(memory_order_relaxed) + 1, memory_order_relaxed);
+    shard.sum.store(shard.sum.load(memory_order_relaxed) + ns, memory_order_relaxed);
+
+    if (ns > shard.max.load(memory_order_relaxed))
+        shard.max.store(ns, memory_order_relaxed);
+}
+
+Histogram::Snapshot Histogram::snapshot() const {
+    Snapshot snapshot;
+    lock_guard<mutex> lock(m_mutex);
+
+    for (const auto& shard : m_shards) {
+        for (size_t i = 0; i < BucketCount; ++i) {
+            auto count = shard->counts[i].load(memory_order_relaxed);
+            snapshot.counts[i] += count;
+            snapshot.count += count;
+        }
+
+        snapshot.sum += nanoseconds(shard->sum.load(memory_order_relaxed));
+        snapshot.max = std::max(snapshot.max, nanoseconds(shard->max.load(memory_order_relaxed)));
+    }
+
+    return snapshot;
+}
+
+nanoseconds Histogram::Snapshot::percentile(double quantile) const {
+    if (!count) return nanoseconds(0);
+
+    auto rank = std::max<uint64_t>(1, static_cast<uint64_t>(ceil(quantile * static_cast<double>(count))));
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < BucketCount; ++i) {
+        seen += counts[i];
+        if (seen >= rank)
+            return std::min(nanoseconds(highest(i)), max);
+    }
+
+    return max;
+}
+
+uint64_t Histogram::Snapshot::countAtMost(nanoseconds bound) const {
+    uint64_t total = 0;
+
+    for (size_t i = 0; i < BucketCount && lowest(i) <= static_cast<uint64_t>(bound.count()); ++i)
+        total += counts[i];
+
+    return total;
+}
@@ -0,0 +1,137 @@
+#ifndef MEETING_SDK_LINUX_SAMPLE_HISTOGRAM_H
+#define MEETING_SDK_LINUX_SAMPLE_HISTOGRAM_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "CycleClock.h"
+
+using namespace std;
+
+/**
+ * Latency histogram that SDK threads record into without contention.
+ *
+ * Buckets are log-linear like an HDR histogram: every power of two of
+ * nanoseconds is split into 32 buckets, so percentiles are exact to about 3%
+ * from a nanosecond up to the largest tracked value of about 18 minutes.
+ *
+ * Every thread that observes a value gets a shard of its own the first time,
+ * after that an observation is a few shifts and relaxed stores to memory no
+ * other thread writes. A snapshot merges the shards, so the counts it sees may
+ * be a few observations behind but never go backwards.
+ */
+class Histogram {
+public:
+    typedef CycleClock Clock;
+
+    static const int SubBucketBits = 5;
+    static const int MaxExponent = 40;
+    static const size_t SubBucketCount = size_t(1) << SubBucketBits;
+    static const size_t BucketCount = (MaxExponent - SubBucketBits + 2) * SubBucketCount;
+
+    // bounds of the buckets exported to Prometheus
+    static const size_t BoundCount = 21;
+    static const chrono::nanoseconds bounds[BoundCount];
+
+    struct Snapshot {
+        vector<uint64_t> counts = vector<uint64_t>(BucketCount);
+        uint64_t count = 0;
+        chrono::nanoseconds sum{0};
+        chrono::nanoseconds max{0};
+
+        /**
+         * @param quantile between 0 and 1, e.g. 0.99
+         * @return highest value within the bucket the quantile falls in
+         */
+        chrono::nanoseconds percentile(double quantile) const;
+
+        /**
+         * @return values at most the bound, to the width of a bucket
+         */
+        uint64_t countAtMost(chrono::nanoseconds bound) const;
+    };
+
+    /**
+     * Observes the time until it goes out of scope or stop(), nullptr to not time
+     */
+    class Timer {
+        Histogram* m_histogram;
+        uint64_t m_start;
+
+    public:
+        explicit Timer(Histogram* histogram) :
+                m_histogram(histogram),
+                m_start(histogram ? Clock::ticks() : 0) {}
+
+        ~Timer() {
+            if (m_histogram) m_histogram->observe(Clock::between(m_start, Clock::ticks()));
+        }
+
+        Timer(const Timer&) = delete;
+        Timer& operator=(const Timer&) = delete;
+
+        /**
+         * Observe the time until now, for callers that time more from the same reading
+         * @return Clock::ticks() read at the end, 0 when not timing
+         */
+        uint64_t stop() {
+            if (!m_histogram) return 0;
+
+            auto end = Clock::ticks();
+            m_histogram->observe(Clock::between(m_start, end));
+            m_histogram = nullptr;
+            return end;
+        }
+
+        /**
+         * @return Clock::ticks() read at the start, 0 when not timing
+         */
+        uint64_t started() const {
+            return m_start;
+        }
+    };
+
+private:
+    struct alignas(64) Shard {
+        atomic<uint64_t> counts[BucketCount];
+        atomic<int64_t> sum;
+        atomic<int64_t> max;
+
+        Shard();
+    };
+
+    size_t m_id;
+    mutable mutex m_mutex;
+    vector<unique_ptr<Shard>> m_shards;
+
+    Shard& local();
+
+    static size_t bucket(uint64_t value);
+    static uint64_t lowest(size_t bucket);
+    static uint64_t highest(size_t bucket);
+
+public:
+    Histogram();
+
+    Histogram(const Histogram&) = delete;
+    Histogram& operator=(const Histogram&) = delete;
+
+    /**
+     * Record a duration, safe from any thread
+     * @param value duration to record, negative values count as zero
+     */
+    void observe(chrono::nanoseconds value);
+
+    /**
+     * @return counts merged from every thread's shard
+     */
+    Snapshot snapshot() const;
+};
+
+
+#endif //MEETING_SDK_LINUX_SAMPLE_HISTOGRAM_H
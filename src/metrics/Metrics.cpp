@@ -0,0 +1,156 @@
+#include "Metrics.h"
+
+#include <iomanip>
+#include <sstream>
+
+static const char* prefix = "zoomsdk_";
+
+static double seconds(chrono::nanoseconds value) {
+    return chrono::duration<double>(value).count();
+}
+
+static string format(chrono::nanoseconds value) {
+    stringstream ss;
+    ss << fixed << setprecision(1);
+
+    if (value >= chrono::seconds(1)) ss << seconds(value) << "s";
+    else if (value >= chrono::milliseconds(1)) ss << value.count() / 1e6 << "ms";
+    else if (value >= chrono::microseconds(1)) ss << value.count() / 1e3 << "us";
+    else ss << setprecision(0) << value.count() << "ns";
+
+    return ss.str();
+}
+
+static void header(stringstream& ss, const string& name, const char* type, const char* help) {
+    ss << "# HELP " << prefix << name << " " << help << "\n";
+    ss << "# TYPE " << prefix << name << " " << type << "\n";
+}
+
+static void histogram(stringstream& ss, const string& name, const string& labels, const Histogram& histogram) {
+    auto snapshot = histogram.snapshot();
+    auto separator = labels.empty() ? "" : ",";
+
+    // prometheus buckets are cumulative and coarser than the histogram's own
+    for (auto bound : Histogram::bounds) {
+        ss << prefix << name << "_bucket{" << labels << separator
+           << "le=\"" << seconds(bound) << "\"} " << snapshot.countAtMost(bound) << "\n";
+    }
+
+    ss << prefix << name << "_bucket{" << labels << separator << "le=\"+Inf\"} " << snapshot.count << "\n";
+
+    auto braced = labels.empty() ? "" : "{" + labels + "}";
+    ss << prefix << name << "_sum" << braced << " " << seconds(snapshot.sum) << "\n";
+    ss << prefix << name << "_count" << braced << " " << snapshot.count << "\n";
+}
+
+Histogram& Metrics::callback(Stream stream) {
+    return m_callback[stream];
+}
+
+Histogram& Metrics::write(Stream stream) {
+    return m_write[stream];
+}
+
+Histogram& Metrics::captureToDisk(Stream stream) {
+    return m_captureToDisk[stream];
+}
+
+Histogram& Metrics::consentToRecord() {
+    return m_consentToRecord;
+}
+
+void Metrics::setStats(const StatsSegment::Slot* stats) {
+    m_stats = stats;
+}
+
+void Metrics::addBreaker(const string& name, const CircuitBreaker* breaker) {
+    m_breakers.emplace_back(name, breaker);
+}
+
+string Metrics::scrape() const {
+    stringstream ss;
+    ss << setprecision(9);
+
+    const struct {
+        const char* name;
+        const char* help;
+        const Histogram* histograms;
+    } perStream[] = {
+            {"callback_duration_seconds", "Time spent in raw data callbacks", m_callback},
+            {"write_duration_seconds", "Time spent writing a frame to its file", m_write},
+            {"capture_to_disk_seconds", "Time from a frame being handed over by the SDK until it is in its file", m_captureToDisk},
+    };
+
+    for (const auto& metric : perStream) {
+        header(ss, metric.name, "histogram", metric.help);
+
+        for (int i = 0; i < StreamCount; ++i) {
+            string labels = "stream=\"" + string(name(static_cast<Stream>(i))) + "\"";
+            histogram(ss, metric.name, labels, metric.histograms[i]);
+        }
+    }
+
+    header(ss, "consent_to_record_seconds", "histogram", "Time from the last consent change until recording starts");
+    histogram(ss, "consent_to_record_seconds", "", m_consentToRecord);
+
+    if (m_stats) {
+        for (uint32_t i = 0; i < StatsSegment::StatCount; ++i) {
+            auto stat = static_cast<StatsSegment::Stat>(i);
+            auto gauge = StatsSegment::isGauge(stat);
+            string name = string(StatsSegment::name(stat)) + (gauge ? "" : "_total");
+
+            header(ss, name, gauge ? "gauge" : "counter", "Shared memory stat, see zoomsdk-stat");
+            ss << prefix << name << " " << m_stats->get(stat) << "\n";
+        }
+    }
+
+    if (!m_breakers.empty()) {
+        header(ss, "circuit_breaker_state", "gauge", "Circuit breaker state, 0 closed, 1 open, 2 half-open");
+        for (const auto& breaker : m_breakers)
+            ss << prefix << "circuit_breaker_state{breaker=\"" << breaker.first << "\"} " << breaker.second->state() << "\n";
+
+        header(ss, "circuit_breaker_transitions_total", "counter", "Times a circuit breaker entered a state");
+        for (const auto& breaker : m_breakers) {
+            for (auto state : {CircuitBreaker::Closed, CircuitBreaker::Open, CircuitBreaker::HalfOpen}) {
+                ss << prefix << "circuit_breaker_transitions_total{breaker=\"" << breaker.first
+                   << "\",to=\"" << CircuitBreaker::name(state) << "\"} " << breaker.second->transitions(state) << "\n";
+            }
+        }
+    }
+
+    return ss.str();
+}
+
+vector<string> Metrics::summary() const {
+    vector<string> lines;
+
+    for (int i = 0; i < StreamCount; ++i) {
+        const pair<const char*, const Histogram*> histograms[] = {{"callback", &m_callback[i]}, {"write", &m_write[i]}};
+
+        for (const auto& entry : histograms) {
+            auto snapshot = entry.second->snapshot();
+            if (!snapshot.count) continue;
+
+            stringstream ss;
+            ss << name(static_cast<Stream>(i)) << " " << entry.first << " latency of " << snapshot.count << " frames:"
+               << " p50 " << format(snapshot.percentile(0.5))
+               << ", p99 " << format(snapshot.percentile(0.99))
+               << ", p999 " << format(snapshot.percentile(0.999))
+               << ", max " << format(snapshot.max);
+
+            lines.push_back(ss.str());
+        }
+    }
+
+    return lines;
+}
+
+const char* Metrics::name(Stream stream) {
+    switch (stream) {
+        case MixedAudio: return "mixed_audio";
+        case OneWayAudio: return "one_way_audio";
+        case Video: return "video";
+        case StreamCount: break;
+    }
+    return "unknown";
+}
@@ -0,0 +1,93 @@
+#ifndef MEETING_SDK_LINUX_SAMPLE_METRICS_H
+#define MEETING_SDK_LINUX_SAMPLE_METRICS_H
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Histogram.h"
+#include "../net/CircuitBreaker.h"
+#include "../stats/StatsSegment.h"
+
+using namespace std;
+
+/**
+ * Metrics of the bot in the Prometheus text exposition format.
+ *
+ * Latency histograms are recorded by the raw data delegates and the consent
+ * flow; the counters and gauges already kept in the shared memory stats and
+ * the circuit breakers are read when scraped rather than counted twice.
+ */
+class Metrics {
+public:
+    enum Stream {
+        MixedAudio,
+        OneWayAudio,
+        Video,
+        StreamCount
+    };
+
+private:
+    Histogram m_callback[StreamCount];
+    Histogram m_write[StreamCount];
+    Histogram m_captureToDisk[StreamCount];
+    Histogram m_consentToRecord;
+
+    const StatsSegment::Slot* m_stats = nullptr;
+    vector<pair<string, const CircuitBreaker*>> m_breakers;
+
+public:
+    Metrics() {};
+
+    Metrics(const Metrics&) = delete;
+    Metrics& operator=(const Metrics&) = delete;
+
+    /**
+     * Time spent in a raw data callback, including frames that are not written
+     */
+    Histogram& callback(Stream stream);
+
+    /**
+     * Time spent writing a frame to its file
+     */
+    Histogram& write(Stream stream);
+
+    /**
+     * Time from the SDK handing over a frame until it is in its file
+     */
+    Histogram& captureToDisk(Stream stream);
+
+    /**
+     * Time from the last consent change until recording starts
+     */
+    Histogram& consentToRecord();
+
+    /**
+     * Export the counters and gauges of the shared memory stats
+     * @param stats slot of this bot, nullptr to not export them
+     */
+    void setStats(const StatsSegment::Slot* stats);
+
+    /**
+     * Export the state and transitions of a circuit breaker, main loop thread only
+     * @param name value of the breaker label
+     * @param breaker must outlive the metrics
+     */
+    void addBreaker(const string& name, const CircuitBreaker* breaker);
+
+    /**
+     * @return every metric in the Prometheus text format, main loop thread only
+     */
+    string scrape() const;
+
+    /**
+     * @return one line of percentiles for each stream's callbacks and writes
+     *         since the start, streams without frames are left out
+     */
+    vector<string> summary() const;
+
+    static const char* name(Stream stream);
+};
+
+
+#endif //MEETING_SDK_LINUX_SAMPLE_METRICS_H
@@ -0,0 +1,202 @@
+#include "Tracer.h"
+
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <vector>
+
+#include <sys/syscall.h>
+#include <unistd.h>
+
+atomic<bool> Tracer::s_enabled{false};
+
+namespace {
+    struct Event {
+        atomic<const char*> name;
+        atomic<const char*> category;
+        atomic<int64_t> start;
+        atomic<int64_t> end;
+        atomic<char> phase;
+    };
+
+    struct Buffer {
+        static const size_t capacity = 1 << 15;
+
+        pid_t tid;
+        unique_ptr<Event[]> events{new Event[capacity]};
+
+        // claimed before a slot is written, committed after
+        atomic<uint64_t> claimed{0};
+        atomic<uint64_t> committed{0};
+    };
+
+    struct Copy {
+        char phase;
+        const char* name;
+        const char* category;
+        int64_t start;
+        int64_t end;
+        pid_t tid;
+    };
+
+    // buffers outlive their threads, so spans of exited threads are still dumped
+    mutex buffersMutex;
+    vector<unique_ptr<Buffer>> buffers;
+}
+
+static Buffer& local() {
+    static thread_local Buffer* buffer = nullptr;
+    if (buffer) return *buffer;
+
+    buffer = new Buffer();
+    buffer->tid = static_cast<pid_t>(syscall(SYS_gettid));
+
+    lock_guard<mutex> lock(buffersMutex);
+    buffers.emplace_back(buffer);
+
+    return *buffer;
+}
+
+void Tracer::enable(bool enabled) {
+    s_enabled.store(enabled, memory_order_relaxed);
+}
+
+void Tracer::complete(const char* name, const char* category, Clock::time_point start) {
+    record('X', name, category, start);
+}
+
+void Tracer::async(const char* name, const char* category, Clock::time_point start) {
+    record('b', name, category, start);
+}
+
+void Tracer::record(char phase, const char* name, const char* category, Clock::time_point start) {
+    if (!enabled()) return;
+
+    auto end = Clock::now();
+    auto& buffer = local();
+
+    // the owning thread is the only writer, a dump notices slots claimed while it copies
+    auto index = buffer.claimed.load(memory_order_relaxed);
+    buffer.claimed.store(index + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+
+    auto& event = buffer.events[index & (Buffer::capacity - 1)];
+    event.phase.store(phase, memory_order_relaxed);
+    event.name.store(name, memory_order_relaxed);
+    event.category.store(category, memory_order_relaxed);
+    event.start.store(start.time_since_epoch().count(), memory_order_relaxed);
+    event.end.store(end.time_since_epoch().count(), memory_order_relaxed);
+
+    buffer.committed.store(index + 1, memory_order_release);
+}
+
+static vector<Copy> collect() {
+    vector<Copy> copies;
+    lock_guard<mutex> lock(buffersMutex);
+
+    for (const auto& buffer : buffers) {
+        auto committed = buffer->committed.load(memory_order_acquire);
+        auto first = committed > Buffer::capacity ? committed - Buffer::capacity : 0;
+        auto begin = copies.size();
+
+        for (auto i = first; i < committed; ++i) {
+            const auto& event = buffer->events[i & (Buffer::capacity - 1)];
+            copies.push_back({
+                    event.phase.load(memory_order_relaxed),
+                    event.name.load(memory_order_relaxed),
+                    event.category.load(memory_order_relaxed),
+                    event.start.load(memory_order_relaxed),
+                    event.end.load(memory_order_relaxed),
+                    buffer->tid
+            });
+        }
+
+        // slots the thread claimed meanwhile may have been copied half written
+        atomic_thread_fence(memory_order_acquire);
+        auto claimed = buffer->claimed.load(memory_order_relaxed);
+        auto overwritten = claimed > Buffer::capacity ? claimed - Buffer::capacity : 0;
+
+        if (overwritten > first)
+            copies.erase(copies.begin() + begin, copies.begin() + begin + min(overwritten, committed) - first);
+    }
+
+    return copies;
+}
+
+static string threadName(pid_t tid) {
+    ifstream comm("/proc/self/task/" + to_string(tid) + "/comm");
+
+    string name;
+    if (!getline(comm, name) || name.empty())
+        name = "thread " + to_string(tid);
+
+    // comm is chosen by whoever started the thread
+    string escaped;
+    for (char c : name) {
+        if (c == '"' || c == '\\') escaped += '\\';
+        if (static_cast<unsigned char>(c) >= 0x20) escaped += c;
+    }
+
+    return escaped;
+}
+
+static string format(const vector<Copy>& copies) {
+    auto pid = getpid();
+
+    stringstream ss;
+    ss << fixed << setprecision(3);
+    ss << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    ss << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << pid << ",\"args\":{\"name\":\"zoomsdk\"}}";
+
+    vector<pid_t> named;
+    {
+        lock_guard<mutex> lock(buffersMutex);
+        for (const auto& buffer : buffers)
+            named.push_back(buffer->tid);
+    }
+
+    for (auto tid : named) {
+        ss << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << pid << ",\"tid\":" << tid
+           << ",\"args\":{\"name\":\"" << threadName(tid) << "\"}}";
+    }
+
+    // microseconds, the unit of the format
+    uint64_t id = 0;
+    for (const auto& copy : copies) {
+        auto start = copy.start / 1000.0;
+        auto end = copy.end / 1000.0;
+
+        string common = string("\"name\":\"") + copy.name + "\",\"cat\":\"" + copy.category + "\",\"pid\":"
+                + to_string(pid) + ",\"tid\":" + to_string(copy.tid);
+
+        if (copy.phase == 'X') {
+            ss << ",\n{" << common << ",\"ph\":\"X\",\"ts\":" << start << ",\"dur\":" << end - start << "}";
+            continue;
+        }
+
+        ++id;
+        ss << ",\n{" << common << ",\"ph\":\"b\",\"id\":" << id << ",\"ts\":" << start << "}";
+        ss << ",\n{" << common << ",\"ph\":\"e\",\"id\":" << id << ",\"ts\":" << end << "}";
+    }
+
+    ss << "\n]}\n";
+    return ss.str();
+}
+
+string Tracer::json() {
+    return format(collect());
+}
+
+long Tracer::write(const string& path) {
+    auto copies = collect();
+
+    ofstream file(path, ios::out | ios::trunc);
+    if (!file.is_open()) return -1;
+
+    file << format(copies);
+    file.close();
+
+    return file.fail() ? -1 : static_cast<long>(copies.size());
+}
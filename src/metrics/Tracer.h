@@ -0,0 +1,90 @@
+#ifndef MEETING_SDK_LINUX_SAMPLE_TRACER_H
+#define MEETING_SDK_LINUX_SAMPLE_TRACER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "CycleClock.h"
+
+using namespace std;
+
+/**
+ * Timeline of the bot in the Chrome Trace Event format, opened in Perfetto
+ * or chrome://tracing.
+ *
+ * Every thread records into a ring buffer of its own, so recording a span is
+ * a few relaxed stores without locks; once a buffer is full the oldest spans
+ * are overwritten. A dump copies every buffer while the threads keep
+ * recording and leaves out spans overwritten while it was copied. Names and
+ * categories must be string literals, only their pointers are stored.
+ */
+class Tracer {
+public:
+    typedef CycleClock Clock;
+
+    /**
+     * Records a span from its construction until it goes out of scope
+     */
+    class Scope {
+        const char* m_name;
+        const char* m_category;
+        Clock::time_point m_start;
+
+    public:
+        Scope(const char* name, const char* category) :
+                m_name(name),
+                m_category(category),
+                m_start(enabled() ? Clock::now() : Clock::time_point()) {}
+
+        ~Scope() {
+            if (m_start != Clock::time_point()) complete(m_name, m_category, m_start);
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    };
+
+    /**
+     * Start or stop recording, spans already recorded are kept
+     */
+    static void enable(bool enabled);
+
+    static bool enabled() {
+        return s_enabled.load(memory_order_relaxed);
+    }
+
+    /**
+     * Record a span on the calling thread's track
+     * @param start when the span began, from Clock::now()
+     */
+    static void complete(const char* name, const char* category, Clock::time_point start);
+
+    /**
+     * Record a span that began elsewhere, e.g. a request and its callback,
+     * shown on a track of its own since it need not nest with others
+     * @param start when the span began, from Clock::now()
+     */
+    static void async(const char* name, const char* category, Clock::time_point start);
+
+    /**
+     * @return every recorded span as a Chrome trace JSON document
+     */
+    static string json();
+
+    /**
+     * Write the trace to a file
+     * @param path file to replace
+     * @return number of spans written, -1 if the file could not be written
+     */
+    static long write(const string& path);
+
+private:
+    static atomic<bool> s_enabled;
+
+    static void record(char phase, const char* name, const char* category, Clock::time_point start);
+};
+
+
+#endif //MEETING_SDK_LINUX_SAMPLE_TRACER_H
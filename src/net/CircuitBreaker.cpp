@@ -0,0 +1,85 @@
+#include "CircuitBreaker.h"
+
+#include <algorithm>
+
+#include "../util/Log.h"
+
+CircuitBreaker::CircuitBreaker(const string& name) : m_name(name)
+{
+
+}
+
+void CircuitBreaker::configure(int threshold, chrono::milliseconds cooldown) {
+    m_threshold = max(threshold, 1);
+    m_cooldown = cooldown;
+}
+
+void CircuitBreaker::setOnTransition(const Listener& callback) {
+    m_onTransition = callback;
+}
+
+bool CircuitBreaker::allow() {
+    if (m_state == Open && chrono::steady_clock::now() - m_openedAt >= m_cooldown)
+        transition(HalfOpen);
+
+    if (m_state == Open)
+        return false;
+
+    if (m_state == HalfOpen) {
+        // only one probe at a time
+        if (m_probing) return false;
+        m_probing = true;
+    }
+
+    return true;
+}
+
+void CircuitBreaker::success() {
+    m_failures = 0;
+    m_probing = false;
+
+    if (m_state != Closed)
+        transition(Closed);
+}
+
+void CircuitBreaker::failure() {
+    m_probing = false;
+
+    if (m_state == HalfOpen || ++m_failures >= m_threshold) {
+        m_failures = 0;
+        m_openedAt = chrono::steady_clock::now();
+
+        if (m_state != Open)
+            transition(Open);
+    }
+}
+
+CircuitBreaker::State CircuitBreaker::state() const {
+    return m_state;
+}
+
+uint64_t CircuitBreaker::transitions(State to) const {
+    return m_transitions[to];
+}
+
+const char* CircuitBreaker::name(State state) {
+    switch (state) {
+        case Closed: return "closed";
+        case Open: return "open";
+        case HalfOpen: return "half-open";
+    }
+    return "unknown";
+}
+
+void CircuitBreaker::transition(State to) {
+    auto from = m_state;
+    m_state = to;
+    ++m_transitions[to];
+
+    auto message = m_name + " circuit " + name(from) + " -> " + name(to);
+    if (to == Open) Log::error(message);
+    else Log::info(message);
+
+    if (m_onTransition)
+        m_onTransition(from, to);
+}
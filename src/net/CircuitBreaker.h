@@ -0,0 +1,79 @@
+#ifndef MEETING_SDK_LINUX_SAMPLE_CIRCUITBREAKER_H
+#define MEETING_SDK_LINUX_SAMPLE_CIRCUITBREAKER_H
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+using namespace std;
+
+/**
+ * Circuit breaker for calls to an unreliable service.
+ *
+ * After a number of consecutive failures the circuit opens and calls are
+ * refused for a cooldown. Then a single probe is let through (half-open):
+ * its success closes the circuit, its failure opens it for another cooldown.
+ */
+class CircuitBreaker {
+public:
+    enum State {
+        Closed,
+        Open,
+        HalfOpen
+    };
+
+    typedef function<void(State from, State to)> Listener;
+
+private:
+    string m_name;
+    State m_state = Closed;
+
+    int m_threshold = 5;
+    chrono::milliseconds m_cooldown = chrono::seconds(30);
+
+    int m_failures = 0;
+    bool m_probing = false;
+    chrono::steady_clock::time_point m_openedAt;
+
+    uint64_t m_transitions[3] = {};
+    Listener m_onTransition;
+
+    void transition(State to);
+
+public:
+    /**
+     * @param name service name used in log messages
+     */
+    explicit CircuitBreaker(const string& name);
+
+    /**
+     * @param threshold consecutive failures that open the circuit
+     * @param cooldown time the circuit stays open before a probe
+     */
+    void configure(int threshold, chrono::milliseconds cooldown);
+
+    void setOnTransition(const Listener& callback);
+
+    /**
+     * Ask whether a call may be made now, a call that is allowed must report
+     * its outcome with success() or failure()
+     * @return false while the circuit is open or a probe is in flight
+     */
+    bool allow();
+
+    void success();
+    void failure();
+
+    State state() const;
+
+    /**
+     * @return number of times the circuit entered the given state
+     */
+    uint64_t transitions(State to) const;
+
+    static const char* name(State state);
+};
+
+
+#endif //MEETING_SDK_LINUX_SAMPLE_CIRCUITBREAKER_H
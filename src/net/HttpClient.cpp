@@ -0,0 +1,442 @@
+#include "HttpClient.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <sstream>
+
+#include <fcntl.h>
+#include <netdb.h>
+#include <unistd.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+
+#include <glib-unix.h>
+#include <ada.h>
+
+HttpClient::~HttpClient() {
+    clearTimer(m_backoff);
+    clearTimer(m_timer);
+    closeSocket();
+}
+
+bool HttpClient::setUrl(const string& url) {
+    auto parsed = ada::parse<ada::url>(url);
+    if (!parsed || parsed->get_protocol() != "http:")
+        return false;
+
+    m_host = string(parsed->get_hostname());
+    if (!parsed->get_port().empty())
+        m_port = string(parsed->get_port());
+
+    m_path = string(parsed->get_pathname()) + string(parsed->get_search());
+    if (m_path.empty())
+        m_path = "/";
+
+    m_addrLen = 0;
+    closeSocket();
+
+    return !m_host.empty();
+}
+
+void HttpClient::setTimeout(chrono::milliseconds timeout) {
+    m_timeout = timeout;
+}
+
+void HttpClient::setRetries(int retries, chrono::milliseconds backoffBase) {
+    m_maxRetries = max(retries, 0);
+    m_backoffBase = backoffBase;
+}
+
+void HttpClient::get(const Callback& callback) {
+    request("GET", m_path, "", callback);
+}
+
+void HttpClient::request(const string& method, const string& target, const string& body, const Callback& callback) {
+    m_queue.push_back({method, target, body, callback});
+    next();
+}
+
+bool HttpClient::busy() const {
+    return m_inFlight || !m_queue.empty();
+}
+
+bool HttpClient::resolve(string& error) {
+    if (m_addrLen) return true;
+
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+
+    // resolved once per origin, the consent API is expected to be local
+    addrinfo* result = nullptr;
+    auto rc = getaddrinfo(m_host.c_str(), m_port.c_str(), &hints, &result);
+    if (rc != 0 || !result) {
+        error = "failed to resolve " + m_host + ": " + gai_strerror(rc);
+        return false;
+    }
+
+    memcpy(&m_addr, result->ai_addr, result->ai_addrlen);
+    m_addrLen = result->ai_addrlen;
+    freeaddrinfo(result);
+
+    return true;
+}
+
+void HttpClient::next() {
+    if (m_inFlight || m_backoff || m_queue.empty())
+        return;
+
+    m_inFlight = true;
+
+    auto& req = m_queue.front();
+
+    stringstream out;
+    out << req.method << " " << req.target << " HTTP/1.1\r\n"
+        << "Host: " << m_host << ":" << m_port << "\r\n"
+        << "Connection: keep-alive\r\n"
+        << "Accept: application/json\r\n";
+
+    if (!req.body.empty())
+        out << "Content-Type: application/json\r\n";
+
+    if (!req.body.empty() || req.method == "POST" || req.method == "PUT")
+        out << "Content-Length: " << req.body.size() << "\r\n";
+
+    out << "\r\n" << req.body;
+
+    m_out = out.str();
+    m_written = 0;
+    m_in.clear();
+
+    m_timer = g_timeout_add(m_timeout.count(), onTimer, this);
+
+    if (m_fd < 0) {
+        m_reused = false;
+        connect();
+    } else {
+        m_reused = true;
+        send();
+    }
+}
+
+void HttpClient::connect() {
+    string error;
+    if (!resolve(error))
+        return fail(error);
+
+    m_fd = socket(m_addr.ss_family, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (m_fd < 0)
+        return fail(string("failed to create socket: ") + strerror(errno));
+
+    int one = 1;
+    setsockopt(m_fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+    auto rc = ::connect(m_fd, reinterpret_cast<sockaddr*>(&m_addr), m_addrLen);
+    if (rc < 0 && errno != EINPROGRESS)
+        return fail(string("failed to connect: ") + strerror(errno));
+
+    m_connecting = rc < 0;
+    if (m_connecting)
+        watch(G_IO_OUT);
+    else
+        send();
+}
+
+void HttpClient::send() {
+    while (m_written < m_out.size()) {
+        auto n = ::send(m_fd, m_out.data() + m_written, m_out.size() - m_written, MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK)
+                return watch(G_IO_OUT);
+
+            if (errno == EINTR) continue;
+
+            return fail(string("failed to send request: ") + strerror(errno));
+        }
+        m_written += n;
+    }
+
+    watch(G_IO_IN);
+}
+
+void HttpClient::watch(GIOCondition condition) {
+    clearWatch();
+    m_watch = g_unix_fd_add(m_fd, static_cast<GIOCondition>(condition | G_IO_ERR | G_IO_HUP), onSocket, this);
+}
+
+void HttpClient::clearWatch() {
+    if (m_watch) {
+        g_source_remove(m_watch);
+        m_watch = 0;
+    }
+}
+
+void HttpClient::clearTimer(guint& timer) {
+    if (timer) {
+        g_source_remove(timer);
+        timer = 0;
+    }
+}
+
+void HttpClient::closeSocket() {
+    clearWatch();
+
+    if (m_fd >= 0) {
+        close(m_fd);
+        m_fd = -1;
+    }
+
+    m_connecting = false;
+}
+
+void HttpClient::onWritable() {
+    if (m_connecting) {
+        int err = 0;
+        socklen_t len = sizeof(err);
+        getsockopt(m_fd, SOL_SOCKET, SO_ERROR, &err, &len);
+        if (err)
+            return fail(string("failed to connect: ") + strerror(err));
+
+        m_connecting = false;
+    }
+
+    send();
+}
+
+void HttpClient::onReadable() {
+    char buffer[16384];
+    bool eof = false;
+
+    for (;;) {
+        auto n = recv(m_fd, buffer, sizeof(buffer), 0);
+        if (n > 0) {
+            m_in.append(buffer, n);
+            continue;
+        }
+
+        if (n == 0) {
+            eof = true;
+            break;
+        }
+
+        if (errno == EAGAIN || errno == EWOULDBLOCK)
+            break;
+
+        if (errno == EINTR) continue;
+
+        return fail(string("failed to read response: ") + strerror(errno));
+    }
+
+    Response response;
+    bool keepAlive = true;
+
+    if (parse(response, eof, keepAlive)) {
+        if (!response.error.empty())
+            return fail(response.error);
+
+        return finish(response, keepAlive && !eof);
+    }
+
+    if (eof)
+        fail(m_in.empty() ? "connection closed by server" : "truncated response");
+}
+
+void HttpClient::onTimeout() {
+    m_timer = 0;
+
+    stringstream ss;
+    ss << "request timed out after " << m_timeout.count() << "ms";
+    fail(ss.str());
+}
+
+static string lowercase(string s) {
+    transform(s.begin(), s.end(), s.begin(), [](unsigned char c) { return tolower(c); });
+    return s;
+}
+
+bool HttpClient::parse(Response& response, bool eof, bool& keepAlive) {
+    auto headerEnd = m_in.find("\r\n\r\n");
+    if (headerEnd == string::npos)
+        return false;
+
+    istringstream headers(m_in.substr(0, headerEnd));
+    string line, version;
+
+    getline(headers, line);
+    istringstream statusLine(line);
+    statusLine >> version >> response.status;
+    if (version.rfind("HTTP/1.", 0) != 0 || !response.status) {
+        response.error = "malformed status line";
+        keepAlive = false;
+        return true;
+    }
+
+    keepAlive = version == "HTTP/1.1";
+
+    long contentLength = -1;
+    bool chunked = false;
+
+    while (getline(headers, line)) {
+        if (!line.empty() && line.back() == '\r')
+            line.pop_back();
+
+        auto colon = line.find(':');
+        if (colon == string::npos) continue;
+
+        auto name = lowercase(line.substr(0, colon));
+        auto value = lowercase(line.substr(colon + 1));
+
+        if (name == "content-length") {
+            contentLength = strtol(value.c_str(), nullptr, 10);
+        } else if (name == "transfer-encoding") {
+            chunked = value.find("chunked") != string::npos;
+        } else if (name == "connection") {
+            if (value.find("close") != string::npos) keepAlive = false;
+            else if (value.find("keep-alive") != string::npos) keepAlive = true;
+        }
+    }
+
+    auto bodyStart = headerEnd + 4;
+
+    if (chunked) {
+        auto pos = bodyStart;
+        string body;
+
+        for (;;) {
+            auto lineEnd = m_in.find("\r\n", pos);
+            if (lineEnd == string::npos) return false;
+
+            // the size may be followed by chunk extensions, but not by anything else
+            char* sizeEnd = nullptr;
+            auto size = strtoul(m_in.c_str() + pos, &sizeEnd, 16);
+            if (sizeEnd == m_in.c_str() + pos || (*sizeEnd != ';' && *sizeEnd != '\r')) {
+                response.error = "malformed chunk size";
+                keepAlive = false;
+                return true;
+            }
+
+            pos = lineEnd + 2;
+
+            if (size == 0) {
+                // no trailers are expected, just the terminating CRLF
+                if (m_in.size() < pos + 2) return false;
+                break;
+            }
+
+            if (m_in.size() < pos + size + 2) return false;
+
+            if (m_in.compare(pos + size, 2, "\r\n") != 0) {
+                response.error = "chunk longer than its size";
+                keepAlive = false;
+                return true;
+            }
+
+            body.append(m_in, pos, size);
+            pos += size + 2;
+        }
+
+        response.body = move(body);
+        return true;
+    }
+
+    if (contentLength >= 0) {
+        if (m_in.size() - bodyStart < static_cast<size_t>(contentLength))
+            return false;
+
+        response.body = m_in.substr(bodyStart, contentLength);
+        return true;
+    }
+
+    // no framing, the body runs until the server closes the connection
+    if (!eof) return false;
+
+    keepAlive = false;
+    response.body = m_in.substr(bodyStart);
+    return true;
+}
+
+void HttpClient::finish(const Response& response, bool keepAlive) {
+    clearTimer(m_timer);
+
+    if (keepAlive)
+        clearWatch();
+    else
+        closeSocket();
+
+    auto req = move(m_queue.front());
+    m_queue.pop_front();
+    m_inFlight = false;
+
+    if (req.callback)
+        req.callback(response);
+
+    next();
+}
+
+void HttpClient::fail(const string& error) {
+    // a reused connection that fails before any response bytes, other than by
+    // timing out (onTimeout clears m_timer), was most likely closed while idle
+    auto reusedIdle = m_reused && m_in.empty() && m_timer;
+
+    clearTimer(m_timer);
+    closeSocket();
+    m_inFlight = false;
+
+    if (m_queue.empty())
+        return;
+
+    // the server dropped an idle keep-alive connection, reconnect right away
+    if (reusedIdle)
+        return next();
+
+    auto& req = m_queue.front();
+
+    if (req.attempt < m_maxRetries) {
+        ++req.attempt;
+
+        auto base = m_backoffBase.count() << (req.attempt - 1);
+        uniform_int_distribution<long> jitter(base / 2, base + base / 2);
+        m_backoff = g_timeout_add(jitter(m_rng), onBackoff, this);
+        return;
+    }
+
+    Response response;
+    response.error = error;
+
+    auto failed = move(req);
+    m_queue.pop_front();
+
+    if (failed.callback)
+        failed.callback(response);
+
+    next();
+}
+
+gboolean HttpClient::onSocket(gint fd, GIOCondition condition, gpointer data) {
+    auto* self = static_cast<HttpClient*>(data);
+    auto id = self->m_watch;
+
+    if (condition & G_IO_IN)
+        self->onReadable();
+    else if (condition & G_IO_OUT)
+        self->onWritable();
+    else if (condition & (G_IO_ERR | G_IO_HUP))
+        self->fail("connection error");
+
+    // the handlers above replace or remove the watch when they are done with it
+    return self->m_watch == id ? G_SOURCE_CONTINUE : G_SOURCE_REMOVE;
+}
+
+gboolean HttpClient::onTimer(gpointer data) {
+    static_cast<HttpClient*>(data)->onTimeout();
+    return G_SOURCE_REMOVE;
+}
+
+gboolean HttpClient::onBackoff(gpointer data) {
+    auto* self = static_cast<HttpClient*>(data);
+    self->m_backoff = 0;
+    self->next();
+
+    return G_SOURCE_REMOVE;
+}
@@ -0,0 +1,132 @@
+#ifndef MEETING_SDK_LINUX_SAMPLE_HTTPCLIENT_H
+#define MEETING_SDK_LINUX_SAMPLE_HTTPCLIENT_H
+
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <random>
+#include <string>
+
+#include <sys/socket.h>
+#include <glib.h>
+
+using namespace std;
+
+/**
+ * Minimal asynchronous HTTP/1.1 client driven by the glib main loop.
+ *
+ * Requests to a single origin are sent one at a time over a persistent
+ * keep-alive connection. Each attempt is bounded by a timeout and failed
+ * attempts are retried with jittered exponential backoff.
+ * All callbacks run on the thread running the glib main loop.
+ */
+class HttpClient {
+public:
+    struct Response {
+        int status = 0;
+        string body;
+        string error;
+
+        bool ok() const { return error.empty() && status >= 200 && status < 300; }
+    };
+
+    typedef function<void(const Response&)> Callback;
+
+private:
+    struct Request {
+        string method;
+        string target;
+        string body;
+        Callback callback;
+        int attempt = 0;
+    };
+
+    string m_host;
+    string m_port = "80";
+    string m_path = "/";
+
+    sockaddr_storage m_addr{};
+    socklen_t m_addrLen = 0;
+
+    int m_fd = -1;
+    bool m_connecting = false;
+    bool m_reused = false;
+
+    guint m_watch = 0;
+    guint m_timer = 0;
+    guint m_backoff = 0;
+
+    deque<Request> m_queue;
+    bool m_inFlight = false;
+
+    string m_out;
+    size_t m_written = 0;
+    string m_in;
+
+    chrono::milliseconds m_timeout{5000};
+    chrono::milliseconds m_backoffBase{250};
+    int m_maxRetries = 3;
+
+    mt19937 m_rng{random_device{}()};
+
+    bool resolve(string& error);
+    void next();
+    void connect();
+    void send();
+    void watch(GIOCondition condition);
+    void clearWatch();
+    void clearTimer(guint& timer);
+    void closeSocket();
+
+    void onWritable();
+    void onReadable();
+    void onTimeout();
+
+    bool parse(Response& response, bool eof, bool& keepAlive);
+    void finish(const Response& response, bool keepAlive);
+    void fail(const string& error);
+
+    static gboolean onSocket(gint fd, GIOCondition condition, gpointer data);
+    static gboolean onTimer(gpointer data);
+    static gboolean onBackoff(gpointer data);
+
+public:
+    HttpClient() {};
+    ~HttpClient();
+
+    HttpClient(const HttpClient&) = delete;
+    HttpClient& operator=(const HttpClient&) = delete;
+
+    /**
+     * Set the origin and default path requests are sent to
+     * @param url http:// URL of the API
+     * @return false if the URL cannot be used
+     */
+    bool setUrl(const string& url);
+
+    void setTimeout(chrono::milliseconds timeout);
+    void setRetries(int retries, chrono::milliseconds backoffBase);
+
+    /**
+     * Queue a GET request for the path of the configured URL
+     * @param callback fires on the main loop with the response or an error
+     */
+    void get(const Callback& callback);
+
+    /**
+     * Queue a request
+     * @param method HTTP method
+     * @param target request target, e.g. /consent?id=1
+     * @param body request body, sent as application/json when not empty
+     * @param callback fires on the main loop with the response or an error
+     */
+    void request(const string& method, const string& target, const string& body, const Callback& callback);
+
+    /**
+     * @return true if a request is in flight or queued
+     */
+    bool busy() const;
+};
+
+
+#endif //MEETING_SDK_LINUX_SAMPLE_HTTPCLIENT_H
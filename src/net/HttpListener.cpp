@@ -0,0 +1,386 @@
+#include "HttpListener.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <sstream>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <glib-unix.h>
+
+#include "../util/Log.h"
+
+HttpListener::HttpListener(TimerWheel& timers) :
+        m_timers(timers)
+{
+
+}
+
+HttpListener::~HttpListener() {
+    stop();
+}
+
+void HttpListener::route(const string& method, const string& path, const Handler& handler) {
+    m_routes[{method, path}] = handler;
+}
+
+void HttpListener::setIdleTimeout(chrono::milliseconds timeout) {
+    m_idleTimeout = timeout;
+}
+
+bool HttpListener::listen(const string& host, int port) {
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+
+    if (inet_pton(AF_INET, host.c_str(), &addr.sin_addr) != 1) {
+        Log::error("invalid listen address " + host);
+        return false;
+    }
+
+    m_listenFd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (m_listenFd < 0) {
+        Log::error(string("failed to create listen socket: ") + strerror(errno));
+        return false;
+    }
+
+    int one = 1;
+    setsockopt(m_listenFd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+    if (bind(m_listenFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 || ::listen(m_listenFd, SOMAXCONN) < 0) {
+        stringstream ss;
+        ss << "failed to listen on " << host << ":" << port << ": " << strerror(errno);
+        Log::error(ss.str());
+        stop();
+        return false;
+    }
+
+    m_epollFd = epoll_create1(EPOLL_CLOEXEC);
+
+    epoll_event ev{};
+    ev.events = EPOLLIN;
+    ev.data.fd = m_listenFd;
+    epoll_ctl(m_epollFd, EPOLL_CTL_ADD, m_listenFd, &ev);
+
+    m_watch = g_unix_fd_add(m_epollFd, G_IO_IN, onEpoll, this);
+
+    return true;
+}
+
+void HttpListener::stop() {
+    if (m_watch) {
+        g_source_remove(m_watch);
+        m_watch = 0;
+    }
+
+    m_timers.cancel(m_idleTimer);
+    m_idleTimer = 0;
+
+    for (auto& entry : m_connections)
+        close(entry.first);
+    m_connections.clear();
+
+    if (m_listenFd >= 0) {
+        close(m_listenFd);
+        m_listenFd = -1;
+    }
+
+    if (m_epollFd >= 0) {
+        close(m_epollFd);
+        m_epollFd = -1;
+    }
+}
+
+bool HttpListener::listening() const {
+    return m_listenFd >= 0;
+}
+
+int HttpListener::port() const {
+    sockaddr_in addr{};
+    socklen_t length = sizeof(addr);
+
+    if (m_listenFd < 0 || getsockname(m_listenFd, reinterpret_cast<sockaddr*>(&addr), &length) < 0)
+        return 0;
+
+    return ntohs(addr.sin_port);
+}
+
+void HttpListener::onEvents() {
+    epoll_event events[64];
+
+    int n;
+    while ((n = epoll_wait(m_epollFd, events, 64, 0)) > 0) {
+        for (int i = 0; i < n; ++i) {
+            auto fd = events[i].data.fd;
+
+            if (fd == m_listenFd) {
+                accept();
+                continue;
+            }
+
+            if (events[i].events & (EPOLLERR | EPOLLHUP)) {
+                drop(fd);
+                continue;
+            }
+
+            if (events[i].events & EPOLLIN)
+                read(fd);
+
+            if (events[i].events & EPOLLOUT && m_connections.count(fd))
+                write(fd);
+        }
+
+        if (n < 64) break;
+    }
+}
+
+void HttpListener::accept() {
+    for (;;) {
+        int fd = accept4(m_listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) return;
+
+        epoll_event ev{};
+        ev.events = EPOLLIN | EPOLLRDHUP;
+        ev.data.fd = fd;
+        epoll_ctl(m_epollFd, EPOLL_CTL_ADD, fd, &ev);
+
+        m_connections[fd].activeAt = chrono::steady_clock::now();
+
+        // only armed while there are connections, an idle listener does not wake the main loop
+        if (!m_idleTimer)
+            m_idleTimer = m_timers.every(max(m_idleTimeout / 2, TimerWheel::Duration(1)), [this]() { dropIdle(); });
+    }
+}
+
+void HttpListener::read(int fd) {
+    auto it = m_connections.find(fd);
+    if (it == m_connections.end()) return;
+
+    auto& connection = it->second;
+    char buffer[8192];
+    bool eof = false;
+
+    for (;;) {
+        auto n = recv(fd, buffer, sizeof(buffer), 0);
+        if (n > 0) {
+            connection.in.append(buffer, n);
+            connection.activeAt = chrono::steady_clock::now();
+            continue;
+        }
+
+        if (n == 0) {
+            eof = true;
+            break;
+        }
+
+        if (errno == EINTR) continue;
+        if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+
+        return drop(fd);
+    }
+
+    if (eof && connection.in.empty())
+        return drop(fd);
+
+    if (connection.in.size() > maxRequestSize) {
+        Response response;
+        response.status = 413;
+        connection.close = true;
+        respond(connection, response);
+    } else {
+        // requests may be pipelined, answer every complete one
+        while (handle(connection)) {}
+    }
+
+    // the peer half-closed, answer what it sent and hang up
+    if (eof)
+        connection.close = true;
+
+    write(fd);
+}
+
+void HttpListener::write(int fd) {
+    auto it = m_connections.find(fd);
+    if (it == m_connections.end()) return;
+
+    auto& connection = it->second;
+
+    while (connection.written < connection.out.size()) {
+        auto n = send(fd, connection.out.data() + connection.written, connection.out.size() - connection.written, MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            if (errno != EAGAIN && errno != EWOULDBLOCK) return drop(fd);
+
+            epoll_event ev{};
+            ev.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP;
+            ev.data.fd = fd;
+            epoll_ctl(m_epollFd, EPOLL_CTL_MOD, fd, &ev);
+            return;
+        }
+        connection.written += n;
+        connection.activeAt = chrono::steady_clock::now();
+    }
+
+    connection.out.clear();
+    connection.written = 0;
+
+    if (connection.close)
+        return drop(fd);
+
+    epoll_event ev{};
+    ev.events = EPOLLIN | EPOLLRDHUP;
+    ev.data.fd = fd;
+    epoll_ctl(m_epollFd, EPOLL_CTL_MOD, fd, &ev);
+}
+
+void HttpListener::drop(int fd) {
+    epoll_ctl(m_epollFd, EPOLL_CTL_DEL, fd, nullptr);
+    close(fd);
+    m_connections.erase(fd);
+}
+
+// Close connections that neither sent nor took anything for the idle timeout
+void HttpListener::dropIdle() {
+    auto now = chrono::steady_clock::now();
+
+    vector<int> idle;
+    for (const auto& entry : m_connections) {
+        if (now - entry.second.activeAt >= m_idleTimeout)
+            idle.push_back(entry.first);
+    }
+
+    for (auto fd : idle)
+        drop(fd);
+
+    if (m_connections.empty()) {
+        m_timers.cancel(m_idleTimer);
+        m_idleTimer = 0;
+    }
+}
+
+static string lowercase(string s) {
+    transform(s.begin(), s.end(), s.begin(), [](unsigned char c) { return tolower(c); });
+    return s;
+}
+
+bool HttpListener::handle(Connection& connection) {
+    if (connection.close) return false;
+
+    auto headerEnd = connection.in.find("\r\n\r\n");
+    if (headerEnd == string::npos) return false;
+
+    istringstream headers(connection.in.substr(0, headerEnd));
+    string line, target, version;
+    Request request;
+
+    getline(headers, line);
+    istringstream requestLine(line);
+    requestLine >> request.method >> target >> version;
+
+    size_t contentLength = 0;
+    bool keepAlive = version == "HTTP/1.1";
+    bool chunked = false;
+
+    while (getline(headers, line)) {
+        if (!line.empty() && line.back() == '\r')
+            line.pop_back();
+
+        auto colon = line.find(':');
+        if (colon == string::npos) continue;
+
+        auto name = lowercase(line.substr(0, colon));
+        auto raw = line.substr(colon + 1);
+        raw.erase(0, raw.find_first_not_of(" \t"));
+        request.headers[name] = raw;
+
+        auto value = lowercase(raw);
+
+        if (name == "content-length") {
+            contentLength = strtoul(value.c_str(), nullptr, 10);
+        } else if (name == "transfer-encoding") {
+            chunked = true;
+        } else if (name == "connection") {
+            if (value.find("close") != string::npos) keepAlive = false;
+            else if (value.find("keep-alive") != string::npos) keepAlive = true;
+        }
+    }
+
+    Response response;
+
+    if (request.method.empty() || target.empty() || version.rfind("HTTP/1.", 0) != 0 || chunked) {
+        // chunked request bodies are not needed by any of our clients
+        response.status = chunked ? 411 : 400;
+        connection.close = true;
+        connection.in.clear();
+        respond(connection, response);
+        return false;
+    }
+
+    auto bodyStart = headerEnd + 4;
+    if (connection.in.size() - bodyStart < contentLength)
+        return false;
+
+    request.body = connection.in.substr(bodyStart, contentLength);
+    connection.in.erase(0, bodyStart + contentLength);
+
+    auto question = target.find('?');
+    request.path = target.substr(0, question);
+    if (question != string::npos)
+        request.query = target.substr(question + 1);
+
+    auto route = m_routes.find({request.method, request.path});
+    if (route != m_routes.end()) {
+        route->second(request, response);
+    } else {
+        auto known = any_of(m_routes.begin(), m_routes.end(), [&](const auto& entry) {
+            return entry.first.second == request.path;
+        });
+        response.status = known ? 405 : 404;
+    }
+
+    connection.close = !keepAlive;
+    respond(connection, response);
+
+    return !connection.close;
+}
+
+static const char* reason(int status) {
+    switch (status) {
+        case 200: return "OK";
+        case 202: return "Accepted";
+        case 204: return "No Content";
+        case 400: return "Bad Request";
+        case 401: return "Unauthorized";
+        case 404: return "Not Found";
+        case 405: return "Method Not Allowed";
+        case 411: return "Length Required";
+        case 413: return "Payload Too Large";
+        case 503: return "Service Unavailable";
+        default: return status < 400 ? "OK" : "Error";
+    }
+}
+
+void HttpListener::respond(Connection& connection, const Response& response) {
+    stringstream out;
+    out << "HTTP/1.1 " << response.status << " " << reason(response.status) << "\r\n"
+        << "Content-Length: " << response.body.size() << "\r\n";
+
+    if (!response.body.empty())
+        out << "Content-Type: " << response.contentType << "\r\n";
+
+    out << "Connection: " << (connection.close ? "close" : "keep-alive") << "\r\n"
+        << "\r\n" << response.body;
+
+    connection.out += out.str();
+}
+
+gboolean HttpListener::onEpoll(gint fd, GIOCondition condition, gpointer data) {
+    static_cast<HttpListener*>(data)->onEvents();
+    return G_SOURCE_CONTINUE;
+}
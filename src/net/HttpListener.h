@@ -0,0 +1,124 @@
+#ifndef MEETING_SDK_LINUX_SAMPLE_HTTPLISTENER_H
+#define MEETING_SDK_LINUX_SAMPLE_HTTPLISTENER_H
+
+#include <chrono>
+#include <functional>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include <glib.h>
+
+#include "../util/TimerWheel.h"
+
+using namespace std;
+
+/**
+ * Embedded single-threaded HTTP/1.1 server for small local endpoints.
+ *
+ * Sockets are multiplexed with epoll and the epoll descriptor is watched by
+ * the glib main loop, so handlers run on the main loop thread and never
+ * need to synchronize with the rest of the bot. A connection that sends or
+ * takes nothing for the idle timeout, e.g. one stalled in the middle of a
+ * request, is closed so it does not hold its descriptor and buffers for good.
+ */
+class HttpListener {
+public:
+    struct Request {
+        string method;
+        string path;
+        string query;
+        // names in lower case
+        unordered_map<string, string> headers;
+        string body;
+    };
+
+    struct Response {
+        int status = 200;
+        string contentType = "application/json";
+        string body;
+    };
+
+    typedef function<void(const Request&, Response&)> Handler;
+
+private:
+    struct Connection {
+        string in;
+        string out;
+        size_t written = 0;
+        bool close = false;
+        chrono::steady_clock::time_point activeAt;
+    };
+
+    TimerWheel& m_timers;
+    TimerWheel::Id m_idleTimer = 0;
+    chrono::milliseconds m_idleTimeout{10000};
+
+    int m_listenFd = -1;
+    int m_epollFd = -1;
+    guint m_watch = 0;
+
+    unordered_map<int, Connection> m_connections;
+    map<pair<string, string>, Handler> m_routes;
+
+    static const size_t maxRequestSize = 1 << 20;
+
+    void onEvents();
+    void accept();
+    void read(int fd);
+    void write(int fd);
+    void drop(int fd);
+    void dropIdle();
+
+    bool handle(Connection& connection);
+    void respond(Connection& connection, const Response& response);
+
+    static gboolean onEpoll(gint fd, GIOCondition condition, gpointer data);
+
+public:
+    /**
+     * @param timers main loop timers, used to close idle connections
+     */
+    explicit HttpListener(TimerWheel& timers);
+    ~HttpListener();
+
+    HttpListener(const HttpListener&) = delete;
+    HttpListener& operator=(const HttpListener&) = delete;
+
+    /**
+     * Register a handler for a method and path
+     * @param method HTTP method, e.g. POST
+     * @param path exact request path without the query string
+     * @param handler fills in the response on the main loop thread
+     */
+    void route(const string& method, const string& path, const Handler& handler);
+
+    /**
+     * @param timeout how long a connection may be idle before it is closed, 10s by default
+     */
+    void setIdleTimeout(chrono::milliseconds timeout);
+
+    /**
+     * Start accepting connections
+     * @param host address to bind to
+     * @param port TCP port to listen on
+     * @return false if the socket could not be set up
+     */
+    bool listen(const string& host, int port);
+
+    /**
+     * Close the listening socket and every open connection
+     */
+    void stop();
+
+    bool listening() const;
+
+    /**
+     * @return port listened on, the one the kernel picked when asked for port 0
+     */
+    int port() const;
+};
+
+
+#endif //MEETING_SDK_LINUX_SAMPLE_HTTPLISTENER_H
@@ -0,0 +1,174 @@
+#include "AudioRecorder.h"
+
+AudioRecorder::AudioRecorder(bool useMixedAudio) : m_useMixedAudio(useMixedAudio)
+{
+
+}
+
+void AudioRecorder::onMixedAudio(const AudioFrame& frame) {
+    if (!m_useMixedAudio) return;
+
+    Histogram::Timer timer(callbackHistogram(Metrics::MixedAudio));
+    Tracer::Scope scope("mixed audio frame", "pipeline");
+
+    if (m_dir.empty())
+        return Log::error("Output Directory cannot be blank");
+
+
+    if (m_filename.empty())
+        m_filename = "test.pcm";
+
+
+    if (!m_frames.enter()) return count(StatsSegment::FramesDropped);
+
+    stringstream path;
+    path << m_dir << "/" << m_filename;
+
+    auto writeStart = ticks();
+    bool written;
+    {
+        Tracer::Scope write("write", "pipeline");
+        written = writeToFile(path.str(), frame) >= 0;
+    }
+    m_frames.leave(written);
+
+    if (!written) return count(StatsSegment::FramesDropped);
+
+    observeWrite(Metrics::MixedAudio, timer, writeStart);
+
+    count(StatsSegment::MixedAudioFrames);
+    count(StatsSegment::MixedAudioBytes, frame.size);
+}
+
+
+
+void AudioRecorder::onOneWayAudio(const AudioFrame& frame, uint32_t node_id) {
+    if (m_useMixedAudio) return;
+
+    Histogram::Timer timer(callbackHistogram(Metrics::OneWayAudio));
+    Tracer::Scope scope("one-way audio frame", "pipeline");
+
+    if (!m_frames.enter()) return count(StatsSegment::FramesDropped);
+
+    // checked inside the counter, a purge waits for frames that got past it
+    if (m_gate && !m_gate->allowed(node_id)) {
+        m_frames.skip();
+        return count(StatsSegment::FramesGated);
+    }
+
+    stringstream path;
+    path << m_dir << "/node-" << node_id << ".pcm";
+
+    auto writeStart = ticks();
+    streamoff offset;
+    {
+        Tracer::Scope write("write", "pipeline");
+        offset = writeToFile(path.str(), frame);
+    }
+
+    if (m_ledger && offset >= 0) {
+        Tracer::Scope ledger("ledger", "pipeline");
+        m_ledger->record(node_id, path.str(), offset, frame.size);
+    }
+
+    m_frames.leave(offset >= 0);
+
+    if (offset < 0) return count(StatsSegment::FramesDropped);
+
+    observeWrite(Metrics::OneWayAudio, timer, writeStart);
+
+    count(StatsSegment::OneWayAudioFrames);
+    count(StatsSegment::OneWayAudioBytes, frame.size);
+}
+
+
+streamoff AudioRecorder::writeToFile(const string &path, const AudioFrame& frame)
+{
+    // one stream per SDK thread, so callbacks on different threads do not share it
+    static thread_local std::ofstream file;
+	file.open(path, std::ios::out | std::ios::binary | std::ios::app);
+
+	if (!file.is_open()) {
+        Log::error("failed to open audio file path: " + path);
+        return -1;
+    }
+
+    file.seekp(0, std::ios::end);
+    auto offset = static_cast<streamoff>(file.tellp());
+
+    file.write(frame.data, static_cast<streamsize>(frame.size));
+    file.close();
+
+    if (file.fail()) {
+        Log::error("failed to write audio file: " + path);
+        return -1;
+    }
+
+    stringstream ss;
+    ss << "Writing " << frame.size << "b to " << path << " at " << frame.sampleRate << "Hz";
+
+    Log::info(ss.str());
+
+    return offset;
+}
+
+void AudioRecorder::setDir(const string &dir)
+{
+    m_dir = dir;
+}
+
+void AudioRecorder::setFilename(const string &filename)
+{
+    m_filename = filename;
+}
+
+void AudioRecorder::setGate(const ConsentGate* gate)
+{
+    m_gate = gate;
+}
+
+void AudioRecorder::setLedger(SegmentLedger* ledger)
+{
+    m_ledger = ledger;
+}
+
+FrameCounter& AudioRecorder::frames()
+{
+    return m_frames;
+}
+
+void AudioRecorder::setStats(StatsSegment::Slot* stats)
+{
+    m_stats = stats;
+}
+
+void AudioRecorder::count(StatsSegment::Stat stat, uint64_t n)
+{
+    if (m_stats) m_stats->add(stat, n);
+}
+
+void AudioRecorder::setMetrics(Metrics* metrics)
+{
+    m_metrics = metrics;
+}
+
+Histogram* AudioRecorder::callbackHistogram(Metrics::Stream stream)
+{
+    return m_metrics ? &m_metrics->callback(stream) : nullptr;
+}
+
+uint64_t AudioRecorder::ticks() const
+{
+    // the clock is only read when someone looks at the timings
+    return m_metrics ? Histogram::Clock::ticks() : 0;
+}
+
+void AudioRecorder::observeWrite(Metrics::Stream stream, Histogram::Timer& callback, uint64_t writeStart)
+{
+    if (!m_metrics) return;
+
+    // one reading ends the callback, the write and the time from capture to disk
+    auto end = callback.stop();
+    m_metrics->write(stream).observe(Histogram::Clock::between(writeStart, end));
+    m_metrics->captureToDisk(stream).observe(Histogram::Clock::between(callback.started(), end));
+}
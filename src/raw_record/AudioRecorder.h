@@ -0,0 +1,86 @@
+#ifndef MEETING_SDK_LINUX_SAMPLE_AUDIORECORDER_H
+#define MEETING_SDK_LINUX_SAMPLE_AUDIORECORDER_H
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+
+#include "RawFrame.h"
+#include "../util/Log.h"
+#include "../consent/ConsentGate.h"
+#include "SegmentLedger.h"
+#include "FrameCounter.h"
+#include "../stats/StatsSegment.h"
+#include "../metrics/Metrics.h"
+#include "../metrics/Tracer.h"
+
+using namespace std;
+
+/**
+ * Writes audio frames to disk, the mixed stream to one file or each
+ * participant's one-way audio to node-<id>.pcm. Frames of participants the
+ * gate refuses are dropped, every write is counted, timed and recorded in
+ * the ledger.
+ *
+ * Knows nothing of the SDK, ZoomSDKAudioRawDataDelegate hands it the frames.
+ */
+class AudioRecorder {
+    string m_dir = "out";
+    string m_filename = "test.pcm";
+    bool m_useMixedAudio;
+    const ConsentGate* m_gate = nullptr;
+    SegmentLedger* m_ledger = nullptr;
+    FrameCounter m_frames;
+    StatsSegment::Slot* m_stats = nullptr;
+    Metrics* m_metrics = nullptr;
+
+    void count(StatsSegment::Stat stat, uint64_t n = 1);
+    Histogram* callbackHistogram(Metrics::Stream stream);
+    uint64_t ticks() const;
+    void observeWrite(Metrics::Stream stream, Histogram::Timer& callback, uint64_t writeStart);
+
+    streamoff writeToFile(const string& path, const AudioFrame& frame);
+public:
+    /**
+     * @param useMixedAudio record the mixed stream, otherwise one-way audio
+     */
+    explicit AudioRecorder(bool useMixedAudio);
+
+    void setDir(const string& dir);
+    void setFilename(const string& filename);
+
+    /**
+     * Only write one-way audio of participants the gate allows
+     * @param gate consent lookup, nullptr records everyone
+     */
+    void setGate(const ConsentGate* gate);
+
+    /**
+     * Record where each participant's one-way audio is written
+     * @param ledger consulted when a participant's media must be purged
+     */
+    void setLedger(SegmentLedger* ledger);
+
+    /**
+     * Frames written and dropped, stopped at shutdown
+     */
+    FrameCounter& frames();
+
+    /**
+     * Count frames and bytes in the shared memory stats
+     * @param stats slot of this bot, nullptr to not count
+     */
+    void setStats(StatsSegment::Slot* stats);
+
+    /**
+     * Time callbacks and writes
+     * @param metrics histograms shared by every recorder, nullptr to not time
+     */
+    void setMetrics(Metrics* metrics);
+
+    void onMixedAudio(const AudioFrame& frame);
+    void onOneWayAudio(const AudioFrame& frame, uint32_t node_id);
+};
+
+
+#endif //MEETING_SDK_LINUX_SAMPLE_AUDIORECORDER_H
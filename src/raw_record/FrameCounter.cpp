@@ -0,0 +1,44 @@
+#include "FrameCounter.h"
+
+bool FrameCounter::enter() {
+    // busy is raised before stopped is read and stop() sets stopped before
+    // reading busy, so shutdown either sees this frame or the frame sees it
+    m_busy.fetch_add(1);
+
+    if (m_stopped.load()) {
+        m_busy.fetch_sub(1);
+        m_dropped.fetch_add(1, memory_order_relaxed);
+        return false;
+    }
+
+    return true;
+}
+
+void FrameCounter::leave(bool written) {
+    if (written) m_written.fetch_add(1, memory_order_relaxed);
+    else m_dropped.fetch_add(1, memory_order_relaxed);
+
+    m_busy.fetch_sub(1, memory_order_release);
+}
+
+void FrameCounter::skip() {
+    m_busy.fetch_sub(1, memory_order_release);
+}
+
+void FrameCounter::stop() {
+    m_stopped.store(true);
+}
+
+bool FrameCounter::idle() {
+    // a read-modify-write, so a frame entering after this reads the gate as
+    // the caller left it, which a plain load would not guarantee
+    return m_busy.fetch_add(0) == 0;
+}
+
+uint64_t FrameCounter::written() const {
+    return m_written.load(memory_order_relaxed);
+}
+
+uint64_t FrameCounter::dropped() const {
+    return m_dropped.load(memory_order_relaxed);
+}
@@ -0,0 +1,56 @@
+#ifndef MEETING_SDK_LINUX_SAMPLE_FRAMECOUNTER_H
+#define MEETING_SDK_LINUX_SAMPLE_FRAMECOUNTER_H
+
+#include <atomic>
+#include <cstdint>
+
+using namespace std;
+
+/**
+ * Counts the frames a raw data delegate wrote and dropped, and lets shutdown
+ * stop it and wait for callbacks still in the middle of a write.
+ *
+ * SDK threads call enter() before and leave() after each frame. Once stop()
+ * was called enter() refuses, so every frame is either written in full or
+ * counted as dropped. The consent gate is checked after enter(), so a purge
+ * that saw the counter idle after revoking knows no frame of the revoked
+ * participant is still being written.
+ */
+class FrameCounter {
+    atomic<bool> m_stopped{false};
+    atomic<int> m_busy{0};
+    atomic<uint64_t> m_written{0};
+    atomic<uint64_t> m_dropped{0};
+
+public:
+    /**
+     * @return false if capture stopped, the frame is counted as dropped
+     */
+    bool enter();
+
+    /**
+     * @param written false if the frame could not be written
+     */
+    void leave(bool written);
+
+    /**
+     * Leave without counting the frame, the gate refused it
+     */
+    void skip();
+
+    /**
+     * Refuse frames from now on, those already entered still finish
+     */
+    void stop();
+
+    /**
+     * @return true if no callback is writing a frame
+     */
+    bool idle();
+
+    uint64_t written() const;
+    uint64_t dropped() const;
+};
+
+
+#endif //MEETING_SDK_LINUX_SAMPLE_FRAMECOUNTER_H
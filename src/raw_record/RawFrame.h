@@ -0,0 +1,37 @@
+#ifndef MEETING_SDK_LINUX_SAMPLE_RAWFRAME_H
+#define MEETING_SDK_LINUX_SAMPLE_RAWFRAME_H
+
+#include <cstddef>
+#include <cstdint>
+
+using namespace std;
+
+/**
+ * Audio frame as the recorders see it, the delegates fill it from the SDK's
+ * AudioRawData. Only a view, valid as long as the SDK's frame.
+ */
+struct AudioFrame {
+    const char* data = nullptr;
+    size_t size = 0;
+    unsigned int sampleRate = 0;
+};
+
+/**
+ * I420 video frame as the recorders see it, filled from the SDK's
+ * YUVRawDataI420. The planes need not be contiguous.
+ */
+struct VideoFrame {
+    const char* y = nullptr;
+    const char* u = nullptr;
+    const char* v = nullptr;
+    unsigned int width = 0;
+    unsigned int height = 0;
+    uint32_t sourceId = 0;
+
+    size_t ySize() const { return static_cast<size_t>(width) * height; }
+    size_t uvSize() const { return ySize() / 4; }
+    size_t size() const { return ySize() + uvSize() * 2; }
+};
+
+
+#endif //MEETING_SDK_LINUX_SAMPLE_RAWFRAME_H
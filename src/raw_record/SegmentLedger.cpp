@@ -0,0 +1,26 @@
+#include "SegmentLedger.h"
+
+void SegmentLedger::record(uint32_t nodeId, const string& path, uint64_t offset, uint64_t length) {
+    lock_guard<mutex> lock(m_mutex);
+
+    auto& ranges = m_segments[nodeId][path];
+    if (!ranges.empty() && ranges.back().offset + ranges.back().length == offset) {
+        ranges.back().length += length;
+        return;
+    }
+
+    ranges.push_back({offset, length});
+}
+
+SegmentLedger::Segments SegmentLedger::take(uint32_t nodeId) {
+    lock_guard<mutex> lock(m_mutex);
+
+    auto it = m_segments.find(nodeId);
+    if (it == m_segments.end())
+        return {};
+
+    auto segments = move(it->second);
+    m_segments.erase(it);
+
+    return segments;
+}
@@ -0,0 +1,50 @@
+#ifndef MEETING_SDK_LINUX_SAMPLE_SEGMENTLEDGER_H
+#define MEETING_SDK_LINUX_SAMPLE_SEGMENTLEDGER_H
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace std;
+
+/**
+ * Remembers which byte ranges of which files hold each participant's media.
+ *
+ * The raw data delegates record every write, contiguous writes to the same
+ * file are merged so a participant's stream usually costs one range per file.
+ */
+class SegmentLedger {
+public:
+    struct Range {
+        uint64_t offset;
+        uint64_t length;
+    };
+
+    typedef unordered_map<string, vector<Range>> Segments;
+
+private:
+    mutex m_mutex;
+    unordered_map<uint32_t, Segments> m_segments;
+
+public:
+    /**
+     * Record a write, safe to call from any thread
+     * @param nodeId user id of the participant
+     * @param path file that was written to
+     * @param offset position of the write in the file
+     * @param length number of bytes written
+     */
+    void record(uint32_t nodeId, const string& path, uint64_t offset, uint64_t length);
+
+    /**
+     * Remove and return everything recorded for a participant
+     * @param nodeId user id of the participant
+     * @return byte ranges per file
+     */
+    Segments take(uint32_t nodeId);
+};
+
+
+#endif //MEETING_SDK_LINUX_SAMPLE_SEGMENTLEDGER_H
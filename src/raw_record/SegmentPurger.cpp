@@ -0,0 +1,211 @@
+#include "SegmentPurger.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <json/json.h>
+
+#include "../util/Log.h"
+#include "../metrics/Tracer.h"
+
+SegmentPurger::SegmentPurger(SegmentLedger& ledger) : m_ledger(ledger), m_auditFile("consent-audit.jsonl")
+{
+
+}
+
+SegmentPurger::~SegmentPurger() {
+    drain();
+}
+
+void SegmentPurger::drain() {
+    {
+        lock_guard<mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+
+    m_wake.notify_one();
+
+    if (m_worker.joinable())
+        m_worker.join();
+
+    lock_guard<mutex> lock(m_mutex);
+    m_stopping = false;
+}
+
+size_t SegmentPurger::pending() {
+    lock_guard<mutex> lock(m_mutex);
+    return m_jobs.size();
+}
+
+void SegmentPurger::setAuditFile(const string& path) {
+    lock_guard<mutex> lock(m_mutex);
+    m_auditFile = path;
+}
+
+void SegmentPurger::watch(FrameCounter* frames) {
+    lock_guard<mutex> lock(m_watchMutex);
+    m_watched.push_back(frames);
+}
+
+void SegmentPurger::unwatch(FrameCounter* frames) {
+    // blocks while a purge is waiting on the stream, so it never outlives it
+    lock_guard<mutex> lock(m_watchMutex);
+    m_watched.erase(remove(m_watched.begin(), m_watched.end(), frames), m_watched.end());
+}
+
+void SegmentPurger::purge(uint32_t nodeId, const string& name) {
+    {
+        lock_guard<mutex> lock(m_mutex);
+        m_jobs.push_back({nodeId, name, m_auditFile, chrono::system_clock::now()});
+
+        // only started once somebody revokes consent
+        if (!m_worker.joinable())
+            m_worker = thread(&SegmentPurger::run, this);
+    }
+
+    m_wake.notify_one();
+}
+
+void SegmentPurger::run() {
+    unique_lock<mutex> lock(m_mutex);
+
+    for (;;) {
+        m_wake.wait(lock, [this]() { return m_stopping || !m_jobs.empty(); });
+
+        // drain the queue even when stopping, a revoked stream must not survive
+        if (m_jobs.empty()) return;
+
+        auto job = move(m_jobs.front());
+        m_jobs.pop_front();
+
+        lock.unlock();
+        purge(job);
+        lock.lock();
+    }
+}
+
+void SegmentPurger::purge(const Job& job) {
+    Tracer::Scope scope("purge", "pipeline");
+
+    // frames entering from now on see the gate closed, so once the writers
+    // in flight are done the ledger holds everything this participant has on disk
+    if (!waitForWriters())
+        Log::error("capture callbacks still writing, purging what the ledger holds so far");
+
+    auto segments = m_ledger.take(job.nodeId);
+
+    uint64_t bytes = 0;
+    int errors = 0;
+    bool punched = false, zeroed = false;
+
+    for (const auto& file : segments) {
+        int fd = open(file.first.c_str(), O_WRONLY | O_CLOEXEC);
+        if (fd < 0) {
+            Log::error("failed to open " + file.first + " for purging: " + strerror(errno));
+            ++errors;
+            continue;
+        }
+
+        for (const auto& range : file.second) {
+            bool zero = false;
+            if (!punch(fd, range, zero)) {
+                Log::error("failed to purge " + file.first + ": " + strerror(errno));
+                ++errors;
+                continue;
+            }
+
+            bytes += range.length;
+            (zero ? zeroed : punched) = true;
+        }
+
+        if (fsync(fd) < 0)
+            ++errors;
+
+        close(fd);
+    }
+
+    string method = punched && zeroed ? "mixed" : zeroed ? "zero_fill" : punched ? "punch_hole" : "none";
+    audit(job, segments.size(), bytes, method, errors);
+}
+
+bool SegmentPurger::waitForWriters() {
+    lock_guard<mutex> lock(m_watchMutex);
+    auto deadline = chrono::steady_clock::now() + m_writerTimeout;
+
+    // each stream only has to be seen idle once, it need not be all at the same time
+    for (auto* frames : m_watched) {
+        while (!frames->idle()) {
+            if (chrono::steady_clock::now() >= deadline) return false;
+            this_thread::sleep_for(chrono::microseconds(100));
+        }
+    }
+
+    return true;
+}
+
+bool SegmentPurger::punch(int fd, const SegmentLedger::Range& range, bool& zeroed) {
+    if (fallocate(fd, FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE, range.offset, range.length) == 0)
+        return true;
+
+    if (errno != EOPNOTSUPP && errno != ENOSYS)
+        return false;
+
+    // the filesystem cannot punch holes, overwrite the range instead
+    static const char zeros[65536] = {};
+    zeroed = true;
+
+    auto offset = range.offset;
+    auto end = range.offset + range.length;
+
+    while (offset < end) {
+        auto chunk = min<uint64_t>(sizeof(zeros), end - offset);
+        auto n = pwrite(fd, zeros, chunk, offset);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        offset += n;
+    }
+
+    return true;
+}
+
+static int64_t millis(chrono::system_clock::time_point time) {
+    return chrono::duration_cast<chrono::milliseconds>(time.time_since_epoch()).count();
+}
+
+void SegmentPurger::audit(const Job& job, size_t files, uint64_t bytes, const string& method, int errors) {
+    Json::Value record;
+    record["event"] = "consent_purge";
+    record["node_id"] = job.nodeId;
+    record["user"] = job.name;
+    record["files"] = static_cast<Json::UInt64>(files);
+    record["bytes"] = static_cast<Json::UInt64>(bytes);
+    record["method"] = method;
+    record["errors"] = errors;
+    record["requested_at"] = static_cast<Json::Int64>(millis(job.requestedAt));
+    record["completed_at"] = static_cast<Json::Int64>(millis(chrono::system_clock::now()));
+
+    Json::StreamWriterBuilder builder;
+    builder["indentation"] = "";
+
+    ofstream out(job.auditFile, ios::out | ios::app);
+    out << Json::writeString(builder, record) << "\n";
+    out.flush();
+
+    if (!out)
+        Log::error("failed to write audit record to " + job.auditFile);
+
+    stringstream ss;
+    ss << "purged " << bytes << "b in " << files << " file(s) of node " << job.nodeId << " using " << method;
+    if (errors) ss << " with " << errors << " error(s)";
+
+    if (errors) Log::error(ss.str());
+    else Log::success(ss.str());
+}
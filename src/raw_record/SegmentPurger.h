@@ -0,0 +1,109 @@
+#ifndef MEETING_SDK_LINUX_SAMPLE_SEGMENTPURGER_H
+#define MEETING_SDK_LINUX_SAMPLE_SEGMENTPURGER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "SegmentLedger.h"
+#include "FrameCounter.h"
+
+using namespace std;
+
+/**
+ * Removes the media of participants who revoked their consent.
+ *
+ * Purges run on a background thread so capture never waits for them. Each
+ * recorded byte range is released with fallocate(PUNCH_HOLE), falling back to
+ * writing zeros where the filesystem cannot punch holes; file sizes are kept
+ * so streams still being appended are unaffected. Every finished purge is
+ * appended as a JSON line to the audit file.
+ *
+ * A frame that got past the gate before it closed may still be in the middle
+ * of its write, so a purge first waits for each watched stream to go idle and
+ * only then takes the participant's ranges from the ledger.
+ */
+class SegmentPurger {
+    struct Job {
+        uint32_t nodeId;
+        string name;
+        string auditFile;
+        chrono::system_clock::time_point requestedAt;
+    };
+
+    SegmentLedger& m_ledger;
+    string m_auditFile;
+
+    mutex m_mutex;
+    condition_variable m_wake;
+    deque<Job> m_jobs;
+    thread m_worker;
+    bool m_stopping = false;
+
+    mutex m_watchMutex;
+    vector<FrameCounter*> m_watched;
+    chrono::milliseconds m_writerTimeout{1000};
+
+    void run();
+    void purge(const Job& job);
+    bool waitForWriters();
+    void audit(const Job& job, size_t files, uint64_t bytes, const string& method, int errors);
+
+    static bool punch(int fd, const SegmentLedger::Range& range, bool& zeroed);
+
+public:
+    /**
+     * @param ledger where the delegates record what they wrote
+     */
+    explicit SegmentPurger(SegmentLedger& ledger);
+
+    /**
+     * Finishes every queued purge before returning
+     */
+    ~SegmentPurger();
+
+    SegmentPurger(const SegmentPurger&) = delete;
+    SegmentPurger& operator=(const SegmentPurger&) = delete;
+
+    /**
+     * @param path JSON lines file audit records are appended to
+     */
+    void setAuditFile(const string& path);
+
+    /**
+     * Wait for a stream's in-flight frames before taking the ledger
+     * @param frames counter of a recorder that records into the ledger
+     */
+    void watch(FrameCounter* frames);
+
+    /**
+     * Stop waiting for a stream, before its recorder is destroyed
+     * @param frames counter passed to watch()
+     */
+    void unwatch(FrameCounter* frames);
+
+    /**
+     * Queue a purge of everything recorded for a participant
+     * @param nodeId user id of the participant
+     * @param name display name of the participant, for the audit record
+     */
+    void purge(uint32_t nodeId, const string& name);
+
+    /**
+     * Finish every queued purge and stop the worker, a later purge starts it again
+     */
+    void drain();
+
+    /**
+     * @return purges queued and not started yet
+     */
+    size_t pending();
+};
+
+
+#endif //MEETING_SDK_LINUX_SAMPLE_SEGMENTPURGER_H
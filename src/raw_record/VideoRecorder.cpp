@@ -0,0 +1,132 @@
+#include "VideoRecorder.h"
+
+void VideoRecorder::onVideoFrame(const VideoFrame& frame)
+{
+    Histogram::Timer timer(callbackHistogram(Metrics::Video));
+    Tracer::Scope scope("video frame", "pipeline");
+
+    if (!m_frames.enter()) return count(StatsSegment::FramesDropped);
+
+    // checked inside the counter, a purge waits for frames that got past it
+    if (m_gate && !m_gate->allowed(frame.sourceId)) {
+        m_frames.skip();
+        return count(StatsSegment::FramesGated);
+    }
+
+    stringstream path;
+    path << m_dir << "/" << m_filename;
+
+    auto bytes = frame.size();
+
+    auto writeStart = ticks();
+    streamoff offset;
+    {
+        Tracer::Scope write("write", "pipeline");
+        offset = writeToFile(path.str(), frame);
+    }
+
+    if (m_ledger && offset >= 0) {
+        Tracer::Scope ledger("ledger", "pipeline");
+        m_ledger->record(frame.sourceId, path.str(), offset, bytes);
+    }
+
+    m_frames.leave(offset >= 0);
+
+    if (offset < 0) return count(StatsSegment::FramesDropped);
+
+    observeWrite(Metrics::Video, timer, writeStart);
+    count(StatsSegment::VideoFrames);
+    count(StatsSegment::VideoBytes, bytes);
+}
+
+streamoff VideoRecorder::writeToFile(const string &path, const VideoFrame& frame)
+{
+
+	std::ofstream file(path, std::ios::out | std::ios::binary | std::ios::app);
+	if (!file.is_open()) {
+        Log::error("failed to open video output file: " + path);
+        return -1;
+    }
+
+    file.seekp(0, std::ios::end);
+    auto offset = static_cast<streamoff>(file.tellp());
+
+	// Write Y, U, and V components to the output file
+	file.write(frame.y, static_cast<streamsize>(frame.ySize()));
+	file.write(frame.u, static_cast<streamsize>(frame.uvSize()));
+	file.write(frame.v, static_cast<streamsize>(frame.uvSize()));
+	file.close();
+
+    if (file.fail()) {
+        Log::error("failed to write video output file: " + path);
+        return -1;
+    }
+
+    stringstream ss;
+    ss << "Writing " << frame.size() << "b to " << path;
+
+    Log::info(ss.str());
+
+    return offset;
+}
+
+void VideoRecorder::setDir(const string &dir)
+{
+    m_dir = dir;
+}
+
+void VideoRecorder::setFilename(const string &filename)
+{
+    m_filename = filename;
+}
+
+void VideoRecorder::setGate(const ConsentGate* gate)
+{
+    m_gate = gate;
+}
+
+void VideoRecorder::setLedger(SegmentLedger* ledger)
+{
+    m_ledger = ledger;
+}
+
+FrameCounter& VideoRecorder::frames()
+{
+    return m_frames;
+}
+
+void VideoRecorder::setStats(StatsSegment::Slot* stats)
+{
+    m_stats = stats;
+}
+
+void VideoRecorder::count(StatsSegment::Stat stat, uint64_t n)
+{
+    if (m_stats) m_stats->add(stat, n);
+}
+
+void VideoRecorder::setMetrics(Metrics* metrics)
+{
+    m_metrics = metrics;
+}
+
+Histogram* VideoRecorder::callbackHistogram(Metrics::Stream stream)
+{
+    return m_metrics ? &m_metrics->callback(stream) : nullptr;
+}
+
+uint64_t VideoRecorder::ticks() const
+{
+    // the clock is only read when someone looks at the timings
+    return m_metrics ? Histogram::Clock::ticks() : 0;
+}
+
+void VideoRecorder::observeWrite(Metrics::Stream stream, Histogram::Timer& callback, uint64_t writeStart)
+{
+    if (!m_metrics) return;
+
+    // one reading ends the callback, the write and the time from capture to disk
+    auto end = callback.stop();
+    m_metrics->write(stream).observe(Histogram::Clock::between(writeStart, end));
+    m_metrics->captureToDisk(stream).observe(Histogram::Clock::between(callback.started(), end));
+}
@@ -0,0 +1,78 @@
+#ifndef MEETING_SDK_LINUX_SAMPLE_VIDEORECORDER_H
+#define MEETING_SDK_LINUX_SAMPLE_VIDEORECORDER_H
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+
+#include "RawFrame.h"
+#include "../util/Log.h"
+#include "../consent/ConsentGate.h"
+#include "SegmentLedger.h"
+#include "FrameCounter.h"
+#include "../stats/StatsSegment.h"
+#include "../metrics/Metrics.h"
+#include "../metrics/Tracer.h"
+
+using namespace std;
+
+/**
+ * Appends I420 frames to a .yuv file, frames of participants the gate
+ * refuses are dropped, every write is counted, timed and recorded in the
+ * ledger.
+ *
+ * Knows nothing of the SDK, ZoomSDKRendererDelegate hands it the frames.
+ */
+class VideoRecorder {
+    string m_dir = "out";
+    string m_filename = "meeting-video.yuv";
+    const ConsentGate* m_gate = nullptr;
+    SegmentLedger* m_ledger = nullptr;
+    FrameCounter m_frames;
+    StatsSegment::Slot* m_stats = nullptr;
+    Metrics* m_metrics = nullptr;
+
+    void count(StatsSegment::Stat stat, uint64_t n = 1);
+    Histogram* callbackHistogram(Metrics::Stream stream);
+    uint64_t ticks() const;
+    void observeWrite(Metrics::Stream stream, Histogram::Timer& callback, uint64_t writeStart);
+
+    streamoff writeToFile(const string& path, const VideoFrame& frame);
+public:
+    void setDir(const string& dir);
+    void setFilename(const string& filename);
+
+    /**
+     * Only write frames of participants the gate allows
+     * @param gate consent lookup, nullptr records everyone
+     */
+    void setGate(const ConsentGate* gate);
+
+    /**
+     * Record where each participant's frames are written
+     * @param ledger consulted when a participant's media must be purged
+     */
+    void setLedger(SegmentLedger* ledger);
+
+    /**
+     * Frames written and dropped, stopped at shutdown
+     */
+    FrameCounter& frames();
+
+    /**
+     * Count frames and bytes in the shared memory stats
+     * @param stats slot of this bot, nullptr to not count
+     */
+    void setStats(StatsSegment::Slot* stats);
+
+    /**
+     * Time callbacks and writes
+     * @param metrics histograms shared by every recorder, nullptr to not time
+     */
+    void setMetrics(Metrics* metrics);
+
+    void onVideoFrame(const VideoFrame& frame);
+};
+
+
+#endif //MEETING_SDK_LINUX_SAMPLE_VIDEORECORDER_H
@@ -1,35 +1,26 @@
 #include "ZoomSDKAudioRawDataDelegate.h"
 
-ZoomSDKAudioRawDataDelegate::ZoomSDKAudioRawDataDelegate(bool useMixedAudio) : m_useMixedAudio(useMixedAudio)
+ZoomSDKAudioRawDataDelegate::ZoomSDKAudioRawDataDelegate(bool useMixedAudio) : m_recorder(useMixedAudio)
 {
 
 }
 
-void ZoomSDKAudioRawDataDelegate::onMixedAudioRawDataReceived(AudioRawData *data) {
-    if (!m_useMixedAudio) return;
-
-    if (m_dir.empty())
-        return Log::error("Output Directory cannot be blank");
-    
-
-    if (m_filename.empty()) 
-        m_filename = "test.pcm";
-    
-
-    stringstream path;
-    path << m_dir << "/" << m_filename;
+AudioFrame ZoomSDKAudioRawDataDelegate::frame(AudioRawData* data)
+{
+    AudioFrame frame;
+    frame.data = data->GetBuffer();
+    frame.size = data->GetBufferLen();
+    frame.sampleRate = data->GetSampleRate();
 
-    writeToFile(path.str(), data);
+    return frame;
 }
 
-
+void ZoomSDKAudioRawDataDelegate::onMixedAudioRawDataReceived(AudioRawData *data) {
+    m_recorder.onMixedAudio(frame(data));
+}
 
 void ZoomSDKAudioRawDataDelegate::onOneWayAudioRawDataReceived(AudioRawData* data, uint32_t node_id) {
-    if (m_useMixedAudio) return;
-
-    stringstream path;
-    path << m_dir << "/node-" << node_id << ".pcm";
-    writeToFile(path.str(), data);
+    m_recorder.onOneWayAudio(frame(data), node_id);
 }
 
 void ZoomSDKAudioRawDataDelegate::onShareAudioRawDataReceived(AudioRawData* data) {
@@ -38,32 +29,42 @@ void ZoomSDKAudioRawDataDelegate::onShareAudioRawDataReceived(AudioRawData* data
     Log::info(ss.str());
 }
 
+AudioRecorder& ZoomSDKAudioRawDataDelegate::recorder()
+{
+    return m_recorder;
+}
 
-void ZoomSDKAudioRawDataDelegate::writeToFile(const string &path, AudioRawData *data)
+void ZoomSDKAudioRawDataDelegate::setDir(const string &dir)
 {
-    static std::ofstream file;
-	file.open(path, std::ios::out | std::ios::binary | std::ios::app);
+    m_recorder.setDir(dir);
+}
 
-	if (!file.is_open())
-        return Log::error("failed to open audio file path: " + path);
-	
-    file.write(data->GetBuffer(), data->GetBufferLen());
+void ZoomSDKAudioRawDataDelegate::setFilename(const string &filename)
+{
+    m_recorder.setFilename(filename);
+}
 
-    file.close();
-	file.flush();
+void ZoomSDKAudioRawDataDelegate::setGate(const ConsentGate* gate)
+{
+    m_recorder.setGate(gate);
+}
 
-    stringstream ss;
-    ss << "Writing " << data->GetBufferLen() << "b to " << path << " at " << data->GetSampleRate() << "Hz";
+void ZoomSDKAudioRawDataDelegate::setLedger(SegmentLedger* ledger)
+{
+    m_recorder.setLedger(ledger);
+}
 
-    Log::info(ss.str());
+FrameCounter& ZoomSDKAudioRawDataDelegate::frames()
+{
+    return m_recorder.frames();
 }
 
-void ZoomSDKAudioRawDataDelegate::setDir(const string &dir)
+void ZoomSDKAudioRawDataDelegate::setStats(StatsSegment::Slot* stats)
 {
-    m_dir = dir;
+    m_recorder.setStats(stats);
 }
 
-void ZoomSDKAudioRawDataDelegate::setFilename(const string &filename)
+void ZoomSDKAudioRawDataDelegate::setMetrics(Metrics* metrics)
 {
-    m_filename = filename;
+    m_recorder.setMetrics(metrics);
 }
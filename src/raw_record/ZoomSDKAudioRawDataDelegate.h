@@ -1,4 +1,3 @@
-
 #ifndef MEETING_SDK_LINUX_SAMPLE_ZOOMSDKAUDIORAWDATADELEGATE_H
 #define MEETING_SDK_LINUX_SAMPLE_ZOOMSDKAUDIORAWDATADELEGATE_H
 
@@ -8,23 +7,55 @@
 #include "zoom_sdk_raw_data_def.h"
 #include "rawdata/rawdata_audio_helper_interface.h"
 
-#include "../util/Log.h"
+#include "AudioRecorder.h"
 
 using namespace std;
 using namespace ZOOMSDK;
 
+/**
+ * Hands the SDK's audio frames to an AudioRecorder
+ */
 class ZoomSDKAudioRawDataDelegate : public IZoomSDKAudioRawDataDelegate {
-    string m_dir = "out";
-    string m_filename = "test.pcm";
-    bool m_useMixedAudio;
+    AudioRecorder m_recorder;
 
-    void writeToFile(const string& path, AudioRawData* data);
+    static AudioFrame frame(AudioRawData* data);
 public:
     ZoomSDKAudioRawDataDelegate(bool useMixedAudio);
 
+    AudioRecorder& recorder();
+
     void setDir(const string& dir);
     void setFilename(const string& filename);
 
+    /**
+     * Only write one-way audio of participants the gate allows
+     * @param gate consent lookup, nullptr records everyone
+     */
+    void setGate(const ConsentGate* gate);
+
+    /**
+     * Record where each participant's one-way audio is written
+     * @param ledger consulted when a participant's media must be purged
+     */
+    void setLedger(SegmentLedger* ledger);
+
+    /**
+     * Frames written and dropped, stopped at shutdown
+     */
+    FrameCounter& frames();
+
+    /**
+     * Count frames and bytes in the shared memory stats
+     * @param stats slot of this bot, nullptr to not count
+     */
+    void setStats(StatsSegment::Slot* stats);
+
+    /**
+     * Time callbacks and writes
+     * @param metrics histograms shared by every delegate, nullptr to not time
+     */
+    void setMetrics(Metrics* metrics);
+
     void onMixedAudioRawDataReceived(AudioRawData* data) override;
     void onOneWayAudioRawDataReceived(AudioRawData* data, uint32_t node_id) override;
     void onShareAudioRawDataReceived(AudioRawData* data) override;
@@ -1,45 +1,59 @@
 #include "ZoomSDKRendererDelegate.h"
 
-void ZoomSDKRendererDelegate::onRawDataFrameReceived(YUVRawDataI420 *data)
+VideoFrame ZoomSDKRendererDelegate::frame(YUVRawDataI420* data)
 {
-    stringstream path;
-    path << m_dir << "/" << m_filename;
+    VideoFrame frame;
+    frame.y = data->GetYBuffer();
+    frame.u = data->GetUBuffer();
+    frame.v = data->GetVBuffer();
+    frame.width = data->GetStreamWidth();
+    frame.height = data->GetStreamHeight();
+    frame.sourceId = data->GetSourceID();
+
+    return frame;
+}
 
-    writeToFile(path.str(), data);
+void ZoomSDKRendererDelegate::onRawDataFrameReceived(YUVRawDataI420 *data)
+{
+    m_recorder.onVideoFrame(frame(data));
 }
 
-void ZoomSDKRendererDelegate::writeToFile(const string &path, YUVRawDataI420 *data)
+VideoRecorder& ZoomSDKRendererDelegate::recorder()
 {
+    return m_recorder;
+}
 
-	std::ofstream file(path, std::ios::out | std::ios::binary | std::ios::app);
-	if (!file.is_open()) 
-        return Log::error("failed to open video output file: " + path);
-	
-	// Calculate the sizes for Y, U, and V components
-	size_t ySize = data->GetStreamWidth() * data->GetStreamHeight();
-	size_t uvSize = ySize / 4;
+void ZoomSDKRendererDelegate::setDir(const string &dir)
+{
+    m_recorder.setDir(dir);
+}
 
-	// Write Y, U, and V components to the output file
-	file.write(data->GetYBuffer(), ySize);
-	file.write(data->GetUBuffer(), uvSize);
-	file.write(data->GetVBuffer(), uvSize);
+void ZoomSDKRendererDelegate::setFilename(const string &filename)
+{
+    m_recorder.setFilename(filename);
+}
 
-    auto bytes = ySize + uvSize*2;
-    stringstream ss;
-    ss << "Writing " << bytes << "b to " << path;
+void ZoomSDKRendererDelegate::setGate(const ConsentGate* gate)
+{
+    m_recorder.setGate(gate);
+}
 
-    Log::info(ss.str());
+void ZoomSDKRendererDelegate::setLedger(SegmentLedger* ledger)
+{
+    m_recorder.setLedger(ledger);
+}
 
-	file.close();
-	file.flush();
+FrameCounter& ZoomSDKRendererDelegate::frames()
+{
+    return m_recorder.frames();
 }
 
-void ZoomSDKRendererDelegate::setDir(const string &dir)
+void ZoomSDKRendererDelegate::setStats(StatsSegment::Slot* stats)
 {
-    m_dir = dir;
+    m_recorder.setStats(stats);
 }
 
-void ZoomSDKRendererDelegate::setFilename(const string &filename)
+void ZoomSDKRendererDelegate::setMetrics(Metrics* metrics)
 {
-    m_filename = filename;
+    m_recorder.setMetrics(metrics);
 }
@@ -1,4 +1,3 @@
-
 #ifndef MEETING_SDK_LINUX_SAMPLE_ZOOMSDKRENDERERDELEGATE_H
 #define MEETING_SDK_LINUX_SAMPLE_ZOOMSDKRENDERERDELEGATE_H
 
@@ -8,20 +7,53 @@
 #include "zoom_sdk_raw_data_def.h"
 #include "rawdata/rawdata_renderer_interface.h"
 
-#include "../util/Log.h"
+#include "VideoRecorder.h"
 
 using namespace std;
 using namespace ZOOMSDK;
 
+/**
+ * Hands the SDK's video frames to a VideoRecorder
+ */
 class ZoomSDKRendererDelegate : public IZoomSDKRendererDelegate {
-    string m_dir = "out";
-    string m_filename = "meeting-video.yuv";
+    VideoRecorder m_recorder;
+
+    static VideoFrame frame(YUVRawDataI420* data);
 public:
-    void writeToFile(const string& path, YUVRawDataI420* data);
+    VideoRecorder& recorder();
 
     void setDir(const string& dir);
     void setFilename(const string& filename);
 
+    /**
+     * Only write frames of participants the gate allows
+     * @param gate consent lookup, nullptr records everyone
+     */
+    void setGate(const ConsentGate* gate);
+
+    /**
+     * Record where each participant's frames are written
+     * @param ledger consulted when a participant's media must be purged
+     */
+    void setLedger(SegmentLedger* ledger);
+
+    /**
+     * Frames written and dropped, stopped at shutdown
+     */
+    FrameCounter& frames();
+
+    /**
+     * Count frames and bytes in the shared memory stats
+     * @param stats slot of this bot, nullptr to not count
+     */
+    void setStats(StatsSegment::Slot* stats);
+
+    /**
+     * Time callbacks and writes
+     * @param metrics histograms shared by every delegate, nullptr to not time
+     */
+    void setMetrics(Metrics* metrics);
+
     void onRawDataFrameReceived(YUVRawDataI420* data) override;
     void onRawDataStatusChanged(RawDataStatus status) override {};
     void onRendererBeDestroyed() override {};
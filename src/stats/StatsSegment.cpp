@@ -0,0 +1,181 @@
+#include "StatsSegment.h"
+
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "../util/Log.h"
+
+static const char magic[8] = {'Z', 'S', 'T', 'A', 'T', 'S', 0, 0};
+static const uint32_t version = 2;
+
+StatsSegment::~StatsSegment() {
+    close();
+}
+
+bool StatsSegment::create(const string& name, uint32_t slots) {
+    close();
+
+    int fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        Log::error("failed to create stats segment " + name + ": " + strerror(errno));
+        return false;
+    }
+
+    // a fresh file reads as zeros, which are valid atomics
+    auto size = sizeFor(slots);
+    if (ftruncate(fd, static_cast<off_t>(size)) < 0 || !map(fd, size, true)) {
+        Log::error("failed to size stats segment " + name + ": " + strerror(errno));
+        ::close(fd);
+        shm_unlink(name.c_str());
+        return false;
+    }
+
+    ::close(fd);
+
+    auto* h = header();
+    h->version = version;
+    h->slots = slots;
+
+    // readers check the magic last, once the header is complete
+    atomic_thread_fence(memory_order_release);
+    memcpy(h->magic, magic, sizeof(magic));
+
+    m_name = name;
+    m_owner = true;
+
+    return true;
+}
+
+bool StatsSegment::attach(const string& name, bool writable) {
+    close();
+
+    int fd = shm_open(name.c_str(), (writable ? O_RDWR : O_RDONLY) | O_CLOEXEC, 0);
+    if (fd < 0) {
+        Log::error("failed to open stats segment " + name + ": " + strerror(errno));
+        return false;
+    }
+
+    struct stat st{};
+    bool ok = fstat(fd, &st) == 0
+            && static_cast<size_t>(st.st_size) >= sizeFor(0)
+            && map(fd, static_cast<size_t>(st.st_size), writable);
+    ::close(fd);
+
+    if (!ok || memcmp(header()->magic, magic, sizeof(magic)) != 0 || header()->version != version
+            || sizeFor(header()->slots) > m_size) {
+        Log::error("stats segment " + name + " has an unknown format");
+        close();
+        return false;
+    }
+
+    m_name = name;
+    return true;
+}
+
+void StatsSegment::close() {
+    if (m_data) {
+        munmap(m_data, m_size);
+        m_data = nullptr;
+        m_size = 0;
+    }
+
+    if (m_owner)
+        shm_unlink(m_name.c_str());
+
+    m_owner = false;
+    m_name.clear();
+}
+
+bool StatsSegment::isOpen() const {
+    return m_data != nullptr;
+}
+
+uint32_t StatsSegment::slots() const {
+    return m_data ? header()->slots : 0;
+}
+
+StatsSegment::Slot* StatsSegment::slot(uint32_t index) const {
+    if (index >= slots()) return nullptr;
+
+    auto* first = static_cast<char*>(m_data) + sizeFor(0);
+    return reinterpret_cast<Slot*>(first) + index;
+}
+
+int64_t StatsSegment::now() {
+    auto since = chrono::system_clock::now().time_since_epoch();
+    return chrono::duration_cast<chrono::milliseconds>(since).count();
+}
+
+const char* StatsSegment::name(WorkerState state) {
+    switch (state) {
+        case Idle: return "idle";
+        case Running: return "running";
+        case Backoff: return "backoff";
+        case Stopping: return "stopping";
+    }
+    return "unknown";
+}
+
+const char* StatsSegment::name(Stat stat) {
+    switch (stat) {
+        case MixedAudioFrames: return "mixed_audio_frames";
+        case MixedAudioBytes: return "mixed_audio_bytes";
+        case OneWayAudioFrames: return "one_way_audio_frames";
+        case OneWayAudioBytes: return "one_way_audio_bytes";
+        case VideoFrames: return "video_frames";
+        case VideoBytes: return "video_bytes";
+        case FramesGated: return "frames_gated";
+        case FramesDropped: return "frames_dropped";
+        case ExecutorQueue: return "executor_queue";
+        case ChatQueue: return "chat_queue";
+        case PurgeQueue: return "purge_queue";
+        case ConsentPolls: return "consent_polls";
+        case ConsentPollFailures: return "consent_poll_failures";
+        case ConsentPollLatency: return "consent_poll_latency_us";
+        case ConsentPollLatencyMax: return "consent_poll_latency_max_us";
+        case ChatSent: return "chat_sent";
+        case ChatFailed: return "chat_failed";
+        case StatCount: break;
+    }
+    return "unknown";
+}
+
+bool StatsSegment::isGauge(Stat stat) {
+    switch (stat) {
+        case ExecutorQueue:
+        case ChatQueue:
+        case PurgeQueue:
+        case ConsentPollLatency:
+        case ConsentPollLatencyMax:
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool StatsSegment::map(int fd, size_t size, bool writable) {
+    auto protection = writable ? PROT_READ | PROT_WRITE : PROT_READ;
+    auto* data = mmap(nullptr, size, protection, MAP_SHARED, fd, 0);
+    if (data == MAP_FAILED) return false;
+
+    m_data = data;
+    m_size = size;
+    return true;
+}
+
+StatsSegment::Header* StatsSegment::header() const {
+    return static_cast<Header*>(m_data);
+}
+
+size_t StatsSegment::sizeFor(uint32_t slots) {
+    static_assert(sizeof(Header) <= alignof(Slot), "header must fit before the first slot");
+
+    // slots start on a cache line after the header
+    return alignof(Slot) + sizeof(Slot) * slots;
+}
@@ -0,0 +1,149 @@
+#ifndef MEETING_SDK_LINUX_SAMPLE_STATSSEGMENT_H
+#define MEETING_SDK_LINUX_SAMPLE_STATSSEGMENT_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+using namespace std;
+
+/**
+ * Shared memory segment in /dev/shm that bots publish their stats in.
+ *
+ * The supervisor creates the segment with one slot per worker and every worker
+ * attaches to its own slot, a bot started on its own creates a segment with a
+ * single slot. Each field has a single writer process and is read by others
+ * without locks. Stats are updated with relaxed atomics, each on a cache line
+ * of its own so the SDK threads writing them do not contend.
+ */
+class StatsSegment {
+public:
+    enum WorkerState : uint32_t {
+        Idle,
+        Running,
+        Backoff,
+        Stopping
+    };
+
+    enum Stat : uint32_t {
+        MixedAudioFrames,
+        MixedAudioBytes,
+        OneWayAudioFrames,
+        OneWayAudioBytes,
+        VideoFrames,
+        VideoBytes,
+        FramesGated,
+        FramesDropped,
+        ExecutorQueue,
+        ChatQueue,
+        PurgeQueue,
+        ConsentPolls,
+        ConsentPollFailures,
+        ConsentPollLatency,
+        ConsentPollLatencyMax,
+        ChatSent,
+        ChatFailed,
+        StatCount
+    };
+
+    struct alignas(64) Cell {
+        atomic<uint64_t> value;
+    };
+
+    struct alignas(64) Slot {
+        // written by the supervisor
+        atomic<int32_t> pid;
+        atomic<uint32_t> state;
+        atomic<uint32_t> restarts;
+        atomic<uint64_t> job;
+        atomic<int64_t> startedAt;
+
+        // written by the worker
+        Cell heartbeat;
+        Cell stats[StatCount];
+
+        void add(Stat stat, uint64_t n = 1) {
+            stats[stat].value.fetch_add(n, memory_order_relaxed);
+        }
+
+        void set(Stat stat, uint64_t value) {
+            stats[stat].value.store(value, memory_order_relaxed);
+        }
+
+        uint64_t get(Stat stat) const {
+            return stats[stat].value.load(memory_order_relaxed);
+        }
+    };
+
+    static_assert(atomic<uint64_t>::is_always_lock_free, "shared counters must be lock-free");
+
+private:
+    struct Header {
+        char magic[8];
+        uint32_t version;
+        uint32_t slots;
+    };
+
+    string m_name;
+    void* m_data = nullptr;
+    size_t m_size = 0;
+    bool m_owner = false;
+
+    bool map(int fd, size_t size, bool writable);
+    Header* header() const;
+
+    static size_t sizeFor(uint32_t slots);
+
+public:
+    StatsSegment() = default;
+    ~StatsSegment();
+
+    StatsSegment(const StatsSegment&) = delete;
+    StatsSegment& operator=(const StatsSegment&) = delete;
+
+    /**
+     * Create the segment, replacing one left behind by a previous run
+     * @param name shared memory name, starting with a slash
+     * @param slots number of workers
+     * @return true if the segment is mapped
+     */
+    bool create(const string& name, uint32_t slots);
+
+    /**
+     * Map a segment created by the supervisor
+     * @param name shared memory name, starting with a slash
+     * @param writable false to only read it
+     * @return true if the segment is mapped
+     */
+    bool attach(const string& name, bool writable = true);
+
+    /**
+     * Unmap the segment, the creator also removes it
+     */
+    void close();
+
+    bool isOpen() const;
+    uint32_t slots() const;
+
+    /**
+     * @return slot of a worker, nullptr if out of range
+     */
+    Slot* slot(uint32_t index) const;
+
+    /**
+     * @return milliseconds since the epoch, the unit of the time fields
+     */
+    static int64_t now();
+
+    static const char* name(WorkerState state);
+    static const char* name(Stat stat);
+
+    /**
+     * @return true if the stat is a current value rather than a running total
+     */
+    static bool isGauge(Stat stat);
+};
+
+
+#endif //MEETING_SDK_LINUX_SAMPLE_STATSSEGMENT_H
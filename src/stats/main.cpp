@@ -0,0 +1,160 @@
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <dirent.h>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <CLI/CLI.hpp>
+
+#include "StatsSegment.h"
+
+using namespace std;
+
+/**
+ * Segments in /dev/shm that look like they belong to a bot or a supervisor
+ */
+static vector<string> findSegments() {
+    vector<string> names;
+
+    if (auto* dir = opendir("/dev/shm")) {
+        while (auto* entry = readdir(dir)) {
+            string name = entry->d_name;
+            if (name.rfind("zoomsdk-", 0) == 0)
+                names.push_back("/" + name);
+        }
+        closedir(dir);
+    }
+
+    sort(names.begin(), names.end());
+    return names;
+}
+
+static string age(int64_t since) {
+    auto seconds = (StatsSegment::now() - since) / 1000;
+
+    stringstream ss;
+    if (seconds >= 3600) ss << seconds / 3600 << "h" << seconds % 3600 / 60 << "m";
+    else if (seconds >= 60) ss << seconds / 60 << "m" << seconds % 60 << "s";
+    else ss << seconds << "s";
+
+    return ss.str();
+}
+
+/**
+ * Print one slot, with rates of the counters since the previous sample
+ */
+static void print(const StatsSegment::Slot& slot, uint32_t index, vector<uint64_t>& previous, double elapsed) {
+    auto pid = slot.pid.load(memory_order_relaxed);
+    auto state = static_cast<StatsSegment::WorkerState>(slot.state.load(memory_order_relaxed));
+    auto heartbeat = static_cast<int64_t>(slot.heartbeat.value.load(memory_order_relaxed));
+
+    cout << "  worker " << index << ": " << StatsSegment::name(state);
+    if (pid) {
+        cout << ", pid " << pid;
+        if (kill(pid, 0) < 0 && errno == ESRCH) cout << " (gone)";
+    }
+
+    if (auto job = slot.job.load(memory_order_relaxed)) cout << ", job " << job;
+    if (pid) cout << ", up " << age(slot.startedAt.load(memory_order_relaxed));
+    cout << ", " << slot.restarts.load(memory_order_relaxed) << " restarts";
+    if (heartbeat) cout << ", heartbeat " << age(heartbeat) << " ago";
+    cout << endl;
+
+    for (uint32_t i = 0; i < StatsSegment::StatCount; ++i) {
+        auto stat = static_cast<StatsSegment::Stat>(i);
+        auto value = slot.get(stat);
+
+        cout << "    " << left << setw(30) << StatsSegment::name(stat) << right << setw(14) << value;
+
+        if (!StatsSegment::isGauge(stat) && elapsed > 0 && value >= previous[i])
+            cout << setw(12) << fixed << setprecision(1) << (value - previous[i]) / elapsed << "/s";
+
+        cout << endl;
+        previous[i] = value;
+    }
+}
+
+int main(int argc, char** argv) {
+    CLI::App app("Live stats of running Zoom Meeting SDK bots", "zoomsdk-stat");
+
+    vector<string> names;
+    int pid = 0;
+    double interval = 1;
+    int count = 0;
+    bool all = false;
+
+    app.add_option("segments", names, "Stats segments to read, every zoomsdk-* segment by default");
+    app.add_option("-p, --pid", pid, "Read the segment of a bot started without the supervisor");
+    app.add_option("-i, --interval", interval, "Seconds between samples")->capture_default_str();
+    app.add_option("-n, --count", count, "Number of samples, 0 to run until interrupted")->capture_default_str();
+    app.add_flag("-a, --all", all, "Also show idle workers");
+
+    try {
+        app.parse(argc, argv);
+    } catch (const CLI::ParseError& err) {
+        return app.exit(err);
+    }
+
+    if (pid) names.push_back("/zoomsdk-" + to_string(pid));
+    if (names.empty()) names = findSegments();
+
+    if (names.empty()) {
+        cerr << "no stats segments found in /dev/shm" << endl;
+        return 1;
+    }
+
+    // mapped read-only and read with relaxed loads, the bots never wait on a reader
+    vector<unique_ptr<StatsSegment>> segments;
+    vector<string> opened;
+
+    for (const auto& name : names) {
+        auto segment = make_unique<StatsSegment>();
+        if (!segment->attach(name, false)) continue;
+
+        segments.push_back(move(segment));
+        opened.push_back(name);
+    }
+
+    if (segments.empty())
+        return 1;
+
+    vector<vector<vector<uint64_t>>> previous(segments.size());
+    for (size_t s = 0; s < segments.size(); ++s)
+        previous[s].assign(segments[s]->slots(), vector<uint64_t>(StatsSegment::StatCount, 0));
+
+    auto last = chrono::steady_clock::now();
+    double elapsed = 0;
+
+    for (int sample = 0; count == 0 || sample < count; ++sample) {
+        if (sample) {
+            this_thread::sleep_for(chrono::duration<double>(interval));
+
+            auto now = chrono::steady_clock::now();
+            elapsed = chrono::duration<double>(now - last).count();
+            last = now;
+        }
+
+        for (size_t s = 0; s < segments.size(); ++s) {
+            cout << opened[s] << endl;
+
+            for (uint32_t i = 0; i < segments[s]->slots(); ++i) {
+                auto* slot = segments[s]->slot(i);
+                if (!all && !slot->pid.load(memory_order_relaxed) && !slot->job.load(memory_order_relaxed))
+                    continue;
+
+                print(*slot, i, previous[s][i], elapsed);
+            }
+        }
+
+        cout << endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,266 @@
+#include "JobQueue.h"
+
+#include <cerrno>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <glib-unix.h>
+
+#include "../util/Log.h"
+
+JobQueue::~JobQueue() {
+    close();
+}
+
+bool JobQueue::follow(const string& path) {
+    m_fileFd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (m_fileFd < 0) {
+        Log::error("failed to open job file " + path + ": " + strerror(errno));
+        return false;
+    }
+
+    m_path = path;
+    m_offset = 0;
+
+    readFile();
+    m_followSource = g_timeout_add_seconds(1, onFollow, this);
+
+    return true;
+}
+
+bool JobQueue::listen(const string& path) {
+    sockaddr_un address{};
+    if (path.size() >= sizeof(address.sun_path)) {
+        Log::error("job socket path is too long: " + path);
+        return false;
+    }
+
+    m_listenFd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (m_listenFd < 0) {
+        Log::error(string("failed to create job socket: ") + strerror(errno));
+        return false;
+    }
+
+    address.sun_family = AF_UNIX;
+    strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+
+    // a socket left behind by a previous run would fail the bind
+    unlink(path.c_str());
+
+    if (bind(m_listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 || ::listen(m_listenFd, 16) < 0) {
+        Log::error("failed to listen on job socket " + path + ": " + strerror(errno));
+        ::close(m_listenFd);
+        m_listenFd = -1;
+        return false;
+    }
+
+    m_socketPath = path;
+    m_listenSource = g_unix_fd_add(m_listenFd, G_IO_IN, onAccept, this);
+
+    return true;
+}
+
+void JobQueue::close() {
+    if (m_followSource) {
+        g_source_remove(m_followSource);
+        m_followSource = 0;
+    }
+
+    if (m_fileFd >= 0) {
+        ::close(m_fileFd);
+        m_fileFd = -1;
+    }
+
+    while (!m_clients.empty())
+        dropClient(m_clients.begin()->first);
+
+    if (m_listenSource) {
+        g_source_remove(m_listenSource);
+        m_listenSource = 0;
+    }
+
+    if (m_listenFd >= 0) {
+        ::close(m_listenFd);
+        m_listenFd = -1;
+        unlink(m_socketPath.c_str());
+    }
+}
+
+void JobQueue::setOnJob(const Listener& callback) {
+    m_onJob = callback;
+}
+
+bool JobQueue::empty() const {
+    return m_jobs.empty();
+}
+
+size_t JobQueue::size() const {
+    return m_jobs.size();
+}
+
+JobQueue::Job JobQueue::pop() {
+    auto job = move(m_jobs.front());
+    m_jobs.pop_front();
+
+    return job;
+}
+
+void JobQueue::readFile() {
+    struct stat st{};
+    if (fstat(m_fileFd, &st) < 0) return;
+
+    // truncated, start over with what is in it now
+    if (st.st_size < m_offset) {
+        Log::info("job file " + m_path + " was truncated");
+        m_offset = 0;
+        m_partial.clear();
+    }
+
+    auto before = m_jobs.size();
+
+    char buffer[4096];
+    for (;;) {
+        auto n = pread(m_fileFd, buffer, sizeof(buffer), m_offset);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) break;
+
+        m_offset += n;
+        consume(m_partial, buffer, n, -1);
+    }
+
+    if (m_jobs.size() > before && m_onJob)
+        m_onJob();
+}
+
+void JobQueue::consume(string& partial, const char* data, size_t size, int replyFd) {
+    partial.append(data, size);
+
+    size_t start = 0;
+    for (auto end = partial.find('\n'); end != string::npos; end = partial.find('\n', start)) {
+        auto line = partial.substr(start, end - start);
+        start = end + 1;
+
+        auto id = queue(line);
+        if (replyFd < 0 || id == UINT64_MAX) continue;
+
+        auto reply = id ? "queued " + to_string(id) + "\n" : string("error unbalanced quotes\n");
+        send(replyFd, reply.data(), reply.size(), MSG_NOSIGNAL | MSG_DONTWAIT);
+    }
+
+    partial.erase(0, start);
+}
+
+uint64_t JobQueue::queue(const string& line) {
+    auto first = line.find_first_not_of(" \t\r");
+
+    // blank lines and comments are not jobs
+    if (first == string::npos || line[first] == '#')
+        return UINT64_MAX;
+
+    Job job;
+    if (!split(line, job.args)) {
+        Log::error("ignoring job with unbalanced quotes: " + line);
+        return 0;
+    }
+
+    job.id = m_nextId++;
+    Log::info("queued job " + to_string(job.id) + ": " + line.substr(first));
+
+    m_jobs.push_back(move(job));
+    return m_jobs.back().id;
+}
+
+void JobQueue::dropClient(int fd) {
+    auto it = m_clients.find(fd);
+    if (it == m_clients.end()) return;
+
+    g_source_remove(it->second.source);
+    ::close(fd);
+
+    m_clients.erase(it);
+}
+
+bool JobQueue::split(const string& line, vector<string>& args) {
+    args.clear();
+
+    string arg;
+    bool quoted = false, inArg = false;
+
+    for (char c : line) {
+        if (c == '"') {
+            quoted = !quoted;
+            inArg = true;
+        } else if (!quoted && (c == ' ' || c == '\t' || c == '\r')) {
+            if (inArg) args.push_back(move(arg));
+            arg.clear();
+            inArg = false;
+        } else {
+            arg += c;
+            inArg = true;
+        }
+    }
+
+    if (inArg) args.push_back(move(arg));
+
+    return !quoted;
+}
+
+gboolean JobQueue::onFollow(gpointer data) {
+    static_cast<JobQueue*>(data)->readFile();
+    return G_SOURCE_CONTINUE;
+}
+
+gboolean JobQueue::onAccept(gint fd, GIOCondition condition, gpointer data) {
+    auto* self = static_cast<JobQueue*>(data);
+
+    for (;;) {
+        int client = accept4(fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (client < 0) break;
+
+        self->m_clients[client] = {g_unix_fd_add(client, static_cast<GIOCondition>(G_IO_IN | G_IO_HUP | G_IO_ERR), onClient, self), ""};
+    }
+
+    return G_SOURCE_CONTINUE;
+}
+
+gboolean JobQueue::onClient(gint fd, GIOCondition condition, gpointer data) {
+    auto* self = static_cast<JobQueue*>(data);
+    auto& client = self->m_clients[fd];
+    auto before = self->m_jobs.size();
+
+    char buffer[4096];
+    bool closed = false;
+
+    for (;;) {
+        auto n = read(fd, buffer, sizeof(buffer));
+        if (n < 0 && errno == EINTR) continue;
+
+        if (n > 0) {
+            self->consume(client.partial, buffer, n, fd);
+            continue;
+        }
+
+        closed = n == 0 || errno != EAGAIN;
+        break;
+    }
+
+    if (closed) {
+        // a last line without a newline still counts
+        if (!client.partial.empty())
+            self->consume(client.partial, "\n", 1, fd);
+
+        // the source is removed by returning, only close the fd
+        ::close(fd);
+        self->m_clients.erase(fd);
+    }
+
+    if (self->m_jobs.size() > before && self->m_onJob)
+        self->m_onJob();
+
+    return closed ? G_SOURCE_REMOVE : G_SOURCE_CONTINUE;
+}
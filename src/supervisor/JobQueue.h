@@ -0,0 +1,111 @@
+#ifndef MEETING_SDK_LINUX_SAMPLE_JOBQUEUE_H
+#define MEETING_SDK_LINUX_SAMPLE_JOBQUEUE_H
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <glib.h>
+
+using namespace std;
+
+/**
+ * Meetings waiting for a bot worker.
+ *
+ * Each job is one line of zoomsdk arguments, double quoted where an argument
+ * holds spaces. Lines come from a file that is followed like tail -f, so
+ * appending a line queues a meeting, and from clients of a unix socket, who
+ * get back the id of every job they queued.
+ */
+class JobQueue {
+public:
+    struct Job {
+        uint64_t id = 0;
+        vector<string> args;
+    };
+
+    typedef function<void()> Listener;
+
+private:
+    struct Client {
+        guint source;
+        string partial;
+    };
+
+    deque<Job> m_jobs;
+    uint64_t m_nextId = 1;
+    Listener m_onJob;
+
+    int m_fileFd = -1;
+    string m_path;
+    off_t m_offset = 0;
+    string m_partial;
+    guint m_followSource = 0;
+
+    int m_listenFd = -1;
+    string m_socketPath;
+    guint m_listenSource = 0;
+    unordered_map<int, Client> m_clients;
+
+    void readFile();
+    void consume(string& partial, const char* data, size_t size, int replyFd);
+    uint64_t queue(const string& line);
+    void dropClient(int fd);
+
+    static gboolean onFollow(gpointer data);
+    static gboolean onAccept(gint fd, GIOCondition condition, gpointer data);
+    static gboolean onClient(gint fd, GIOCondition condition, gpointer data);
+
+public:
+    JobQueue() = default;
+    ~JobQueue();
+
+    JobQueue(const JobQueue&) = delete;
+    JobQueue& operator=(const JobQueue&) = delete;
+
+    /**
+     * Queue every line of a file and those appended to it later
+     * @param path job file
+     * @return true if the file could be opened
+     */
+    bool follow(const string& path);
+
+    /**
+     * Accept jobs on a unix stream socket
+     * @param path socket path, replaced if it exists
+     * @return true if the socket is listening
+     */
+    bool listen(const string& path);
+
+    /**
+     * Stop reading jobs, those already queued stay
+     */
+    void close();
+
+    /**
+     * @param callback fired on the main loop whenever jobs were queued
+     */
+    void setOnJob(const Listener& callback);
+
+    bool empty() const;
+    size_t size() const;
+
+    /**
+     * @return the oldest queued job
+     */
+    Job pop();
+
+    /**
+     * Split a line into arguments on whitespace, honoring double quotes
+     * @param line job line
+     * @param args arguments found
+     * @return false if a quote is left open
+     */
+    static bool split(const string& line, vector<string>& args);
+};
+
+
+#endif //MEETING_SDK_LINUX_SAMPLE_JOBQUEUE_H
@@ -0,0 +1,398 @@
+#include "Supervisor.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <filesystem>
+#include <sstream>
+
+#include <fcntl.h>
+#include <sys/prctl.h>
+#include <sys/signalfd.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <glib-unix.h>
+
+#include "../util/Log.h"
+
+extern char** environ;
+
+Supervisor::Supervisor(const SupervisorConfig& config) : m_config(config)
+{
+
+}
+
+Supervisor::~Supervisor() {
+    m_jobs.close();
+
+    if (m_signalSource)
+        g_source_remove(m_signalSource);
+
+    if (m_signalFd >= 0)
+        close(m_signalFd);
+}
+
+bool Supervisor::start(GMainLoop* loop) {
+    m_loop = loop;
+
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGCHLD);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+
+    if (sigprocmask(SIG_BLOCK, &signals, nullptr) < 0 || (m_signalFd = signalfd(-1, &signals, SFD_NONBLOCK | SFD_CLOEXEC)) < 0) {
+        Log::error(string("failed to watch for signals: ") + strerror(errno));
+        return false;
+    }
+
+    m_signalSource = g_unix_fd_add(m_signalFd, G_IO_IN, onSignal, this);
+
+    auto count = static_cast<uint32_t>(m_config.workers());
+    if (!m_stats.create(m_config.statsName(), count))
+        return false;
+
+    const auto& cpus = m_config.cpus();
+    auto perWorker = static_cast<size_t>(m_config.cpusPerWorker());
+
+    if (count * perWorker > cpus.size())
+        Log::info("more workers than CPUs, workers will share CPUs");
+
+    m_workers.resize(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        auto& worker = m_workers[i];
+        worker.index = i;
+        worker.stats = m_stats.slot(i);
+
+        CPU_ZERO(&worker.cpus);
+        for (size_t j = 0; j < perWorker; ++j)
+            CPU_SET(cpus[(i * perWorker + j) % cpus.size()], &worker.cpus);
+    }
+
+    m_jobs.setOnJob([this]() { dispatch(); });
+
+    if (!m_config.jobFile().empty() && !m_jobs.follow(m_config.jobFile()))
+        return false;
+
+    if (!m_config.jobSocket().empty() && !m_jobs.listen(m_config.jobSocket()))
+        return false;
+
+    if (m_config.heartbeatTimeout() > 0)
+        m_timers.every(chrono::seconds(1), [this]() { checkHeartbeats(); });
+
+    if (m_config.reportInterval() > 0)
+        m_timers.every(chrono::seconds(m_config.reportInterval()), [this]() { report(); });
+
+    Log::success("supervising " + to_string(count) + " workers, stats in " + m_config.statsName());
+
+    dispatch();
+    return true;
+}
+
+void Supervisor::dispatch() {
+    if (m_stopping) return;
+
+    for (auto& worker : m_workers) {
+        if (m_jobs.empty()) return;
+        if (worker.busy) continue;
+
+        worker.busy = true;
+        worker.failures = 0;
+        worker.job = m_jobs.pop();
+        worker.stats->job.store(worker.job.id, memory_order_relaxed);
+
+        if (!spawn(worker))
+            onWorkerExit(worker, -1);
+    }
+}
+
+bool Supervisor::spawn(Worker& worker) {
+    auto dir = m_config.workDir() + "/job-" + to_string(worker.job.id);
+
+    error_code ec;
+    filesystem::create_directories(dir, ec);
+    if (ec) {
+        Log::error("failed to create working directory " + dir + ": " + ec.message());
+        return false;
+    }
+
+    // the worker runs in its own directory, paths handed to it must be absolute
+    vector<string> args{filesystem::absolute(m_config.worker(), ec).string()};
+    if (filesystem::exists(m_config.workerConfig(), ec)) {
+        args.emplace_back("--config");
+        args.push_back(filesystem::absolute(m_config.workerConfig(), ec).string());
+    }
+    args.insert(args.end(), worker.job.args.begin(), worker.job.args.end());
+
+    vector<string> env;
+    for (auto** var = environ; *var; ++var) {
+        if (strncmp(*var, "ZOOMSDK_STATS=", 14) != 0 && strncmp(*var, "ZOOMSDK_WORKER=", 15) != 0)
+            env.emplace_back(*var);
+    }
+    env.push_back("ZOOMSDK_STATS=" + m_config.statsName());
+    env.push_back("ZOOMSDK_WORKER=" + to_string(worker.index));
+
+    // everything the child needs is prepared before fork, it may only make system calls
+    vector<char*> argv, envp;
+    for (auto& arg : args) argv.push_back(&arg[0]);
+    for (auto& var : env) envp.push_back(&var[0]);
+    argv.push_back(nullptr);
+    envp.push_back(nullptr);
+
+    auto log = dir + "/worker.log";
+    auto parent = getpid();
+
+    auto pid = fork();
+    if (pid < 0) {
+        Log::error(string("failed to fork a worker: ") + strerror(errno));
+        return false;
+    }
+
+    if (pid == 0) {
+        sigset_t none;
+        sigemptyset(&none);
+        sigprocmask(SIG_SETMASK, &none, nullptr);
+
+        // do not outlive the supervisor
+        prctl(PR_SET_PDEATHSIG, SIGTERM);
+        if (getppid() != parent) _exit(1);
+
+        sched_setaffinity(0, sizeof(worker.cpus), &worker.cpus);
+
+        int fd = open(log.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+        if (fd >= 0) {
+            dup2(fd, STDOUT_FILENO);
+            dup2(fd, STDERR_FILENO);
+            close(fd);
+        }
+
+        if (chdir(dir.c_str()) < 0) _exit(126);
+
+        execve(argv[0], argv.data(), envp.data());
+        _exit(127);
+    }
+
+    worker.pid = pid;
+    worker.startedAt = chrono::steady_clock::now();
+
+    worker.stats->pid.store(pid, memory_order_relaxed);
+    worker.stats->startedAt.store(StatsSegment::now(), memory_order_relaxed);
+    worker.stats->state.store(StatsSegment::Running, memory_order_relaxed);
+
+    stringstream ss;
+    ss << "job " << worker.job.id << " started in worker " << worker.index << " (pid " << pid << ", log " << log << ")";
+    Log::info(ss.str());
+
+    return true;
+}
+
+void Supervisor::reap() {
+    int status;
+    pid_t pid;
+
+    while ((pid = waitpid(-1, &status, WNOHANG)) > 0) {
+        auto it = find_if(m_workers.begin(), m_workers.end(), [pid](const Worker& w) { return w.pid == pid; });
+        if (it != m_workers.end())
+            onWorkerExit(*it, status);
+    }
+}
+
+void Supervisor::onWorkerExit(Worker& worker, int status) {
+    auto ran = chrono::steady_clock::now() - worker.startedAt;
+
+    worker.pid = 0;
+    worker.stats->pid.store(0, memory_order_relaxed);
+
+    // the next worker in this slot starts from zero
+    for (uint32_t i = 0; i < StatsSegment::StatCount; ++i) {
+        auto stat = static_cast<StatsSegment::Stat>(i);
+        auto value = worker.stats->stats[i].value.exchange(0, memory_order_relaxed);
+
+        if (!StatsSegment::isGauge(stat))
+            m_retired[i] += value;
+    }
+    worker.stats->heartbeat.value.store(0, memory_order_relaxed);
+
+    auto job = "job " + to_string(worker.job.id);
+
+    if (m_stopping) {
+        Log::info(job + " stopped: " + describe(status));
+        release(worker);
+
+        if (!running())
+            g_main_loop_quit(m_loop);
+        return;
+    }
+
+    if (status >= 0 && WIFEXITED(status) && WEXITSTATUS(status) == 0) {
+        Log::success(job + " finished");
+        release(worker);
+        dispatch();
+        return;
+    }
+
+    // a worker that ran for a while before crashing starts over with the shortest backoff
+    if (status >= 0 && ran >= chrono::seconds(m_config.stableAfter()))
+        worker.failures = 0;
+
+    if (++worker.failures > m_config.maxRestarts()) {
+        Log::error(job + " " + describe(status) + ", giving up after " + to_string(worker.failures) + " attempts");
+        release(worker);
+        dispatch();
+        return;
+    }
+
+    auto shift = min(worker.failures - 1, 16);
+    auto delay = min(m_config.backoffMax(), m_config.backoffMin() << shift);
+
+    Log::error(job + " " + describe(status) + ", restarting in " + to_string(delay) + "s");
+
+    worker.stats->state.store(StatsSegment::Backoff, memory_order_relaxed);
+    worker.stats->restarts.fetch_add(1, memory_order_relaxed);
+
+    auto index = worker.index;
+    worker.restartTimer = m_timers.after(chrono::seconds(delay), [this, index]() {
+        auto& w = m_workers[index];
+        w.restartTimer = 0;
+
+        if (!spawn(w))
+            onWorkerExit(w, -1);
+    });
+}
+
+void Supervisor::release(Worker& worker) {
+    if (worker.restartTimer) {
+        m_timers.cancel(worker.restartTimer);
+        worker.restartTimer = 0;
+    }
+
+    worker.busy = false;
+    worker.job = {};
+    worker.failures = 0;
+
+    worker.stats->job.store(0, memory_order_relaxed);
+    worker.stats->state.store(StatsSegment::Idle, memory_order_relaxed);
+}
+
+void Supervisor::stop() {
+    // a second signal does not wait any longer
+    if (m_stopping) {
+        Log::info("killing remaining workers");
+        for (auto& worker : m_workers) {
+            if (worker.pid) kill(worker.pid, SIGKILL);
+        }
+        return;
+    }
+
+    m_stopping = true;
+    m_jobs.close();
+
+    if (!m_jobs.empty())
+        Log::info(to_string(m_jobs.size()) + " queued jobs were not started");
+
+    for (auto& worker : m_workers) {
+        if (worker.pid) {
+            kill(worker.pid, SIGTERM);
+            worker.stats->state.store(StatsSegment::Stopping, memory_order_relaxed);
+        } else if (worker.busy) {
+            release(worker);
+        }
+    }
+
+    if (!running()) {
+        g_main_loop_quit(m_loop);
+        return;
+    }
+
+    Log::info("waiting for " + to_string(running()) + " workers to shut down");
+
+    m_timers.after(chrono::seconds(m_config.stopTimeout()), [this]() {
+        for (auto& worker : m_workers) {
+            if (!worker.pid) continue;
+
+            Log::error("worker " + to_string(worker.index) + " did not shut down in time, killing it");
+            kill(worker.pid, SIGKILL);
+        }
+    });
+}
+
+void Supervisor::checkHeartbeats() {
+    auto now = StatsSegment::now();
+    auto timeout = static_cast<int64_t>(m_config.heartbeatTimeout()) * 1000;
+
+    for (auto& worker : m_workers) {
+        if (!worker.pid || m_stopping) continue;
+
+        // a worker that has not attached yet is measured from its start
+        auto heartbeat = static_cast<int64_t>(worker.stats->heartbeat.value.load(memory_order_relaxed));
+        auto last = max(heartbeat, worker.stats->startedAt.load(memory_order_relaxed));
+        if (now - last < timeout) continue;
+
+        Log::error("worker " + to_string(worker.index) + " missed its heartbeats, killing it");
+        kill(worker.pid, SIGKILL);
+    }
+}
+
+void Supervisor::report() {
+    size_t backoff = 0;
+    uint64_t restarts = 0;
+
+    for (uint32_t i = 0; i < m_stats.slots(); ++i) {
+        auto* slot = m_stats.slot(i);
+        if (slot->state.load(memory_order_relaxed) == StatsSegment::Backoff) ++backoff;
+
+        restarts += slot->restarts.load(memory_order_relaxed);
+    }
+
+    auto frames = total(StatsSegment::MixedAudioFrames) + total(StatsSegment::OneWayAudioFrames) + total(StatsSegment::VideoFrames);
+
+    stringstream ss;
+    ss << running() << "/" << m_workers.size() << " workers running, " << backoff << " in backoff, "
+       << m_jobs.size() << " jobs queued, " << restarts << " restarts, "
+       << frames << " frames written, " << total(StatsSegment::FramesDropped) << " dropped, "
+       << total(StatsSegment::ChatSent) << " chat messages sent";
+
+    Log::info(ss.str());
+}
+
+uint64_t Supervisor::total(StatsSegment::Stat stat) const {
+    uint64_t sum = m_retired[stat];
+    for (uint32_t i = 0; i < m_stats.slots(); ++i)
+        sum += m_stats.slot(i)->get(stat);
+
+    return sum;
+}
+
+size_t Supervisor::running() const {
+    return count_if(m_workers.begin(), m_workers.end(), [](const Worker& w) { return w.pid != 0; });
+}
+
+string Supervisor::describe(int status) {
+    if (status < 0) return "failed to start";
+
+    if (WIFSIGNALED(status))
+        return string("was killed by ") + strsignal(WTERMSIG(status));
+
+    auto code = WEXITSTATUS(status);
+    if (code == 127) return "could not run the worker binary";
+
+    return "exited with status " + to_string(code);
+}
+
+gboolean Supervisor::onSignal(gint fd, GIOCondition condition, gpointer data) {
+    auto* self = static_cast<Supervisor*>(data);
+
+    signalfd_siginfo info{};
+    while (read(fd, &info, sizeof(info)) == sizeof(info)) {
+        if (info.ssi_signo == SIGCHLD) {
+            self->reap();
+        } else {
+            Log::info(string("received ") + strsignal(info.ssi_signo));
+            self->stop();
+        }
+    }
+
+    return G_SOURCE_CONTINUE;
+}
@@ -0,0 +1,88 @@
+#ifndef MEETING_SDK_LINUX_SAMPLE_SUPERVISOR_H
+#define MEETING_SDK_LINUX_SAMPLE_SUPERVISOR_H
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include <glib.h>
+#include <sched.h>
+#include <sys/types.h>
+
+#include "SupervisorConfig.h"
+#include "JobQueue.h"
+#include "../stats/StatsSegment.h"
+#include "../util/TimerWheel.h"
+
+using namespace std;
+
+/**
+ * Runs a fleet of zoomsdk workers, one process per meeting.
+ *
+ * Each worker slot takes the next job from the queue and forks a zoomsdk
+ * process for it, pinned to its own CPUs and running in its own working
+ * directory. A worker that exits cleanly frees its slot; one that crashes or
+ * stops sending heartbeats is restarted with exponential backoff until the
+ * job is given up. Workers publish their stats in a shared memory segment
+ * the supervisor aggregates.
+ */
+class Supervisor {
+    struct Worker {
+        uint32_t index;
+        cpu_set_t cpus;
+        StatsSegment::Slot* stats = nullptr;
+
+        pid_t pid = 0;
+        bool busy = false;
+        JobQueue::Job job;
+        int failures = 0;
+        chrono::steady_clock::time_point startedAt;
+        TimerWheel::Id restartTimer = 0;
+    };
+
+    const SupervisorConfig& m_config;
+    GMainLoop* m_loop = nullptr;
+
+    JobQueue m_jobs;
+    TimerWheel m_timers;
+    StatsSegment m_stats;
+    vector<Worker> m_workers;
+
+    // totals of workers that exited, their slots are reused
+    uint64_t m_retired[StatsSegment::StatCount] = {};
+
+    int m_signalFd = -1;
+    guint m_signalSource = 0;
+    bool m_stopping = false;
+
+    void dispatch();
+    bool spawn(Worker& worker);
+    void reap();
+    void onWorkerExit(Worker& worker, int status);
+    void release(Worker& worker);
+    void stop();
+    void checkHeartbeats();
+    void report();
+    size_t running() const;
+    uint64_t total(StatsSegment::Stat stat) const;
+
+    static gboolean onSignal(gint fd, GIOCondition condition, gpointer data);
+    static string describe(int status);
+
+public:
+    explicit Supervisor(const SupervisorConfig& config);
+    ~Supervisor();
+
+    Supervisor(const Supervisor&) = delete;
+    Supervisor& operator=(const Supervisor&) = delete;
+
+    /**
+     * Create the stats segment, open the job sources and start taking jobs
+     * @param loop main loop quit once every worker stopped after a signal
+     * @return false if the supervisor cannot run
+     */
+    bool start(GMainLoop* loop);
+};
+
+
+#endif //MEETING_SDK_LINUX_SAMPLE_SUPERVISOR_H
@@ -0,0 +1,171 @@
+#include "SupervisorConfig.h"
+
+#include <sched.h>
+#include <unistd.h>
+
+#include <climits>
+#include <iostream>
+#include <sstream>
+
+SupervisorConfig::SupervisorConfig() : m_app(m_name, "zoomsdk-supervisor")
+{
+    m_app.add_option("-w, --workers", m_workers, "Number of meetings run at the same time")->capture_default_str();
+    m_app.add_option("--worker", m_worker, "Path of the zoomsdk binary, next to this one by default");
+    m_app.add_option("--worker-config", m_workerConfig, "Config file passed to every worker")->capture_default_str();
+    m_app.add_option("--work-dir", m_workDir, "Directory holding one working directory per job")->capture_default_str();
+
+    m_app.add_option("-j, --jobs", m_jobFile, "Job file with the zoomsdk arguments of one meeting per line, followed for new lines");
+    m_app.add_option("--socket", m_jobSocket, "Unix socket accepting job lines");
+
+    m_app.add_option("--cpus", m_cpuList, "CPUs to pin workers to, like 0-3,8, all usable CPUs by default");
+    m_app.add_option("--cpus-per-worker", m_cpusPerWorker, "CPUs each worker is pinned to")->capture_default_str();
+
+    m_app.add_option("--backoff-min", m_backoffMin, "Seconds before restarting a crashed worker the first time")->capture_default_str();
+    m_app.add_option("--backoff-max", m_backoffMax, "Maximum seconds before restarting a crashed worker")->capture_default_str();
+    m_app.add_option("--max-restarts", m_maxRestarts, "Restarts of a crashing job before it is given up")->capture_default_str();
+    m_app.add_option("--stable-after", m_stableAfter, "Seconds a worker must run for its crash count to reset")->capture_default_str();
+
+    m_app.add_option("--stop-timeout", m_stopTimeout, "Seconds workers get to shut down before they are killed")->capture_default_str();
+    m_app.add_option("--heartbeat-timeout", m_heartbeatTimeout, "Seconds without a heartbeat before a worker is restarted, 0 to disable")->capture_default_str();
+
+    m_app.add_option("--stats", m_statsName, "Name of the shared memory stats segment")->capture_default_str();
+    m_app.add_option("--report-interval", m_reportInterval, "Seconds between aggregated stats in the log, 0 to disable")->capture_default_str();
+}
+
+int SupervisorConfig::read(int ac, char** av) {
+    try {
+        m_app.parse(ac, av);
+    } catch (const CLI::CallForHelp& e) {
+        exit(m_app.exit(e));
+    } catch (const CLI::ParseError& err) {
+        return m_app.exit(err);
+    }
+
+    if (m_jobFile.empty() && m_jobSocket.empty()) {
+        cerr << "--jobs or --socket is required" << endl;
+        return 1;
+    }
+
+    if (m_workers < 1 || m_cpusPerWorker < 1) {
+        cerr << "--workers and --cpus-per-worker must be at least 1" << endl;
+        return 1;
+    }
+
+    if (m_worker.empty()) {
+        char self[PATH_MAX];
+        auto n = readlink("/proc/self/exe", self, sizeof(self) - 1);
+        string path = n > 0 ? string(self, n) : "";
+        auto slash = path.rfind('/');
+
+        m_worker = (slash == string::npos ? "." : path.substr(0, slash)) + "/zoomsdk";
+    }
+
+    if (!m_cpuList.empty()) {
+        if (!parseCpuList(m_cpuList, m_cpus)) {
+            cerr << "unable to parse CPU list " << m_cpuList << endl;
+            return 1;
+        }
+    } else {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        sched_getaffinity(0, sizeof(set), &set);
+
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, &set))
+                m_cpus.push_back(cpu);
+        }
+    }
+
+    return 0;
+}
+
+bool SupervisorConfig::parseCpuList(const string& list, vector<int>& cpus) {
+    cpus.clear();
+
+    string range;
+    istringstream ss(list);
+
+    while (getline(ss, range, ',')) {
+        int first, last;
+        char dash;
+
+        istringstream rs(range);
+        if (!(rs >> first)) return false;
+
+        last = first;
+        if (rs >> dash && (dash != '-' || !(rs >> last)))
+            return false;
+
+        if (first < 0 || last < first || last >= CPU_SETSIZE)
+            return false;
+
+        for (int cpu = first; cpu <= last; ++cpu)
+            cpus.push_back(cpu);
+    }
+
+    return !cpus.empty();
+}
+
+int SupervisorConfig::workers() const {
+    return m_workers;
+}
+
+const string& SupervisorConfig::worker() const {
+    return m_worker;
+}
+
+const string& SupervisorConfig::workerConfig() const {
+    return m_workerConfig;
+}
+
+const string& SupervisorConfig::workDir() const {
+    return m_workDir;
+}
+
+const string& SupervisorConfig::jobFile() const {
+    return m_jobFile;
+}
+
+const string& SupervisorConfig::jobSocket() const {
+    return m_jobSocket;
+}
+
+const vector<int>& SupervisorConfig::cpus() const {
+    return m_cpus;
+}
+
+int SupervisorConfig::cpusPerWorker() const {
+    return m_cpusPerWorker;
+}
+
+int SupervisorConfig::backoffMin() const {
+    return m_backoffMin;
+}
+
+int SupervisorConfig::backoffMax() const {
+    return m_backoffMax;
+}
+
+int SupervisorConfig::maxRestarts() const {
+    return m_maxRestarts;
+}
+
+int SupervisorConfig::stableAfter() const {
+    return m_stableAfter;
+}
+
+int SupervisorConfig::stopTimeout() const {
+    return m_stopTimeout;
+}
+
+int SupervisorConfig::heartbeatTimeout() const {
+    return m_heartbeatTimeout;
+}
+
+const string& SupervisorConfig::statsName() const {
+    return m_statsName;
+}
+
+int SupervisorConfig::reportInterval() const {
+    return m_reportInterval;
+}
@@ -0,0 +1,79 @@
+#ifndef MEETING_SDK_LINUX_SAMPLE_SUPERVISORCONFIG_H
+#define MEETING_SDK_LINUX_SAMPLE_SUPERVISORCONFIG_H
+
+#include <string>
+#include <vector>
+
+#include <CLI/CLI.hpp>
+
+using namespace std;
+
+class SupervisorConfig {
+    const string m_name = "Zoom Meeting SDK for Linux Bot Supervisor";
+
+    CLI::App m_app;
+
+    int m_workers = 4;
+    string m_worker;
+    string m_workerConfig = "config.toml";
+    string m_workDir = "jobs";
+
+    string m_jobFile;
+    string m_jobSocket;
+
+    string m_cpuList;
+    int m_cpusPerWorker = 1;
+    vector<int> m_cpus;
+
+    int m_backoffMin = 1;
+    int m_backoffMax = 60;
+    int m_maxRestarts = 5;
+    int m_stableAfter = 60;
+
+    int m_stopTimeout = 10;
+    int m_heartbeatTimeout = 30;
+
+    string m_statsName = "/zoomsdk-stats";
+    int m_reportInterval = 10;
+
+public:
+    SupervisorConfig();
+
+    int read(int ac, char** av);
+
+    /**
+     * Parse a CPU list like 0-3,8,10-11
+     * @param list CPU list
+     * @param cpus CPUs in the list
+     * @return false if the list is malformed
+     */
+    static bool parseCpuList(const string& list, vector<int>& cpus);
+
+    int workers() const;
+    const string& worker() const;
+    const string& workerConfig() const;
+    const string& workDir() const;
+
+    const string& jobFile() const;
+    const string& jobSocket() const;
+
+    /**
+     * CPUs the workers are pinned to, all usable CPUs unless --cpus is given
+     */
+    const vector<int>& cpus() const;
+    int cpusPerWorker() const;
+
+    int backoffMin() const;
+    int backoffMax() const;
+    int maxRestarts() const;
+    int stableAfter() const;
+
+    int stopTimeout() const;
+    int heartbeatTimeout() const;
+
+    const string& statsName() const;
+    int reportInterval() const;
+};
+
+
+#endif //MEETING_SDK_LINUX_SAMPLE_SUPERVISORCONFIG_H
@@ -0,0 +1,22 @@
+#include <glib.h>
+
+#include "SupervisorConfig.h"
+#include "Supervisor.h"
+
+int main(int argc, char** argv) {
+    SupervisorConfig config;
+    if (auto status = config.read(argc, argv))
+        return status;
+
+    GMainLoop* eventLoop = g_main_loop_new(NULL, FALSE);
+
+    // runs until every worker stopped after SIGINT or SIGTERM
+    Supervisor supervisor(config);
+    if (!supervisor.start(eventLoop))
+        return 1;
+
+    g_main_loop_run(eventLoop);
+    g_main_loop_unref(eventLoop);
+
+    return 0;
+}
@@ -0,0 +1,122 @@
+#include "Executor.h"
+
+#include <cerrno>
+#include <cstdint>
+
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <glib-unix.h>
+
+Executor::Executor(GMainContext* context) :
+        m_head(&m_stub),
+        m_tail(&m_stub)
+{
+    m_wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+    m_source = g_unix_fd_source_new(m_wakeFd, G_IO_IN);
+    g_source_set_priority(m_source, G_PRIORITY_DEFAULT);
+    g_source_set_callback(m_source, reinterpret_cast<GSourceFunc>(reinterpret_cast<void (*)()>(onWake)), this, nullptr);
+    g_source_attach(m_source, context);
+}
+
+Executor::~Executor() {
+    g_source_destroy(m_source);
+    g_source_unref(m_source);
+    close(m_wakeFd);
+
+    while (auto* node = pop())
+        delete node;
+}
+
+void Executor::post(function<void()> task) {
+    auto* node = new Node();
+    node->task = move(task);
+    m_pending.fetch_add(1, memory_order_relaxed);
+    push(node);
+
+    if (!m_scheduled.exchange(true))
+        wake();
+}
+
+void Executor::push(Node* node) {
+    node->next.store(nullptr, memory_order_relaxed);
+    auto* prev = m_head.exchange(node, memory_order_acq_rel);
+    prev->next.store(node, memory_order_release);
+}
+
+// Vyukov MPSC pop, only ever called from the consumer thread.
+// Returns nullptr when empty, or while a producer is between its exchange
+// and linking its node; that producer schedules another dispatch after linking.
+Executor::Node* Executor::pop() {
+    auto* tail = m_tail;
+    auto* next = tail->next.load(memory_order_acquire);
+
+    if (tail == &m_stub) {
+        if (!next) return nullptr;
+
+        m_tail = next;
+        tail = next;
+        next = next->next.load(memory_order_acquire);
+    }
+
+    if (next) {
+        m_tail = next;
+        return tail;
+    }
+
+    if (tail != m_head.load(memory_order_acquire))
+        return nullptr;
+
+    push(&m_stub);
+
+    next = tail->next.load(memory_order_acquire);
+    if (next) {
+        m_tail = next;
+        return tail;
+    }
+
+    return nullptr;
+}
+
+void Executor::wake() {
+    // a full counter is still a pending wakeup, nothing else can fail here
+    uint64_t one = 1;
+    while (write(m_wakeFd, &one, sizeof(one)) < 0 && errno == EINTR) {}
+}
+
+size_t Executor::drain(size_t max) {
+    size_t count = 0;
+
+    while (count < max) {
+        auto* node = pop();
+        if (!node) break;
+
+        node->task();
+        delete node;
+        ++count;
+    }
+
+    m_pending.fetch_sub(count, memory_order_relaxed);
+    return count;
+}
+
+size_t Executor::pending() const {
+    return m_pending.load(memory_order_relaxed);
+}
+
+gboolean Executor::onWake(gint fd, GIOCondition condition, gpointer data) {
+    auto* self = static_cast<Executor*>(data);
+
+    uint64_t count;
+    while (read(fd, &count, sizeof(count)) < 0 && errno == EINTR) {}
+
+    // clear first, anything posted from here on wakes us again
+    self->m_scheduled.store(false);
+
+    // more may be queued, come back after other sources had a turn
+    if (self->drain(batch) == batch && !self->m_scheduled.exchange(true))
+        self->wake();
+
+    return G_SOURCE_CONTINUE;
+}
@@ -0,0 +1,76 @@
+#ifndef MEETING_SDK_LINUX_SAMPLE_EXECUTOR_H
+#define MEETING_SDK_LINUX_SAMPLE_EXECUTOR_H
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+
+#include <glib.h>
+
+using namespace std;
+
+/**
+ * Serial executor drained on a glib main context.
+ *
+ * Any thread may post tasks, they are queued on a lock-free multi-producer
+ * single-consumer queue and run one at a time, in order, on the thread
+ * running the main context. State only touched from tasks needs no locks.
+ * The main loop is woken through an eventfd watched by a single persistent
+ * source, only when the queue goes from idle to busy.
+ */
+class Executor {
+    struct Node {
+        atomic<Node*> next{nullptr};
+        function<void()> task;
+    };
+
+    // producers push at the head, the consumer pops at the tail
+    atomic<Node*> m_head;
+    Node* m_tail;
+    Node m_stub;
+
+    atomic<bool> m_scheduled{false};
+    atomic<size_t> m_pending{0};
+    int m_wakeFd = -1;
+    GSource* m_source = nullptr;
+
+    // tasks run per dispatch before yielding back to the main loop
+    static const size_t batch = 256;
+
+    void push(Node* node);
+    Node* pop();
+    void wake();
+
+    static gboolean onWake(gint fd, GIOCondition condition, gpointer data);
+
+public:
+    /**
+     * @param context main context to run tasks on, NULL for the default one
+     */
+    explicit Executor(GMainContext* context = nullptr);
+    ~Executor();
+
+    Executor(const Executor&) = delete;
+    Executor& operator=(const Executor&) = delete;
+
+    /**
+     * Queue a task, safe to call from any thread
+     * @param task runs later on the main context thread
+     */
+    void post(function<void()> task);
+
+    /**
+     * Run queued tasks on the calling thread
+     * @param max maximum number of tasks to run
+     * @return number of tasks run
+     */
+    size_t drain(size_t max = SIZE_MAX);
+
+    /**
+     * @return tasks posted and not run yet, approximate while tasks are posted
+     */
+    size_t pending() const;
+};
+
+
+#endif //MEETING_SDK_LINUX_SAMPLE_EXECUTOR_H
@@ -0,0 +1,284 @@
+#include "TimerWheel.h"
+
+#include <algorithm>
+
+TimerWheel::TimerWheel(Duration tick) :
+        m_tick(max(tick, Duration(1))),
+        m_epoch(chrono::steady_clock::now())
+{
+    for (auto& level : m_slots)
+        fill(begin(level), end(level), none);
+}
+
+TimerWheel::~TimerWheel() {
+    if (m_source)
+        g_source_remove(m_source);
+}
+
+TimerWheel::Id TimerWheel::after(Duration delay, function<void()> callback) {
+    return arm(ticks(delay), 0, move(callback));
+}
+
+TimerWheel::Id TimerWheel::every(Duration interval, function<void()> callback) {
+    auto period = max<uint64_t>(ticks(interval), 1);
+    return arm(period, period, move(callback));
+}
+
+bool TimerWheel::cancel(Id id) {
+    if (!id) return false;
+
+    auto index = static_cast<int32_t>((id & 0xffffffff) - 1);
+    auto generation = static_cast<uint32_t>(id >> 32);
+
+    if (index < 0 || index >= static_cast<int32_t>(m_timers.size()))
+        return false;
+
+    auto& timer = m_timers[index];
+    if (timer.generation != generation || !timer.callback)
+        return false;
+
+    if (timer.level >= 0)
+        unlink(index);
+
+    release(index);
+    reschedule();
+
+    return true;
+}
+
+TimerWheel::Id TimerWheel::arm(uint64_t delay, uint64_t interval, function<void()> callback) {
+    // an idle stretch leaves m_current behind the clock, catch up if nothing is due
+    auto now = elapsed();
+    if (!m_advancing && nextTick() > now)
+        m_current = max(m_current, now);
+
+    int32_t index;
+    if (m_free.empty()) {
+        index = static_cast<int32_t>(m_timers.size());
+        m_timers.emplace_back();
+    } else {
+        index = m_free.back();
+        m_free.pop_back();
+    }
+
+    auto& timer = m_timers[index];
+    timer.expiry = m_current + max<uint64_t>(delay, 1);
+    timer.interval = interval;
+    timer.callback = move(callback);
+
+    insert(index);
+    ++m_active;
+
+    reschedule();
+
+    return (static_cast<uint64_t>(timer.generation) << 32) | static_cast<uint64_t>(index + 1);
+}
+
+void TimerWheel::insert(int32_t index) {
+    auto& timer = m_timers[index];
+
+    const uint64_t range = 1ull << (slotBits * levels);
+    if (timer.expiry - m_current >= range)
+        timer.expiry = m_current + range - 1;
+
+    auto delta = timer.expiry - m_current;
+
+    int level = 0;
+    while (level < levels - 1 && delta >= (1ull << (slotBits * (level + 1))))
+        ++level;
+
+    auto slot = static_cast<uint8_t>((timer.expiry >> (slotBits * level)) & (slots - 1));
+
+    timer.level = static_cast<int8_t>(level);
+    timer.slot = slot;
+    timer.prev = none;
+    timer.next = m_slots[level][slot];
+
+    if (timer.next != none)
+        m_timers[timer.next].prev = index;
+
+    m_slots[level][slot] = index;
+    m_occupied[level] |= 1ull << slot;
+}
+
+void TimerWheel::unlink(int32_t index) {
+    auto& timer = m_timers[index];
+
+    if (timer.prev != none)
+        m_timers[timer.prev].next = timer.next;
+    else
+        m_slots[timer.level][timer.slot] = timer.next;
+
+    if (timer.next != none)
+        m_timers[timer.next].prev = timer.prev;
+
+    if (m_slots[timer.level][timer.slot] == none)
+        m_occupied[timer.level] &= ~(1ull << timer.slot);
+
+    timer.prev = timer.next = none;
+    timer.level = -1;
+}
+
+void TimerWheel::release(int32_t index) {
+    auto& timer = m_timers[index];
+    timer.callback = nullptr;
+    timer.level = -1;
+    ++timer.generation;
+
+    m_free.push_back(index);
+    --m_active;
+}
+
+void TimerWheel::cascade(int level) {
+    auto slot = (m_current >> (slotBits * level)) & (slots - 1);
+
+    auto index = m_slots[level][slot];
+    m_slots[level][slot] = none;
+    m_occupied[level] &= ~(1ull << slot);
+
+    while (index != none) {
+        auto next = m_timers[index].next;
+        insert(index);
+        index = next;
+    }
+}
+
+size_t TimerWheel::fire() {
+    auto slot = m_current & (slots - 1);
+
+    // detach the whole slot first, callbacks may arm or cancel timers
+    vector<pair<int32_t, uint32_t>> due;
+    for (auto index = m_slots[0][slot]; index != none; index = m_timers[index].next)
+        due.emplace_back(index, m_timers[index].generation);
+
+    for (auto& entry : due)
+        unlink(entry.first);
+
+    size_t fired = 0;
+
+    for (auto& entry : due) {
+        auto index = entry.first;
+        auto& timer = m_timers[index];
+
+        // cancelled by an earlier callback in this slot
+        if (timer.generation != entry.second || !timer.callback)
+            continue;
+
+        if (timer.interval) {
+            timer.expiry = m_current + timer.interval;
+            insert(index);
+
+            // copy, the callback may cancel itself or grow m_timers
+            auto callback = timer.callback;
+            callback();
+        } else {
+            auto callback = move(timer.callback);
+            release(index);
+            callback();
+        }
+
+        ++fired;
+    }
+
+    return fired;
+}
+
+size_t TimerWheel::advance(uint64_t tick) {
+    size_t fired = 0;
+    m_advancing = true;
+
+    while (m_current < tick) {
+        auto next = nextTick();
+        if (next > tick) {
+            m_current = tick;
+            break;
+        }
+
+        m_current = next;
+
+        for (int level = levels - 1; level > 0; --level) {
+            if ((m_current & ((1ull << (slotBits * level)) - 1)) == 0)
+                cascade(level);
+        }
+
+        if (m_occupied[0] & (1ull << (m_current & (slots - 1))))
+            fired += fire();
+    }
+
+    m_advancing = false;
+    return fired;
+}
+
+uint64_t TimerWheel::nextTick() const {
+    uint64_t best = UINT64_MAX;
+
+    for (int level = 0; level < levels; ++level) {
+        auto occupied = m_occupied[level];
+        if (!occupied) continue;
+
+        // first slot at or after the next position of this level
+        auto base = (m_current >> (slotBits * level)) + 1;
+        auto shift = base & (slots - 1);
+        auto rotated = shift ? (occupied >> shift) | (occupied << (slots - shift)) : occupied;
+
+        auto tick = (base + __builtin_ctzll(rotated)) << (slotBits * level);
+        best = min(best, tick);
+    }
+
+    return best;
+}
+
+uint64_t TimerWheel::currentTick() const {
+    return m_current;
+}
+
+size_t TimerWheel::size() const {
+    return m_active;
+}
+
+uint64_t TimerWheel::ticks(Duration duration) const {
+    // round up so a timer never fires before its delay
+    auto count = (duration.count() + m_tick.count() - 1) / m_tick.count();
+    return count > 0 ? count : 0;
+}
+
+uint64_t TimerWheel::elapsed() const {
+    return chrono::duration_cast<Duration>(chrono::steady_clock::now() - m_epoch).count() / m_tick.count();
+}
+
+void TimerWheel::reschedule() {
+    if (m_advancing) return;
+
+    auto next = nextTick();
+
+    if (next == UINT64_MAX) {
+        if (m_source) {
+            g_source_remove(m_source);
+            m_source = 0;
+        }
+        return;
+    }
+
+    // the armed timeout fires early enough already
+    if (m_source && m_sourceTick <= next)
+        return;
+
+    if (m_source)
+        g_source_remove(m_source);
+
+    auto now = elapsed();
+    auto delay = next > now ? (next - now) * m_tick.count() : 0;
+
+    m_source = g_timeout_add(static_cast<guint>(delay), onTimeout, this);
+    m_sourceTick = next;
+}
+
+gboolean TimerWheel::onTimeout(gpointer data) {
+    auto* self = static_cast<TimerWheel*>(data);
+    self->m_source = 0;
+
+    self->advance(self->elapsed());
+    self->reschedule();
+
+    return G_SOURCE_REMOVE;
+}
@@ -0,0 +1,123 @@
+#ifndef MEETING_SDK_LINUX_SAMPLE_TIMERWHEEL_H
+#define MEETING_SDK_LINUX_SAMPLE_TIMERWHEEL_H
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include <glib.h>
+
+using namespace std;
+
+/**
+ * Hierarchical timer wheel driven by a single glib timeout.
+ *
+ * Four levels of 64 slots cover ~46 hours at the default 10ms tick. Arming
+ * and cancelling are O(1); the glib timeout is only armed for the next tick
+ * that has work, so an idle wheel does not wake the main loop.
+ * Timers fire on the main loop thread and must only be armed or cancelled
+ * from it, e.g. from Executor tasks.
+ */
+class TimerWheel {
+public:
+    typedef uint64_t Id;
+    typedef chrono::milliseconds Duration;
+
+private:
+    static constexpr int levels = 4;
+    static constexpr int slotBits = 6;
+    static constexpr int slots = 1 << slotBits;
+    static constexpr int32_t none = -1;
+
+    struct Timer {
+        uint64_t expiry = 0;
+        uint64_t interval = 0;
+        function<void()> callback;
+        int32_t prev = none;
+        int32_t next = none;
+        uint32_t generation = 0;
+        int8_t level = -1;
+        uint8_t slot = 0;
+    };
+
+    vector<Timer> m_timers;
+    vector<int32_t> m_free;
+
+    int32_t m_slots[levels][slots];
+    uint64_t m_occupied[levels] = {};
+
+    uint64_t m_current = 0;
+    size_t m_active = 0;
+    bool m_advancing = false;
+
+    Duration m_tick;
+    chrono::steady_clock::time_point m_epoch;
+
+    guint m_source = 0;
+    uint64_t m_sourceTick = 0;
+
+    Id arm(uint64_t delay, uint64_t interval, function<void()> callback);
+    void insert(int32_t index);
+    void unlink(int32_t index);
+    void release(int32_t index);
+    void cascade(int level);
+    size_t fire();
+
+    uint64_t ticks(Duration duration) const;
+    uint64_t elapsed() const;
+    void reschedule();
+
+    static gboolean onTimeout(gpointer data);
+
+public:
+    /**
+     * @param tick resolution of the wheel
+     */
+    explicit TimerWheel(Duration tick = Duration(10));
+    ~TimerWheel();
+
+    TimerWheel(const TimerWheel&) = delete;
+    TimerWheel& operator=(const TimerWheel&) = delete;
+
+    /**
+     * Fire a callback once
+     * @param delay time until the callback fires
+     * @param callback runs on the main loop thread
+     * @return id to cancel the timer with
+     */
+    Id after(Duration delay, function<void()> callback);
+
+    /**
+     * Fire a callback repeatedly until it is cancelled
+     * @param interval time between calls, the first one after one interval
+     * @param callback runs on the main loop thread
+     * @return id to cancel the timer with
+     */
+    Id every(Duration interval, function<void()> callback);
+
+    /**
+     * Cancel a timer, safe to call with fired, cancelled or zero ids
+     * @param id id returned by after() or every()
+     * @return true if the timer was armed
+     */
+    bool cancel(Id id);
+
+    /**
+     * Run every timer due up to the given tick, without touching the main loop
+     * @param tick absolute tick to advance to
+     * @return number of callbacks fired
+     */
+    size_t advance(uint64_t tick);
+
+    /**
+     * @return the next tick at which the wheel has work, UINT64_MAX if idle
+     */
+    uint64_t nextTick() const;
+
+    uint64_t currentTick() const;
+    size_t size() const;
+};
+
+
+#endif //MEETING_SDK_LINUX_SAMPLE_TIMERWHEEL_H
@@ -0,0 +1,309 @@
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "consent/ConsentEngine.h"
+#include "LoopClient.h"
+#include "TestDir.h"
+
+using namespace std;
+
+namespace {
+
+const unsigned int self = 16778240;
+const unsigned int jane = 42;
+const unsigned int john = 43;
+
+/**
+ * The meeting as the engine sees it through its interfaces
+ */
+struct FakeMeeting : ConsentEngine::Participants, ConsentEngine::Recording {
+    map<unsigned int, string> users;
+    bool canStart = true;
+    int starts = 0;
+    int stops = 0;
+    vector<unsigned int> joinedIds;
+    vector<unsigned int> leftIds;
+
+    bool list(vector<unsigned int>& ids) override {
+        ids.clear();
+        for (const auto& user : users)
+            ids.push_back(user.first);
+        return true;
+    }
+
+    const char* name(unsigned int userId) override {
+        auto it = users.find(userId);
+        return it == users.end() ? nullptr : it->second.c_str();
+    }
+
+    unsigned int self() override {
+        return ::self;
+    }
+
+    bool startRecording() override {
+        ++starts;
+        return canStart;
+    }
+
+    void stopRecording() override {
+        ++stops;
+    }
+
+    void joined(unsigned int userId) override {
+        joinedIds.push_back(userId);
+    }
+
+    void left(unsigned int userId) override {
+        leftIds.push_back(userId);
+    }
+};
+
+class ConsentEngineTest : public ::testing::Test {
+protected:
+    TestDir dir;
+    Config config;
+    Executor executor;
+    TimerWheel timers;
+    ChatOutbox chat{executor, timers};
+    SegmentLedger ledger;
+    SegmentPurger purger{ledger};
+    FakeMeeting meeting;
+    unique_ptr<ConsentEngine> engine;
+    vector<pair<unsigned int, string>> sent;
+
+    void SetUp() override {
+        meeting.users = {{self, "IdentifAI KYE"}, {jane, "Jane Doe"}, {john, "John Doe"}};
+
+        chat.setSender([this](unsigned int receiver, const string& text) {
+            sent.emplace_back(receiver, text);
+            return true;
+        });
+    }
+
+    /**
+     * Read the command line and start a fresh engine, nothing answers on the consent URL
+     */
+    void start(vector<string> options = {}) {
+        vector<string> args = {"zoomsdk", "--client-id", "test", "--client-secret", "test", "-m", "123 456 789",
+                               "--consent-url", "http://127.0.0.1:1/consent", "--journal-dir", dir.path(),
+                               "--audit-file", dir.path() + "/audit.jsonl"};
+        args.insert(args.end(), options.begin(), options.end());
+
+        vector<char*> argv;
+        for (auto& arg : args)
+            argv.push_back(&arg[0]);
+        ASSERT_EQ(config.read(static_cast<int>(argv.size()), argv.data()), 0);
+
+        engine.reset(new ConsentEngine(config, timers, chat, purger, meeting, meeting));
+        engine->start();
+        engine->fetchParticipants();
+    }
+
+    void respond(const vector<string>& consenting) {
+        string body = "{\"consenting_users\": [";
+        for (size_t i = 0; i < consenting.size(); ++i)
+            body += (i ? ", \"" : "\"") + consenting[i] + "\"";
+        body += "]}";
+
+        engine->onConsentResponse(body);
+        executor.drain();
+    }
+};
+
+}
+
+TEST_F(ConsentEngineTest, StartsRecordingOnceEveryoneConsented) {
+    start();
+
+    respond({"Jane Doe", "IdentifAI KYE"});
+    EXPECT_EQ(meeting.starts, 0);
+    EXPECT_FALSE(engine->recording());
+
+    ASSERT_EQ(sent.size(), 1u);
+    EXPECT_EQ(sent[0].first, 0u);
+    EXPECT_NE(sent[0].second.find("- John Doe"), string::npos) << sent[0].second;
+    EXPECT_EQ(sent[0].second.find("Jane Doe"), string::npos) << sent[0].second;
+
+    respond({"Jane Doe", "John Doe", "IdentifAI KYE"});
+    EXPECT_EQ(meeting.starts, 1);
+    EXPECT_TRUE(engine->recording());
+
+    // not following consent anymore once everyone gave it
+    respond({"Jane Doe"});
+    EXPECT_EQ(meeting.starts, 1);
+    EXPECT_TRUE(engine->recording());
+}
+
+TEST_F(ConsentEngineTest, StartsAgainWhenPrivilegeIsGrantedBack) {
+    start();
+    meeting.canStart = false;
+
+    respond({"Jane Doe", "John Doe", "IdentifAI KYE"});
+    EXPECT_EQ(meeting.starts, 1);
+    EXPECT_FALSE(engine->recording());
+
+    meeting.canStart = true;
+    engine->onRecordingPrivilege(true);
+    EXPECT_EQ(meeting.starts, 2);
+    EXPECT_TRUE(engine->recording());
+
+    engine->onRecordingPrivilege(false);
+    EXPECT_EQ(meeting.stops, 1);
+    EXPECT_FALSE(engine->recording());
+
+    engine->onRecordingPrivilege(true);
+    EXPECT_EQ(meeting.starts, 3);
+    EXPECT_TRUE(engine->recording());
+}
+
+TEST_F(ConsentEngineTest, TriesSelectiveStartOnceUntilPrivilegeIsGranted) {
+    start({"--selective-recording"});
+    meeting.canStart = false;
+
+    respond({"Jane Doe"});
+    respond({"Jane Doe", "John Doe"});
+    meeting.users[44] = "Late Guest";
+    engine->onUserJoin({44});
+    respond({"John Doe"});
+    EXPECT_EQ(meeting.starts, 1);
+
+    meeting.canStart = true;
+    engine->onRecordingPrivilege(true);
+    EXPECT_EQ(meeting.starts, 2);
+    EXPECT_TRUE(engine->recording());
+}
+
+TEST_F(ConsentEngineTest, GatesAndPurgesSelectively) {
+    start({"--selective-recording"});
+
+    respond({"Jane Doe"});
+    EXPECT_EQ(meeting.starts, 1);
+    EXPECT_TRUE(engine->gate().allowed(jane));
+    EXPECT_FALSE(engine->gate().allowed(john));
+
+    // a participant joining later is recorded apart, and forgotten when leaving
+    meeting.users[44] = "Late Guest";
+    engine->onUserJoin({44});
+    EXPECT_EQ(meeting.joinedIds, vector<unsigned int>({44}));
+    EXPECT_FALSE(engine->gate().allowed(44));
+
+    engine->onUserLeft({44});
+    EXPECT_EQ(meeting.leftIds, vector<unsigned int>({44}));
+
+    respond({});
+    EXPECT_FALSE(engine->gate().allowed(jane));
+    EXPECT_EQ(meeting.starts, 1);
+
+    purger.drain();
+
+    ifstream audit(dir.path() + "/audit.jsonl");
+    string records((istreambuf_iterator<char>(audit)), istreambuf_iterator<char>());
+    EXPECT_NE(records.find("\"user\":\"Jane Doe\""), string::npos) << records;
+    EXPECT_EQ(records.find("John Doe"), string::npos) << records;
+}
+
+TEST_F(ConsentEngineTest, GatesEveryoneGoingByAChangedName) {
+    meeting.users[44] = "John Doe";
+    start({"--selective-recording"});
+
+    respond({"John Doe"});
+    EXPECT_TRUE(engine->gate().allowed(john));
+    EXPECT_TRUE(engine->gate().allowed(44));
+    EXPECT_FALSE(engine->gate().allowed(jane));
+
+    // the rename moves the participant to the consent of the new name
+    meeting.users[44] = "Johnny";
+    engine->onUserNamesChanged({44});
+    EXPECT_FALSE(engine->gate().allowed(44));
+
+    respond({"Johnny"});
+    EXPECT_TRUE(engine->gate().allowed(44));
+    EXPECT_FALSE(engine->gate().allowed(john));
+}
+
+TEST_F(ConsentEngineTest, RestoresJournaledConsentWithoutStarting) {
+    start({"--selective-recording"});
+    respond({"Jane Doe"});
+    engine->close();
+    engine.reset();
+
+    meeting.starts = 0;
+    start({"--selective-recording"});
+
+    // the gate is seeded, recording waits for a fresh snapshot
+    EXPECT_TRUE(engine->gate().allowed(jane));
+    EXPECT_FALSE(engine->gate().allowed(john));
+    EXPECT_EQ(meeting.starts, 0);
+
+    respond({"Jane Doe"});
+    EXPECT_EQ(meeting.starts, 1);
+}
+
+TEST_F(ConsentEngineTest, RemindsPrivatelyWithoutTheBot) {
+    start({"--private-reminders", "--consent-link", "https://example.com/consent?bot=1"});
+
+    respond({"Jane Doe"});
+
+    ASSERT_EQ(sent.size(), 1u);
+    EXPECT_EQ(sent[0].first, john);
+    EXPECT_NE(sent[0].second.find("https://example.com/consent?bot=1&name=John%20Doe"), string::npos) << sent[0].second;
+
+    // within the reminder interval nobody is reminded again
+    engine->sendConsentReminder();
+    executor.drain();
+    EXPECT_EQ(sent.size(), 1u);
+}
+
+TEST_F(ConsentEngineTest, RemindsParticipantsSharingANameEach) {
+    meeting.users[44] = "John Doe";
+    start({"--private-reminders"});
+
+    respond({"Jane Doe"});
+
+    ASSERT_EQ(sent.size(), 2u);
+    EXPECT_EQ(set<unsigned int>({sent[0].first, sent[1].first}), set<unsigned int>({john, 44}));
+
+    engine->sendConsentReminder();
+    executor.drain();
+    EXPECT_EQ(sent.size(), 2u);
+}
+
+TEST_F(ConsentEngineTest, ForgetsParticipantsThatLeft) {
+    start();
+
+    meeting.users.erase(john);
+    engine->fetchParticipants();
+    EXPECT_EQ(engine->participants().size(), 2u);
+    EXPECT_EQ(meeting.leftIds, vector<unsigned int>({john}));
+
+    respond({"Jane Doe", "IdentifAI KYE"});
+    EXPECT_EQ(meeting.starts, 1);
+}
+
+TEST_F(ConsentEngineTest, RequiresWebhookSecret) {
+    auto port = freePort();
+    start({"--webhook-port", to_string(port), "--webhook-secret", "s3cret"});
+
+    string body = "{\"user\": \"Jane Doe\", \"consent\": true}";
+    auto push = [&](const string& authorization) {
+        LoopClient client(port);
+        return client.request("POST /consent HTTP/1.1\r\n" + authorization + "Content-Length: " +
+                              to_string(body.size()) + "\r\nConnection: close\r\n\r\n" + body);
+    };
+
+    EXPECT_EQ(push(""), "HTTP/1.1 401 Unauthorized");
+    EXPECT_EQ(push("Authorization: Bearer s3cre\r\n"), "HTTP/1.1 401 Unauthorized");
+    EXPECT_EQ(push("Authorization: s3cret\r\n"), "HTTP/1.1 401 Unauthorized");
+    EXPECT_FALSE(engine->gate().allowed(jane));
+
+    EXPECT_EQ(push("Authorization: Bearer s3cret\r\n"), "HTTP/1.1 202 Accepted");
+    EXPECT_TRUE(engine->gate().allowed(jane));
+}
@@ -0,0 +1,217 @@
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <signal.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+#include "consent/ConsentJournal.h"
+#include "TestDir.h"
+
+using namespace std;
+
+namespace {
+
+struct State {
+    unordered_set<string> consenting;
+    unordered_map<string, int64_t> reminded;
+
+    bool operator==(const State& other) const {
+        return consenting == other.consenting && reminded == other.reminded;
+    }
+};
+
+struct Op {
+    string name;
+    int kind;
+    int64_t at;
+};
+
+State stateOf(const ConsentJournal& journal) {
+    return {journal.consenting(), journal.lastReminded()};
+}
+
+void replayOp(State& state, const Op& op) {
+    if (op.kind == 0) state.consenting.insert(op.name);
+    else if (op.kind == 1) state.consenting.erase(op.name);
+    else state.reminded[op.name] = op.at;
+}
+
+vector<Op> makeOps(unsigned seed, size_t count) {
+    mt19937 rng(seed);
+    vector<Op> ops;
+    ops.reserve(count);
+
+    for (size_t i = 0; i < count; ++i)
+        ops.push_back({"User " + to_string(rng() % 40), static_cast<int>(rng() % 3), static_cast<int64_t>(i) + seed * 100000});
+
+    return ops;
+}
+
+}
+
+/**
+ * A child appends until it is SIGKILLed at a random point, possibly while
+ * open() is still compacting. Reopening must give the state after some prefix
+ * of what the child appended, on top of what the previous round recovered.
+ */
+TEST(ConsentJournal, RecoversFromRandomSigkill) {
+    TestDir dir;
+    auto path = dir.path() + "/consent-1.journal";
+
+    mt19937 rng(1234);
+    State base;
+
+    for (unsigned round = 1; round <= 40; ++round) {
+        auto ops = makeOps(round, 4000);
+
+        auto pid = fork();
+        ASSERT_GE(pid, 0);
+
+        if (pid == 0) {
+            ConsentJournal journal;
+            if (!journal.open(path)) _exit(1);
+
+            for (const auto& op : ops) {
+                if (op.kind == 2) journal.reminded(op.name, op.at);
+                else journal.consent(op.name, op.kind == 0);
+            }
+
+            // killed before it gets here most of the time, or else idle until it is
+            pause();
+            _exit(0);
+        }
+
+        usleep(uniform_int_distribution<useconds_t>(0, 3000)(rng));
+        kill(pid, SIGKILL);
+
+        int status = 0;
+        waitpid(pid, &status, 0);
+        ASSERT_TRUE(WIFSIGNALED(status)) << "round " << round << " exited with " << WEXITSTATUS(status);
+
+        ConsentJournal journal;
+        ASSERT_TRUE(journal.open(path)) << "round " << round;
+        auto recovered = stateOf(journal);
+
+        auto expected = base;
+        bool matched = expected == recovered;
+        for (size_t i = 0; i < ops.size() && !matched; ++i) {
+            replayOp(expected, ops[i]);
+            matched = expected == recovered;
+        }
+
+        ASSERT_TRUE(matched) << "round " << round << " recovered a state no prefix of the appended records gives";
+        base = recovered;
+    }
+
+    EXPECT_FALSE(TestDir::exists(path + ".tmp"));
+}
+
+TEST(ConsentJournal, DropsTornTail) {
+    TestDir dir;
+    auto path = dir.path() + "/consent-1.journal";
+
+    {
+        ConsentJournal journal;
+        ASSERT_TRUE(journal.open(path));
+        journal.consent("Jane Doe", true);
+        journal.consent("John Doe", true);
+    }
+
+    // cut the last record short, as a crash in the middle of write() would
+    ASSERT_EQ(truncate(path.c_str(), TestDir::size(path) - 3), 0);
+
+    ConsentJournal journal;
+    ASSERT_TRUE(journal.open(path));
+    EXPECT_EQ(journal.consenting(), unordered_set<string>({"Jane Doe"}));
+}
+
+/**
+ * A record only partly written, here because it crosses the file size limit,
+ * is undone so the records appended after it survive a reopen
+ */
+TEST(ConsentJournal, UndoesShortWrite) {
+    TestDir dir;
+    auto path = dir.path() + "/consent-1.journal";
+
+    // the limit applies to the whole process, only lowered in a child
+    auto pid = fork();
+    ASSERT_GE(pid, 0);
+
+    if (pid == 0) {
+        ConsentJournal journal;
+        if (!journal.open(path)) _exit(1);
+        journal.consent("Jane Doe", true);
+
+        rlimit limit{};
+        if (getrlimit(RLIMIT_FSIZE, &limit) < 0) _exit(2);
+
+        auto lifted = limit;
+        limit.rlim_cur = TestDir::size(path) + 4;
+        signal(SIGXFSZ, SIG_IGN);
+        if (setrlimit(RLIMIT_FSIZE, &limit) < 0) _exit(3);
+
+        journal.consent("John Doe", true);
+
+        if (setrlimit(RLIMIT_FSIZE, &lifted) < 0) _exit(4);
+        journal.consent("Jack Doe", true);
+        _exit(journal.isOpen() ? 0 : 5);
+    }
+
+    int status = 0;
+    waitpid(pid, &status, 0);
+    ASSERT_TRUE(WIFEXITED(status));
+    ASSERT_EQ(WEXITSTATUS(status), 0);
+
+    ConsentJournal journal;
+    ASSERT_TRUE(journal.open(path));
+    EXPECT_EQ(journal.consenting(), unordered_set<string>({"Jane Doe", "Jack Doe"}));
+}
+
+TEST(ConsentJournal, MovesAsideUnknownFormat) {
+    TestDir dir;
+    auto path = dir.path() + "/consent-1.journal";
+
+    ofstream(path) << "not a consent journal";
+
+    ConsentJournal journal;
+    ASSERT_TRUE(journal.open(path));
+    EXPECT_TRUE(journal.consenting().empty());
+
+    ifstream aside(path + ".unknown");
+    string contents((istreambuf_iterator<char>(aside)), istreambuf_iterator<char>());
+    EXPECT_EQ(contents, "not a consent journal");
+}
+
+TEST(ConsentJournal, RefusesUnreadableJournal) {
+    if (geteuid() == 0)
+        GTEST_SKIP() << "root reads the file regardless of its mode";
+
+    TestDir dir;
+    auto path = dir.path() + "/consent-1.journal";
+
+    {
+        ConsentJournal journal;
+        ASSERT_TRUE(journal.open(path));
+        journal.consent("Jane Doe", true);
+    }
+
+    chmod(path.c_str(), 0200);
+
+    ConsentJournal journal;
+    EXPECT_FALSE(journal.open(path));
+
+    chmod(path.c_str(), 0600);
+    ASSERT_TRUE(journal.open(path));
+    EXPECT_EQ(journal.consenting(), unordered_set<string>({"Jane Doe"}));
+}
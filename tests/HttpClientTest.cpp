@@ -0,0 +1,233 @@
+#include <chrono>
+#include <string>
+#include <thread>
+
+#include <glib.h>
+#include <gtest/gtest.h>
+
+#include "net/HttpClient.h"
+#include "HttpStub.h"
+
+using namespace std;
+
+namespace {
+
+/**
+ * Run the default main context until done() or the limit passed
+ */
+template <typename Done>
+bool runUntil(Done done, chrono::milliseconds limit = chrono::milliseconds(5000)) {
+    bool expired = false;
+    auto timeout = g_timeout_add(limit.count(), [](gpointer data) -> gboolean {
+        *static_cast<bool*>(data) = true;
+        return G_SOURCE_REMOVE;
+    }, &expired);
+
+    while (!done() && !expired)
+        g_main_context_iteration(nullptr, TRUE);
+
+    if (!expired) g_source_remove(timeout);
+    return done();
+}
+
+struct Fetch {
+    bool done = false;
+    HttpClient::Response response;
+
+    HttpClient::Callback callback() {
+        return [this](const HttpClient::Response& r) {
+            response = r;
+            done = true;
+        };
+    }
+};
+
+class HttpClientTest : public ::testing::Test {
+protected:
+    HttpStub stub;
+    HttpClient client;
+
+    void SetUp() override {
+        ASSERT_TRUE(client.setUrl(stub.url()));
+        client.setTimeout(chrono::milliseconds(500));
+        client.setRetries(0, chrono::milliseconds(10));
+    }
+
+    HttpClient::Response get() {
+        Fetch fetch;
+        client.get(fetch.callback());
+        EXPECT_TRUE(runUntil([&]() { return fetch.done; }));
+        return fetch.response;
+    }
+};
+
+}
+
+TEST_F(HttpClientTest, ReadsContentLengthBody) {
+    stub.reply(200, R"({"consenting_users":["Jane Doe"]})");
+
+    auto response = get();
+    EXPECT_TRUE(response.ok()) << response.error;
+    EXPECT_EQ(response.status, 200);
+    EXPECT_EQ(response.body, R"({"consenting_users":["Jane Doe"]})");
+}
+
+TEST_F(HttpClientTest, ReadsChunkedBodyArrivingInPieces) {
+    stub.handle([](int fd, const string&) {
+        HttpStub::send(fd, HttpStub::head(200, "Transfer-Encoding: chunked\r\n"));
+
+        // split inside sizes, data and CRLFs, each piece its own read
+        for (auto piece : {"1", "4\r\n{\"consen", "ting_users\":", "\r\n", "c\r\n[\"Jane Doe", "\"]\r", "\n1\r\n}\r\n0\r", "\n\r\n"}) {
+            this_thread::sleep_for(chrono::milliseconds(5));
+            HttpStub::send(fd, piece);
+        }
+        return true;
+    });
+
+    auto response = get();
+    EXPECT_TRUE(response.ok()) << response.error;
+    EXPECT_EQ(response.body, R"({"consenting_users":["Jane Doe"]})");
+}
+
+TEST_F(HttpClientTest, RejectsMalformedChunks) {
+    // a chunk running past its size, and a size that is not hex
+    stub.handle([](int fd, const string&) {
+        HttpStub::send(fd, HttpStub::head(200, "Transfer-Encoding: chunked\r\n") + "2\r\n[]]\r\n0\r\n\r\n");
+        return false;
+    });
+    stub.handle([](int fd, const string&) {
+        HttpStub::send(fd, HttpStub::head(200, "Transfer-Encoding: chunked\r\n") + "zz\r\n[]\r\n0\r\n\r\n");
+        return false;
+    });
+
+    auto response = get();
+    EXPECT_FALSE(response.ok());
+    EXPECT_FALSE(response.error.empty());
+
+    response = get();
+    EXPECT_FALSE(response.ok());
+    EXPECT_FALSE(response.error.empty());
+}
+
+TEST_F(HttpClientTest, ReadsBodyUntilClose) {
+    stub.handle([](int fd, const string&) {
+        HttpStub::send(fd, HttpStub::head(200, "Connection: close\r\n") + "[]");
+        return false;
+    });
+
+    auto response = get();
+    EXPECT_TRUE(response.ok()) << response.error;
+    EXPECT_EQ(response.body, "[]");
+}
+
+TEST_F(HttpClientTest, ReportsNon2xxWithoutRetrying) {
+    client.setRetries(3, chrono::milliseconds(10));
+    stub.reply(503, "busy");
+
+    auto response = get();
+    EXPECT_FALSE(response.ok());
+    EXPECT_TRUE(response.error.empty()) << response.error;
+    EXPECT_EQ(response.status, 503);
+    EXPECT_EQ(response.body, "busy");
+    EXPECT_EQ(stub.requests(), 1);
+}
+
+TEST_F(HttpClientTest, TimesOut) {
+    client.setTimeout(chrono::milliseconds(100));
+    stub.handle([](int, const string&) {
+        this_thread::sleep_for(chrono::milliseconds(400));
+        return false;
+    });
+
+    auto started = chrono::steady_clock::now();
+    auto response = get();
+    auto elapsed = chrono::steady_clock::now() - started;
+
+    EXPECT_FALSE(response.ok());
+    EXPECT_NE(response.error.find("timed out"), string::npos) << response.error;
+    EXPECT_LT(elapsed, chrono::milliseconds(400));
+}
+
+TEST_F(HttpClientTest, RetriesAfterTimeout) {
+    client.setTimeout(chrono::milliseconds(200));
+    client.setRetries(1, chrono::milliseconds(10));
+
+    // the stand-in serves one connection at a time, so it must be done with
+    // the first before the retry times out as well
+    stub.handle([](int, const string&) {
+        this_thread::sleep_for(chrono::milliseconds(250));
+        return false;
+    });
+    stub.reply(200, "[]");
+
+    auto response = get();
+    EXPECT_TRUE(response.ok()) << response.error;
+    EXPECT_EQ(response.body, "[]");
+    EXPECT_EQ(stub.connections(), 2);
+}
+
+TEST_F(HttpClientTest, ReportsConnectionReset) {
+    stub.handle([](int fd, const string&) {
+        HttpStub::reset(fd);
+        return false;
+    });
+
+    auto response = get();
+    EXPECT_FALSE(response.ok());
+    EXPECT_FALSE(response.error.empty());
+    EXPECT_EQ(response.status, 0);
+}
+
+TEST_F(HttpClientTest, ReportsResetInTheMiddleOfABody) {
+    stub.handle([](int fd, const string&) {
+        HttpStub::send(fd, HttpStub::head(200, "Content-Length: 100\r\n") + "{\"consenting");
+        this_thread::sleep_for(chrono::milliseconds(20));
+        HttpStub::reset(fd);
+        return false;
+    });
+
+    auto response = get();
+    EXPECT_FALSE(response.ok());
+    EXPECT_FALSE(response.error.empty());
+}
+
+TEST_F(HttpClientTest, ReusesKeepAliveConnection) {
+    stub.reply(200, "[1]");
+    stub.reply(200, "[2]");
+
+    EXPECT_EQ(get().body, "[1]");
+    EXPECT_EQ(get().body, "[2]");
+    EXPECT_EQ(stub.connections(), 1);
+}
+
+TEST_F(HttpClientTest, ReconnectsWhenIdleConnectionWasClosed) {
+    // the server drops the connection after the response, without saying so
+    stub.handle([](int fd, const string&) {
+        HttpStub::send(fd, HttpStub::head(200, "Content-Length: 3\r\n") + "[1]");
+        return false;
+    });
+    stub.reply(200, "[2]");
+
+    EXPECT_EQ(get().body, "[1]");
+
+    // let the FIN arrive before the next request goes out on the old socket
+    this_thread::sleep_for(chrono::milliseconds(20));
+
+    auto response = get();
+    EXPECT_TRUE(response.ok()) << response.error;
+    EXPECT_EQ(response.body, "[2]");
+    EXPECT_EQ(stub.connections(), 2);
+}
+
+TEST_F(HttpClientTest, ReportsRefusedConnection) {
+    HttpClient refused;
+    ASSERT_TRUE(refused.setUrl("http://127.0.0.1:1/consent"));
+    refused.setRetries(0, chrono::milliseconds(10));
+
+    Fetch fetch;
+    refused.get(fetch.callback());
+    ASSERT_TRUE(runUntil([&]() { return fetch.done; }));
+
+    EXPECT_FALSE(fetch.response.ok());
+    EXPECT_NE(fetch.response.error.find("connect"), string::npos) << fetch.response.error;
+}
@@ -0,0 +1,51 @@
+#include <chrono>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "net/HttpListener.h"
+#include "LoopClient.h"
+
+using namespace std;
+
+TEST(HttpListener, ClosesIdleConnections) {
+    TimerWheel timers;
+    HttpListener listener(timers);
+    listener.setIdleTimeout(chrono::milliseconds(300));
+    listener.route("POST", "/consent", [](const HttpListener::Request&, HttpListener::Response& res) {
+        res.status = 202;
+    });
+    ASSERT_TRUE(listener.listen("127.0.0.1", 0));
+
+    // the body never arrives
+    LoopClient stalled(listener.port());
+    stalled.send("POST /consent HTTP/1.1\r\nContent-Length: 100\r\n\r\n{\"user\"");
+
+    runUntil([]() { return false; }, chrono::milliseconds(100));
+    EXPECT_FALSE(stalled.closed());
+
+    EXPECT_TRUE(runUntil([&]() { return stalled.closed(); }, chrono::milliseconds(2000)));
+    EXPECT_EQ(stalled.received(), "");
+
+    // a later connection is still served, and closed once idle after its response
+    LoopClient client(listener.port());
+    EXPECT_EQ(client.request("POST /consent HTTP/1.1\r\nContent-Length: 2\r\n\r\n{}"), "HTTP/1.1 202 Accepted");
+    EXPECT_TRUE(runUntil([&]() { return client.closed(); }, chrono::milliseconds(2000)));
+}
+
+TEST(HttpListener, PassesHeadersInLowerCase) {
+    TimerWheel timers;
+    HttpListener listener(timers);
+
+    string authorization;
+    listener.route("POST", "/consent", [&](const HttpListener::Request& req, HttpListener::Response& res) {
+        auto it = req.headers.find("authorization");
+        if (it != req.headers.end()) authorization = it->second;
+        res.status = 202;
+    });
+    ASSERT_TRUE(listener.listen("127.0.0.1", 0));
+
+    LoopClient client(listener.port());
+    client.request("POST /consent HTTP/1.1\r\nAuthorization:  Bearer Se3ret\r\nContent-Length: 0\r\n\r\n");
+    EXPECT_EQ(authorization, "Bearer Se3ret");
+}
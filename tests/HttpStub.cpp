@@ -0,0 +1,141 @@
+#include "HttpStub.h"
+
+#include <cerrno>
+#include <sstream>
+
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+HttpStub::HttpStub() {
+    m_listenFd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    socklen_t len = sizeof(addr);
+    if (bind(m_listenFd, reinterpret_cast<sockaddr*>(&addr), len) == 0 &&
+        listen(m_listenFd, 16) == 0 &&
+        getsockname(m_listenFd, reinterpret_cast<sockaddr*>(&addr), &len) == 0)
+        m_port = ntohs(addr.sin_port);
+
+    m_thread = thread(&HttpStub::run, this);
+}
+
+HttpStub::~HttpStub() {
+    m_stopping = true;
+
+    // wakes the thread in accept() or recv()
+    shutdown(m_listenFd, SHUT_RDWR);
+    auto conn = m_connFd.load();
+    if (conn >= 0) shutdown(conn, SHUT_RDWR);
+
+    m_thread.join();
+    close(m_listenFd);
+}
+
+string HttpStub::url(const string& path) const {
+    return "http://127.0.0.1:" + to_string(m_port) + path;
+}
+
+void HttpStub::handle(const Handler& handler) {
+    lock_guard<mutex> lock(m_mutex);
+    m_handlers.push_back(handler);
+}
+
+void HttpStub::reply(int status, const string& body, bool keepAlive) {
+    handle([status, body, keepAlive](int fd, const string&) {
+        stringstream headers;
+        headers << "Content-Type: application/json\r\n"
+                << "Content-Length: " << body.size() << "\r\n";
+        if (!keepAlive) headers << "Connection: close\r\n";
+
+        send(fd, head(status, headers.str()) + body);
+        return keepAlive;
+    });
+}
+
+int HttpStub::connections() const {
+    return m_connections.load();
+}
+
+int HttpStub::requests() const {
+    return m_requests.load();
+}
+
+void HttpStub::send(int fd, const string& data) {
+    size_t written = 0;
+    while (written < data.size()) {
+        auto n = ::send(fd, data.data() + written, data.size() - written, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return;
+        written += n;
+    }
+}
+
+void HttpStub::reset(int fd) {
+    linger lingering{1, 0};
+    setsockopt(fd, SOL_SOCKET, SO_LINGER, &lingering, sizeof(lingering));
+}
+
+string HttpStub::head(int status, const string& headers) {
+    stringstream ss;
+    ss << "HTTP/1.1 " << status << " Stub\r\n" << headers << "\r\n";
+    return ss.str();
+}
+
+HttpStub::Handler HttpStub::next() {
+    lock_guard<mutex> lock(m_mutex);
+    if (m_handlers.empty()) return nullptr;
+
+    auto handler = m_handlers.front();
+    m_handlers.pop_front();
+    return handler;
+}
+
+void HttpStub::run() {
+    while (!m_stopping) {
+        int fd = accept4(m_listenFd, nullptr, nullptr, SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno == EINTR) continue;
+            return;
+        }
+
+        ++m_connections;
+        m_connFd = fd;
+        serve(fd);
+        m_connFd = -1;
+        close(fd);
+    }
+}
+
+void HttpStub::serve(int fd) {
+    string in;
+    char buffer[4096];
+
+    while (!m_stopping) {
+        auto end = in.find("\r\n\r\n");
+        if (end == string::npos) {
+            auto n = recv(fd, buffer, sizeof(buffer), 0);
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) return;
+
+            in.append(buffer, n);
+            continue;
+        }
+
+        // the client only sends GETs without a body
+        auto request = in.substr(0, end);
+        in.erase(0, end + 4);
+        ++m_requests;
+
+        auto handler = next();
+        if (!handler) {
+            send(fd, head(500, "Content-Length: 0\r\n"));
+            continue;
+        }
+
+        if (!handler(fd, request)) return;
+    }
+}
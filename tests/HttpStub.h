@@ -0,0 +1,96 @@
+#ifndef MEETING_SDK_LINUX_SAMPLE_HTTPSTUB_H
+#define MEETING_SDK_LINUX_SAMPLE_HTTPSTUB_H
+
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+using namespace std;
+
+/**
+ * Local stand-in for the consent API, serving scripted replies on 127.0.0.1.
+ *
+ * Connections are served one at a time on a thread of its own. Every request
+ * read is handed to the next queued handler, which writes whatever bytes it
+ * likes to the socket, may sleep to provoke a timeout, or reset the
+ * connection. A request without a handler is answered with a 500.
+ */
+class HttpStub {
+public:
+    /**
+     * Answers one request
+     * @param fd connection the request was read from
+     * @param request request line and headers
+     * @return false to close the connection afterwards
+     */
+    typedef function<bool(int fd, const string& request)> Handler;
+
+private:
+    int m_listenFd = -1;
+    int m_port = 0;
+    atomic<int> m_connFd{-1};
+    atomic<bool> m_stopping{false};
+
+    mutex m_mutex;
+    deque<Handler> m_handlers;
+
+    atomic<int> m_connections{0};
+    atomic<int> m_requests{0};
+
+    thread m_thread;
+
+    void run();
+    void serve(int fd);
+    Handler next();
+
+public:
+    HttpStub();
+    ~HttpStub();
+
+    HttpStub(const HttpStub&) = delete;
+    HttpStub& operator=(const HttpStub&) = delete;
+
+    /**
+     * @param path path and query of the URL
+     * @return http:// URL of the stand-in
+     */
+    string url(const string& path = "/consent") const;
+
+    /**
+     * Queue the handler of the next request
+     */
+    void handle(const Handler& handler);
+
+    /**
+     * Queue a complete response to the next request
+     * @param status HTTP status code
+     * @param body sent with a Content-Length
+     * @param keepAlive false to close the connection after the response
+     */
+    void reply(int status, const string& body, bool keepAlive = true);
+
+    int connections() const;
+    int requests() const;
+
+    /**
+     * Write all of data, ignoring a peer that went away
+     */
+    static void send(int fd, const string& data);
+
+    /**
+     * Close the connection with a TCP reset instead of a FIN
+     */
+    static void reset(int fd);
+
+    /**
+     * @return status line and headers of a response
+     */
+    static string head(int status, const string& headers);
+};
+
+
+#endif //MEETING_SDK_LINUX_SAMPLE_HTTPSTUB_H
@@ -0,0 +1,120 @@
+#ifndef MEETING_SDK_LINUX_SAMPLE_LOOPCLIENT_H
+#define MEETING_SDK_LINUX_SAMPLE_LOOPCLIENT_H
+
+#include <cerrno>
+#include <chrono>
+#include <string>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <glib.h>
+#include <gtest/gtest.h>
+
+using namespace std;
+
+/**
+ * Run the default main context until done() or the limit passed
+ */
+template <typename Done>
+bool runUntil(Done done, chrono::milliseconds limit = chrono::milliseconds(5000)) {
+    bool expired = false;
+    auto timeout = g_timeout_add(limit.count(), [](gpointer data) -> gboolean {
+        *static_cast<bool*>(data) = true;
+        return G_SOURCE_REMOVE;
+    }, &expired);
+
+    while (!done() && !expired)
+        g_main_context_iteration(nullptr, TRUE);
+
+    if (!expired) g_source_remove(timeout);
+    return done();
+}
+
+/**
+ * @return a port on 127.0.0.1 that nothing listened on a moment ago
+ */
+inline int freePort() {
+    int fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+
+    socklen_t length = sizeof(addr);
+    bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+    getsockname(fd, reinterpret_cast<sockaddr*>(&addr), &length);
+    close(fd);
+
+    return ntohs(addr.sin_port);
+}
+
+/**
+ * Client side of a connection to a server on the main loop, reads without
+ * blocking so the loop can run in between
+ */
+class LoopClient {
+    int m_fd;
+    string m_received;
+    bool m_closed = false;
+
+public:
+    explicit LoopClient(int port) {
+        m_fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(port);
+        inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+
+        EXPECT_EQ(connect(m_fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)), 0);
+    }
+
+    ~LoopClient() {
+        close(m_fd);
+    }
+
+    LoopClient(const LoopClient&) = delete;
+    LoopClient& operator=(const LoopClient&) = delete;
+
+    void send(const string& data) {
+        EXPECT_EQ(::send(m_fd, data.data(), data.size(), MSG_NOSIGNAL), static_cast<ssize_t>(data.size()));
+    }
+
+    /**
+     * @return true once the server closed the connection
+     */
+    bool closed() {
+        char buffer[4096];
+        ssize_t n;
+        while ((n = recv(m_fd, buffer, sizeof(buffer), MSG_DONTWAIT)) > 0)
+            m_received.append(buffer, n);
+
+        m_closed = m_closed || n == 0 || (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK);
+        return m_closed;
+    }
+
+    /**
+     * @return everything the server sent so far
+     */
+    const string& received() {
+        closed();
+        return m_received;
+    }
+
+    /**
+     * Send a request and run the main loop until the whole response arrived
+     * @return status line of the response, empty if none came
+     */
+    string request(const string& data) {
+        send(data);
+        runUntil([this]() { return received().find("\r\n\r\n") != string::npos; });
+
+        return m_received.substr(0, m_received.find("\r\n"));
+    }
+};
+
+
+#endif //MEETING_SDK_LINUX_SAMPLE_LOOPCLIENT_H
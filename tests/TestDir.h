@@ -0,0 +1,44 @@
+#ifndef MEETING_SDK_LINUX_SAMPLE_TESTDIR_H
+#define MEETING_SDK_LINUX_SAMPLE_TESTDIR_H
+
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+
+using namespace std;
+
+/**
+ * Temporary directory removed with everything in it when the test ends
+ */
+class TestDir {
+    string m_path;
+
+public:
+    TestDir() {
+        string pattern = filesystem::temp_directory_path().string() + "/zoomsdk-test-XXXXXX";
+        if (mkdtemp(&pattern[0])) m_path = pattern;
+    }
+
+    ~TestDir() {
+        error_code ec;
+        if (!m_path.empty()) filesystem::remove_all(m_path, ec);
+    }
+
+    TestDir(const TestDir&) = delete;
+    TestDir& operator=(const TestDir&) = delete;
+
+    const string& path() const { return m_path; }
+
+    static bool exists(const string& path) {
+        error_code ec;
+        return filesystem::exists(path, ec);
+    }
+
+    static off_t size(const string& path) {
+        error_code ec;
+        return static_cast<off_t>(filesystem::file_size(path, ec));
+    }
+};
+
+
+#endif //MEETING_SDK_LINUX_SAMPLE_TESTDIR_H
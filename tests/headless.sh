@@ -0,0 +1,82 @@
+#!/usr/bin/env bash
+# Runs zoomsdk linked against fake_meetingsdk through a scenario, pushes consent
+# for two of the three guests to the webhook and checks that only their audio
+# was recorded and that SIGTERM shuts the bot down cleanly.
+#
+# usage: headless.sh <zoomsdk> <scenario>
+
+set -u
+
+zoomsdk=$(realpath "$1")
+scenario=$(realpath "$2")
+
+work=$(mktemp -d)
+trap 'kill -KILL "$pid" 2>/dev/null; rm -rf "$work"' EXIT
+cd "$work" || exit 1
+
+port=$((20000 + $$ % 20000))
+log=$work/zoomsdk.log
+
+fail() {
+    echo "FAIL: $*"
+    echo "--- zoomsdk log"
+    grep -v '^.*Writing ' "$log"
+    exit 1
+}
+
+# the first three participants of the fake SDK after the bot itself
+guest1=16779264
+guest2=16780288
+guest3=16781312
+
+FAKE_MEETINGSDK_SCENARIO=$scenario FAKE_MEETINGSDK_SPEED=${FAKE_MEETINGSDK_SPEED:-20} \
+    "$zoomsdk" --client-id headless --client-secret headless -m 123456789 -p headless \
+    --consent-url http://127.0.0.1:1/consent --consent-staleness 600 \
+    --webhook-host 127.0.0.1 --webhook-port "$port" --webhook-secret headless --journal-dir "$work" --audit-file "$work/audit.jsonl" \
+    --selective-recording RawAudio -f meeting.pcm -d "$work/out" > "$log" 2>&1 &
+pid=$!
+
+wait_for() {
+    for _ in $(seq 200); do
+        grep -q "$1" "$log" && return 0
+        kill -0 "$pid" 2>/dev/null || fail "zoomsdk exited while waiting for '$1'"
+        sleep 0.05
+    done
+    fail "timed out waiting for '$1'"
+}
+
+mkdir -p "$work/out"
+wait_for "listening for consent webhooks"
+
+body='{"consenting_users":["Guest 1","Guest 2"]}'
+exec 3<>"/dev/tcp/127.0.0.1/$port" || fail "cannot connect to the webhook"
+printf 'POST /consent HTTP/1.1\r\nHost: 127.0.0.1\r\nAuthorization: Bearer headless\r\nContent-Type: application/json\r\nContent-Length: %d\r\nConnection: close\r\n\r\n%s' \
+    "${#body}" "$body" >&3
+status=$(head -n 1 <&3)
+exec 3<&-
+
+case $status in
+    "HTTP/1.1 202"*) ;;
+    *) fail "webhook answered '$status'" ;;
+esac
+
+wait_for "meeting ended"
+
+kill -TERM "$pid"
+wait "$pid"
+code=$?
+[ "$code" -eq 143 ] || fail "zoomsdk exited with $code instead of 143"
+
+grep -q "shutdown flushed" "$log" || fail "shutdown did not flush the recordings"
+
+# the scenario denies the privilege mid-meeting and grants it again
+starts=$(grep -c "start raw recording$" "$log")
+[ "$starts" -eq 2 ] || fail "raw recording started $starts times instead of twice"
+
+for id in $guest1 $guest2; do
+    [ -s "out/node-$id.pcm" ] || fail "no audio recorded for consenting participant $id"
+done
+
+[ -e "out/node-$guest3.pcm" ] && fail "audio recorded for participant $guest3 without consent"
+
+echo "PASS: recorded $(du -cb out/node-*.pcm | tail -n 1 | cut -f 1) bytes of consented audio"